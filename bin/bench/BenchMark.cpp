@@ -16,17 +16,245 @@
  */
 
 #include <FreeNOS/System.h>
+#include <SystemCallBatch.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <dirent.h>
+#include <Runtime.h>
+#include <MemoryBlock.h>
+#include <MemoryChannel.h>
+#include <FixedMemoryChannel.h>
+#include <FileSystemMessage.h>
+#include <Sort.h>
+#include <CoreInfo.h>
 #include "BenchMark.h"
 
+/** Number of files in the directory listing benchmark */
+#define BENCH_DIRENTS 100000
+
+/** Number of lock operations per thread in the mutex contention benchmark */
+#define BENCH_LOCKS 1024
+
+/** Number of round-trips in the semaphore benchmark */
+#define BENCH_PINGS 64
+
+/** Number of processes kept alive in the resident memory benchmark */
+#define BENCH_CHILDREN 8
+
+/** Number of memory shares created in the share creation benchmark */
+#define BENCH_SHARES 64
+
+/** Number of heap blocks allocated in the heap growth benchmark */
+#define BENCH_BLOCKS 16
+
+/** Size of each heap block in the heap growth benchmark */
+#define BENCH_BLOCK_SIZE (PAGESIZE * 16)
+
+/** Number of messages transferred in the MemoryChannel throughput benchmark */
+#define BENCH_MESSAGES 65536
+
+/** Number of interrupts measured in the interrupt latency benchmark */
+#define BENCH_INTERRUPTS 128
+
+/** Number of iterations per thread in the parallel throughput benchmark */
+#define BENCH_WORK (1024 * 1024)
+
+static pthread_mutex_t benchMutex = PTHREAD_MUTEX_INITIALIZER;
+static sem_t benchPing, benchPong;
+static volatile Size benchCounter;
+static volatile bool benchSpin;
+static volatile ProcessID benchClient, benchServer;
+
+/**
+ * Transfer messages between a producer and consumer on the same pages.
+ *
+ * Fills the channel and then drains it, until BENCH_MESSAGES are transferred.
+ * The generic MemoryChannel is used through the Channel interface, like the
+ * ChannelRegistry users do.
+ *
+ * @param prod Producer channel.
+ * @param cons Consumer channel.
+ *
+ * @return Number of ticks spent.
+ */
+static u32 channelLoop(Channel *prod, Channel *cons)
+{
+    FileSystemMessage msg;
+    Size count = 0;
+    u64 t1, t2;
+
+    MemoryBlock::set(&msg, 0, sizeof(msg));
+    t1 = timestamp();
+
+    while (count < BENCH_MESSAGES)
+    {
+        while (prod->write(&msg) == Channel::Success)
+            msg.size++;
+
+        while (cons->read(&msg) == Channel::Success)
+            count++;
+    }
+    t2 = timestamp();
+    return (u32)(t2 - t1);
+}
+
+/**
+ * Transfer messages with a FixedMemoryChannel.
+ *
+ * Same as channelLoop(), but using the typed and in-place operations.
+ *
+ * @param prod Producer channel.
+ * @param cons Consumer channel.
+ *
+ * @return Number of ticks spent.
+ */
+static u32 fixedChannelLoop(FixedMemoryChannel<FileSystemMessage> *prod,
+                            FixedMemoryChannel<FileSystemMessage> *cons)
+{
+    FileSystemMessage *out;
+    const FileSystemMessage *in;
+    Size count = 0, size = 0;
+    u64 t1, t2;
+
+    t1 = timestamp();
+
+    while (count < BENCH_MESSAGES)
+    {
+        while ((out = prod->reserve()) != ZERO)
+        {
+            out->size = size++;
+            prod->commit();
+        }
+        while ((in = cons->peek()) != ZERO)
+        {
+            count++;
+            cons->consume();
+        }
+    }
+    t2 = timestamp();
+    return (u32)(t2 - t1);
+}
+
+/**
+ * Answer BENCH_PINGS wakeups from roundTripLoop().
+ *
+ * @param arg Non-zero to answer with ResumeSleep, or zero
+ *            to answer with Resume followed by EnterSleep.
+ */
+static void * replyLoop(void *arg)
+{
+    benchServer = ProcessCtl(SELF, GetPID);
+    ProcessCtl(SELF, EnterSleep, 0);
+
+    for (Size i = 0; i < BENCH_PINGS; i++)
+    {
+        // The last reply does not wait for another request
+        if (arg && i + 1 < BENCH_PINGS)
+            ProcessCtl(benchClient, ResumeSleep, 0);
+        else
+        {
+            ProcessCtl(benchClient, Resume, 0);
+            if (i + 1 < BENCH_PINGS)
+                ProcessCtl(SELF, EnterSleep, 0);
+        }
+    }
+    return ZERO;
+}
+
+/**
+ * Perform BENCH_PINGS synchronous wakeup round-trips with a thread.
+ *
+ * This is the sleep and wakeup pattern of an IPC call, without
+ * the message transfer and the request processing.
+ *
+ * @param handoff True to use the direct handoff with ResumeSleep,
+ *                false to use Resume followed by EnterSleep.
+ *
+ * @return Number of ticks spent.
+ */
+static u32 roundTripLoop(bool handoff)
+{
+    pthread_t thread;
+    u64 t1, t2;
+
+    benchClient = ProcessCtl(SELF, GetPID);
+    benchServer = 0;
+
+    if (pthread_create(&thread, ZERO, replyLoop, handoff ? (void *) 1 : ZERO) != 0)
+        return 0;
+
+    while (!benchServer)
+        ProcessCtl(SELF, Schedule);
+
+    t1 = timestamp();
+    for (Size i = 0; i < BENCH_PINGS; i++)
+    {
+        if (handoff)
+            ProcessCtl(benchServer, ResumeSleep, 0);
+        else
+        {
+            ProcessCtl(benchServer, Resume, 0);
+            ProcessCtl(SELF, EnterSleep, 0);
+        }
+    }
+    t2 = timestamp();
+
+    pthread_join(thread, ZERO);
+    return (u32)(t2 - t1);
+}
+
+static void * lockLoop(void *arg)
+{
+    for (Size i = 0; i < BENCH_LOCKS; i++)
+    {
+        pthread_mutex_lock(&benchMutex);
+        benchCounter++;
+        pthread_mutex_unlock(&benchMutex);
+    }
+    return ZERO;
+}
+
+static void * pongLoop(void *arg)
+{
+    for (Size i = 0; i < BENCH_PINGS; i++)
+    {
+        sem_wait(&benchPing);
+        sem_post(&benchPong);
+    }
+    return ZERO;
+}
+
+static void * spinLoop(void *arg)
+{
+    while (benchSpin)
+        benchCounter++;
+    return ZERO;
+}
+
+static void * workLoop(void *arg)
+{
+    volatile u32 value = (u32) (Address) arg;
+
+    for (Size i = 0; i < BENCH_WORK; i++)
+        value = (value * 1103515245) + 12345;
+
+    return ZERO;
+}
+
 BenchMark::BenchMark(int argc, char **argv)
     : POSIXApplication(argc, argv)
 {
     parser().setDescription("Perform system benchmark tests");
+    parser().registerFlag('d', "directory", "Also list a directory with many entries on /tmp");
+    parser().registerFlag('f', "first-io", "Only perform a single I/O and exit, to measure process start latency");
 }
 
 BenchMark::~BenchMark()
@@ -40,6 +268,26 @@ BenchMark::Result BenchMark::exec()
     Memory::Range range;
     char *foo[128];
     struct stat st;
+    struct timespec ts;
+    struct timeval tv;
+    Timer::Info timer;
+    SystemCallBatch *batch = new SystemCallBatch();
+    const char *sleepArgv[] = { "sleep", "0", ZERO };
+    const char *firstArgv[] = { "bench", "-f", ZERO };
+    const char *holdArgv[]  = { "sleep", "3", ZERO };
+    int children[BENCH_CHILDREN];
+    char *blocks[BENCH_BLOCKS * 2];
+    ProcessShares::MemoryShare share;
+    char buf[64];
+    int pid, fd, status;
+    pthread_t threads[2];
+
+    // Started by ourselves below: perform the first I/O and exit
+    if (arguments().get("first-io"))
+    {
+        stat("/", &st);
+        return Success;
+    }
 
     // ???
     // Retrieve current process ID with kernel trap
@@ -60,6 +308,30 @@ BenchMark::Result BenchMark::exec()
     t2 = timestamp();
     printf("SystemCall (Schedule) Ticks: %u\r\n", t2 - t1);
 
+    // Read the kernel timer with a system call
+    t1 = timestamp();
+    for (int i = 0; i < 128; i++)
+        ProcessCtl(SELF, InfoTimer, (Address) &timer);
+    t2 = timestamp();
+    printf("SystemCall (InfoTimer) Ticks: %u (%u on average)\r\n",
+            (u32)(t2 - t1), (u32)(t2 - t1) / 128);
+
+    // Read the monotonic clock from the kernel clock page
+    t1 = timestamp();
+    for (int i = 0; i < 128; i++)
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+    t2 = timestamp();
+    printf("clock_gettime() Ticks: %u (%u on average)\r\n",
+            (u32)(t2 - t1), (u32)(t2 - t1) / 128);
+
+    // Read the wall-clock time from the kernel clock page
+    t1 = timestamp();
+    for (int i = 0; i < 128; i++)
+        gettimeofday(&tv, ZERO);
+    t2 = timestamp();
+    printf("gettimeofday() Ticks: %u (%u on average)\r\n",
+            (u32)(t2 - t1), (u32)(t2 - t1) / 128);
+
     // Translate virtual memory address to physical memory address
     range.virt = 0x80000000;
     range.size = PAGESIZE;    
@@ -68,12 +340,303 @@ BenchMark::Result BenchMark::exec()
     t2 = timestamp();
     printf("SystemCall (VMCtl) Ticks: %u\r\n", t2 - t1);
 
+    // Translate sixteen addresses with one system call each
+    t1 = timestamp();
+    for (int i = 0; i < 16; i++)
+        VMCtl(SELF, LookupVirtual, &range);
+    t2 = timestamp();
+    printf("SystemCall (16x VMCtl) Ticks: %u\r\n", (u32)(t2 - t1));
+
+    // Translate the same sixteen addresses with one batched kernel entry
+    t1 = timestamp();
+    batch->clear();
+    for (int i = 0; i < 16; i++)
+        batch->vmCtl(SELF, LookupVirtual, &range);
+    batch->execute();
+    t2 = timestamp();
+    printf("SystemCallBatch (16x VMCtl) Ticks: %u\r\n", (u32)(t2 - t1));
+
     // Perform inter-process communication call
     t1 = timestamp();
     stat("/etc", &st);
     t2 = timestamp();
     printf("IPC (stat) Ticks: %u\r\n", t2 - t1);
 
+    // Compare the wakeup round-trip of IPC calls with and without direct handoff
+    {
+        u32 ticks = roundTripLoop(false);
+        printf("Round-trip (Resume+EnterSleep) Ticks: %u (%u on average)\r\n",
+                ticks, ticks / BENCH_PINGS);
+
+        ticks = roundTripLoop(true);
+        printf("Round-trip (ResumeSleep) Ticks: %u (%u on average)\r\n",
+                ticks, ticks / BENCH_PINGS);
+    }
+
+    // Measure MemoryChannel throughput on a local data and feedback page
+    {
+        u8 *mem = new u8[PAGESIZE * 3];
+        Address pages = ((Address) mem + PAGESIZE - 1) & ~(PAGESIZE - 1);
+        MemoryChannel prod, cons;
+        FixedMemoryChannel<FileSystemMessage> fixedProd, fixedCons;
+        u32 ticks;
+
+        MemoryBlock::set((void *) pages, 0, PAGESIZE * 2);
+        prod.setMode(Channel::Producer);
+        prod.setMessageSize(sizeof(FileSystemMessage));
+        prod.setVirtual(pages, pages + PAGESIZE);
+        cons.setMode(Channel::Consumer);
+        cons.setMessageSize(sizeof(FileSystemMessage));
+        cons.setVirtual(pages, pages + PAGESIZE);
+        ticks = channelLoop(&prod, &cons);
+        printf("MemoryChannel (%u messages) Ticks: %u (%u on average)\r\n",
+                BENCH_MESSAGES, ticks, ticks / BENCH_MESSAGES);
+
+        MemoryBlock::set((void *) pages, 0, PAGESIZE * 2);
+        fixedProd.setMode(Channel::Producer);
+        fixedProd.setVirtual(pages, pages + PAGESIZE);
+        fixedCons.setMode(Channel::Consumer);
+        fixedCons.setVirtual(pages, pages + PAGESIZE);
+        ticks = fixedChannelLoop(&fixedProd, &fixedCons);
+        printf("FixedMemoryChannel (%u messages) Ticks: %u (%u on average)\r\n",
+                BENCH_MESSAGES, ticks, ticks / BENCH_MESSAGES);
+        delete[] mem;
+    }
+
+    // Check the published mounts table, which only copies it if changed
+    t1 = timestamp();
+    for (int i = 0; i < 128; i++)
+        refreshMounts(0);
+    t2 = timestamp();
+    printf("refreshMounts() Ticks: %u (%u on average)\r\n",
+            (u32)(t2 - t1), (u32)(t2 - t1) / 128);
+
+    // Find the filesystem of a path in the mounts prefix tree
+    t1 = timestamp();
+    for (int i = 0; i < 128; i++)
+        findMount("/etc/hostname");
+    t2 = timestamp();
+    printf("findMount() Ticks: %u (%u on average)\r\n",
+            (u32)(t2 - t1), (u32)(t2 - t1) / 128);
+
+    // Open and close a file, which is one IPC call plus the mount lookup
+    t1 = timestamp();
+    for (int i = 0; i < 128; i++)
+        if ((fd = open("/etc", O_RDONLY)) >= 0)
+            close(fd);
+    t2 = timestamp();
+    printf("open()+close() Ticks: %u (%u on average)\r\n",
+            (u32)(t2 - t1), (u32)(t2 - t1) / 128);
+
+    // Write a file, which copies the path and data in one kernel entry
+    if ((fd = creat("/tmp/bench", S_IRUSR|S_IWUSR)) >= 0)
+    {
+        t1 = timestamp();
+        for (int i = 0; i < 128; i++)
+            write(fd, buf, sizeof(buf));
+        t2 = timestamp();
+        printf("IPC (write) Ticks: %u (%u on average)\r\n",
+                (u32)(t2 - t1), (u32)(t2 - t1) / 128);
+        close(fd);
+    }
+
+    // Spawn a program, which sets up the new process in one kernel entry
+    t1 = timestamp();
+    if ((pid = forkexec("/bin/sleep", sleepArgv)) >= 0)
+        waitpid(pid, &status, 0);
+    t2 = timestamp();
+    printf("forkexec() Ticks: %u\r\n", (u32)(t2 - t1));
+
+    // Start processes which exit after their first I/O, using the channels set up by forkexec()
+    t1 = timestamp();
+    for (int i = 0; i < 16; i++)
+        if ((pid = forkexec("/bin/bench", firstArgv)) >= 0)
+            waitpid(pid, &status, 0);
+    t2 = timestamp();
+    printf("Process start to first I/O (16x) Ticks: %u (%u on average)\r\n",
+            (u32)(t2 - t1), (u32)(t2 - t1) / 16);
+
+    // Keep processes alive to measure the memory used by each of them
+    SystemInformation before;
+    for (Size i = 0; i < BENCH_CHILDREN; i++)
+        children[i] = forkexec("/bin/sleep", holdArgv);
+    sleep(1);
+    SystemInformation after;
+    printf("Resident memory (%ux sleep): %u KB (%u KB on average)\r\n", BENCH_CHILDREN,
+            (before.memoryAvail - after.memoryAvail) / 1024,
+            (before.memoryAvail - after.memoryAvail) / 1024 / BENCH_CHILDREN);
+
+    // Create memory shares with a child, after the idle process had time to fill the zero pool
+    share.pid          = children[0];
+    share.coreId       = after.coreId;
+    share.range.size   = PAGESIZE * 4;
+    share.range.access = Memory::Readable | Memory::Writable;
+    t1 = timestamp();
+    for (Size i = 0; i < BENCH_SHARES; i++)
+    {
+        share.tagId = i;
+        VMShare(children[0], API::Create, &share);
+    }
+    t2 = timestamp();
+    printf("VMShare create (%ux) Ticks: %u (%u on average)\r\n",
+            BENCH_SHARES, (u32)(t2 - t1), (u32)(t2 - t1) / BENCH_SHARES);
+
+    // Look up each of the shares, which all have the same peer
+    t1 = timestamp();
+    for (Size i = 0; i < BENCH_SHARES; i++)
+    {
+        share.tagId = i;
+        VMShare(children[0], API::Read, &share);
+    }
+    t2 = timestamp();
+    VMShare(children[0], API::Delete, &share);
+    printf("VMShare read (%ux, same peer) Ticks: %u (%u on average)\r\n",
+            BENCH_SHARES, (u32)(t2 - t1), (u32)(t2 - t1) / BENCH_SHARES);
+
+    // Create and remove one share at a time, while the share
+    // index also holds many shares with the other children
+    share.range.size = PAGESIZE;
+    for (Size i = 1; i < BENCH_CHILDREN; i++)
+    {
+        for (Size j = 0; j < BENCH_SHARES; j++)
+        {
+            share.tagId = j;
+            VMShare(children[i], API::Create, &share);
+        }
+    }
+    t1 = timestamp();
+    for (Size i = 0; i < BENCH_SHARES; i++)
+    {
+        share.tagId = i;
+        VMShare(children[0], API::Create, &share);
+        VMShare(children[0], API::Delete, &share);
+    }
+    t2 = timestamp();
+    for (Size i = 1; i < BENCH_CHILDREN; i++)
+        VMShare(children[i], API::Delete, &share);
+    share.range.size = PAGESIZE * 4;
+    printf("VMShare create/remove (%ux, %u shares) Ticks: %u (%u on average)\r\n",
+            BENCH_SHARES, BENCH_SHARES * (BENCH_CHILDREN - 1),
+            (u32)(t2 - t1), (u32)(t2 - t1) / BENCH_SHARES);
+
+    // Grow the heap with blocks which each need new pages
+    t1 = timestamp();
+    for (Size i = 0; i < BENCH_BLOCKS; i++)
+        blocks[i] = new char[BENCH_BLOCK_SIZE];
+    t2 = timestamp();
+    printf("Heap growth (%ux %u KB) Ticks: %u (%u on average)\r\n",
+            BENCH_BLOCKS, BENCH_BLOCK_SIZE / 1024, (u32)(t2 - t1), (u32)(t2 - t1) / BENCH_BLOCKS);
+
+    // Repeat under load, which keeps the idle process from refilling the zero pool
+    benchSpin = true;
+    pthread_create(&threads[0], ZERO, spinLoop, ZERO);
+    t1 = timestamp();
+    for (Size i = 0; i < BENCH_SHARES; i++)
+    {
+        share.tagId = i;
+        VMShare(children[0], API::Create, &share);
+    }
+    t2 = timestamp();
+    VMShare(children[0], API::Delete, &share);
+    printf("VMShare create under load (%ux) Ticks: %u (%u on average)\r\n",
+            BENCH_SHARES, (u32)(t2 - t1), (u32)(t2 - t1) / BENCH_SHARES);
+
+    t1 = timestamp();
+    for (Size i = BENCH_BLOCKS; i < BENCH_BLOCKS * 2; i++)
+        blocks[i] = new char[BENCH_BLOCK_SIZE];
+    t2 = timestamp();
+    benchSpin = false;
+    pthread_join(threads[0], ZERO);
+    printf("Heap growth under load (%ux %u KB) Ticks: %u (%u on average)\r\n",
+            BENCH_BLOCKS, BENCH_BLOCK_SIZE / 1024, (u32)(t2 - t1), (u32)(t2 - t1) / BENCH_BLOCKS);
+
+    for (Size i = 0; i < BENCH_BLOCKS * 2; i++)
+        delete[] blocks[i];
+
+    for (Size i = 0; i < BENCH_CHILDREN; i++)
+        if (children[i] >= 0)
+            waitpid(children[i], &status, 0);
+
+    // Lock and unlock a mutex without contention, which does not enter the kernel
+    t1 = timestamp();
+    for (int i = 0; i < 128; i++)
+    {
+        pthread_mutex_lock(&benchMutex);
+        pthread_mutex_unlock(&benchMutex);
+    }
+    t2 = timestamp();
+    printf("pthread_mutex (uncontended) Ticks: %u (%u on average)\r\n",
+            (u32)(t2 - t1), (u32)(t2 - t1) / 128);
+
+    // Contend a mutex between two threads
+    benchCounter = 0;
+    t1 = timestamp();
+    for (int i = 0; i < 2; i++)
+        pthread_create(&threads[i], ZERO, lockLoop, ZERO);
+    for (int i = 0; i < 2; i++)
+        pthread_join(threads[i], ZERO);
+    t2 = timestamp();
+    printf("pthread_mutex (2x%u contended) Ticks: %u (%u on average)\r\n",
+            BENCH_LOCKS, (u32)(t2 - t1), (u32)(t2 - t1) / (BENCH_LOCKS * 2));
+
+    // Hand a semaphore back and forth between two threads
+    sem_init(&benchPing, 0, 0);
+    sem_init(&benchPong, 0, 0);
+    pthread_create(&threads[0], ZERO, pongLoop, ZERO);
+    t1 = timestamp();
+    for (int i = 0; i < BENCH_PINGS; i++)
+    {
+        sem_post(&benchPing);
+        sem_wait(&benchPong);
+    }
+    t2 = timestamp();
+    pthread_join(threads[0], ZERO);
+    printf("sem_post/sem_wait round-trip Ticks: %u (%u on average)\r\n",
+            (u32)(t2 - t1), (u32)(t2 - t1) / BENCH_PINGS);
+
+    // Run the same work on one thread per core, for each number of cores
+    {
+        SystemInformation sysinfo;
+        pthread_t workers[MAX_CORES];
+        Size cores = sysinfo.coreCount ? sysinfo.coreCount : 1;
+
+        for (Size n = 1; n <= cores && n <= MAX_CORES; n++)
+        {
+            t1 = timestamp();
+            for (Size i = 0; i < n; i++)
+                pthread_create(&workers[i], ZERO, workLoop, (void *) i);
+            for (Size i = 0; i < n; i++)
+                pthread_join(workers[i], ZERO);
+            t2 = timestamp();
+            printf("Parallel work (%ux %u iterations) Ticks: %u (%u per 1K iterations)\r\n",
+                    n, BENCH_WORK, (u32)(t2 - t1), (u32)((t2 - t1) / ((n * BENCH_WORK) / 1024)));
+        }
+    }
+
+    // List a large directory on the tmpfs
+    if (arguments().get("directory"))
+    {
+        DIR *dir;
+        Size entries = 0;
+
+        mkdir("/tmp/benchdir", S_IRWXU);
+        for (Size i = 0; i < BENCH_DIRENTS; i++)
+        {
+            snprintf(buf, sizeof(buf), "/tmp/benchdir/%u", i);
+            creat(buf, S_IRUSR | S_IWUSR);
+        }
+        t1 = timestamp();
+        if ((dir = opendir("/tmp/benchdir")))
+        {
+            while (readdir(dir))
+                entries++;
+            closedir(dir);
+        }
+        t2 = timestamp();
+        printf("opendir/readdir (%u entries) Ticks: %u (%u on average)\r\n",
+                entries, (u32)(t2 - t1), entries ? (u32)(t2 - t1) / entries : 0);
+    }
+
     // Allocate heap memory
     t1 = timestamp();
     for (int i = 0; i < 128; i++)
@@ -90,6 +653,44 @@ BenchMark::Result BenchMark::exec()
     printf("release() Ticks: %u (%u on average)\r\n",
             (u32)(t2 - t1), (u32)(t2 - t1) / 128);
 
+    // Measure the latency from the kernel interrupt hook to the user
+    // handler on the timer interrupt. Done last, because the watched
+    // interrupt keeps waking up this process until it exits.
+    {
+        SystemInformation sysinfo;
+        InterruptInfo irq;
+        u32 latency[BENCH_INTERRUPTS];
+        u64 total = 0;
+        Size count = 0;
+
+        if (ProcessCtl(SELF, WatchIRQ, sysinfo.timerIrq) == API::Success)
+        {
+            while (count < BENCH_INTERRUPTS)
+            {
+                ProcessCtl(SELF, EnterSleep, 0);
+
+                while (count < BENCH_INTERRUPTS &&
+                       ProcessCtl(SELF, ReadIRQ, (Address) &irq) == API::Success)
+                {
+                    latency[count] = (u32) (timestamp() - irq.timestamp);
+                    total += latency[count++];
+                }
+            }
+            introSort(latency, latency + BENCH_INTERRUPTS);
+            printf("Interrupt latency (%ux IRQ %u) Ticks: min %u median %u "
+                   "90%% %u 99%% %u max %u (%u on average)\r\n",
+                    BENCH_INTERRUPTS, sysinfo.timerIrq, latency[0],
+                    latency[BENCH_INTERRUPTS / 2],
+                    latency[(BENCH_INTERRUPTS * 90) / 100],
+                    latency[(BENCH_INTERRUPTS * 99) / 100],
+                    latency[BENCH_INTERRUPTS - 1],
+                    (u32) (total / BENCH_INTERRUPTS));
+        }
+        else
+            printf("Interrupt latency: failed to watch IRQ %u\r\n", sysinfo.timerIrq);
+    }
+
     // Done
+    delete batch;
     return Success;
 }
@@ -129,6 +129,10 @@ Size BootImageCreate::readBootSymbols(const char *conf_file,
             }
             entry->numRegions   = num;
             entry->symbol.type  = BootProgram;
+
+            // Shared libraries are mapped into dynamically linked programs
+            if (strlen(line) > 3 && strcmp(line + strlen(line) - 3, ".so") == 0)
+                entry->symbol.type = BootLibrary;
             format->entry((Address *)&entry->symbol.entry);
         }
         // BootData
@@ -236,7 +240,7 @@ BootImageCreate::Result BootImageCreate::exec()
             symbols[i].segmentsTotalSize += segments[segCount].size;
 
             // Increment data pointer. Align on memory page boundary
-            dataOffset += segments[i].size;
+            dataOffset += segments[segCount].size;
             lastDataOffset = dataOffset;
             dataOffset += PAGESIZE - (dataOffset % PAGESIZE);
             segCount++;
@@ -270,7 +274,7 @@ BootImageCreate::Result BootImageCreate::exec()
         for (Size j = 0; j < input[i]->numRegions; j++)
         {
             // Adjust file pointer
-            if (fseek(fp, segments[symbols[i].segmentsOffset].offset,
+            if (fseek(fp, segments[symbols[i].segmentsOffset + j].offset,
                       SEEK_SET) == -1)
             {
                 fprintf(stderr, "%s: failed to seek to BootSegment contents in `%s': %s\n",
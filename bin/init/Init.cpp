@@ -39,12 +39,20 @@ Init::Result Init::exec()
     const char *script = arguments().get("script") ?
                          arguments().get("script") : "/etc/init.sh";
     const char *av[] = { "/bin/sh", script, ZERO };
+    const char *timeArgv[] = { "/server/time/server", ZERO };
     SystemInformation info;
 
     // Only run on core0
     if (info.coreId != 0)
         return Success;
 
+    // Only the time server may set the system time
+    if (forkexec_system(timeArgv[0], timeArgv) == -1 && errno != ENOENT)
+    {
+        ERROR("forkexec_system() failed for " << timeArgv[0] << ": " <<
+              strerror(errno));
+    }
+
     NOTICE("Starting init script: " << script);
 
     // Execute the run commands file
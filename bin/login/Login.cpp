@@ -15,6 +15,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <FreeNOS/System.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -120,6 +121,9 @@ Login::Result Login::exec()
         break;
     }
 
+    // User shells are not system processes
+    ProcessCtl(SELF, DropSystem, 0);
+
     // Loop forever with a login prompt
     while (true)
     {
@@ -24,6 +24,7 @@
 #include <unistd.h>
 #include <limits.h>
 #include <errno.h>
+#include <SystemCallBatch.h>
 #include "ProcessList.h"
 
 const char * ProcessList::ProcessStates[] =
@@ -45,32 +46,47 @@ ProcessList::Result ProcessList::exec()
 {
     Arch::MemoryMap map;
     Memory::Range range = map.range(MemoryMap::UserArgs);
-    ProcessInfo info;
+    ProcessInfo *info = new ProcessInfo[MAX_PROCS];
+    SystemCallBatch *batch = new SystemCallBatch;
     String out;
-    char line[256], cmd[PATH_MAX];
+    char line[256];
+    Size count;
 
-    // Print header
-    out << "ID  PARENT  USER GROUP STATUS     CMD\r\n";
-    memset(&cmd, 0, sizeof(cmd));
+    // Snapshot the process table with one system call
+    count = ProcessCtl(SELF, InfoTable, (Address) info, MAX_PROCS);
+    char (*cmd)[PATH_MAX] = new char[count][PATH_MAX];
+    memset(cmd, 0, count * PATH_MAX);
 
-    // Loop processes
-    for (uint i = 0; i < MAX_PROCS; i++)
+    // Get the commands, batching the copies into few kernel entries
+    for (Size i = 0; i < count; i++)
     {
-        // Request kernel's process information
-        if (ProcessCtl(i, InfoPID, (Address) &info) != API::NotFound)
+        if (batch->vmCopy(info[i].id, API::Read, (Address) cmd[i],
+                          range.virt, PATH_MAX) == SystemCallBatch::QueueFull)
         {
-            DEBUG("PID " << i << " state = " << info.state);
+            batch->execute();
+            batch->clear();
+            batch->vmCopy(info[i].id, API::Read, (Address) cmd[i], range.virt, PATH_MAX);
+        }
+    }
+    batch->execute();
 
-            // Get the command
-            VMCopy(i, API::Read, (Address) cmd, range.virt, PATH_MAX);
+    // Print header
+    out << "   ID  PARENT  USER GROUP STATUS     CMD\r\n";
 
-            // Output a line
-            snprintf(line, sizeof(line),
-                    "%3d %7d %4d %5d %10s %32s\r\n",
-                     i, info.parent, 0, 0, ProcessStates[info.state], cmd);
-            out << line;
-        }
+    // Loop processes
+    for (Size i = 0; i < count; i++)
+    {
+        DEBUG("PID " << info[i].id << " state = " << info[i].state);
+
+        // Output a line
+        snprintf(line, sizeof(line),
+                "%5d %7d %4d %5d %10s %32s\r\n",
+                 info[i].id, info[i].parent, 0, 0, ProcessStates[info[i].state], cmd[i]);
+        out << line;
     }
+    delete[] cmd;
+    delete[] info;
+    delete batch;
 
     // Output the table
     write(1, *out, out.length());
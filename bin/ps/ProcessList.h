@@ -27,6 +27,9 @@
 
 /**
  * Output the system process list.
+ *
+ * Processes are listed in process table order. ProcessIDs are reused after
+ * wrapping around, so a low ProcessID is not necessarily an old process.
  */
 class ProcessList : public POSIXApplication
 {
@@ -22,13 +22,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <fcntl.h>
-#include <sys/time.h>
+#include <time.h>
 #include "SysInfo.h"
 
 SysInfo::SysInfo(int argc, char **argv)
     : POSIXApplication(argc, argv)
 {
     parser().setDescription("Print global system information");
+    parser().registerFlag('c', "caches", "Also print statistics of the kernel heap caches");
 }
 
 SysInfo::~SysInfo()
@@ -40,8 +41,7 @@ SysInfo::Result SysInfo::exec()
     SystemInformation info;
     FileSystemMessage msg;
     Timer::Info timer;
-    struct timeval tv;
-    struct timezone tz;
+    struct timespec uptime;
 
     // Retrieve number of cores from the CoreServer
     msg.type   = ChannelMessage::Request;
@@ -51,20 +51,40 @@ SysInfo::Result SysInfo::exec()
 
     // Retrieve scheduler timer info from the kernel
     ProcessCtl(SELF, InfoTimer, (Address) &timer);
-    gettimeofday(&tv, &tz);
+    clock_gettime(CLOCK_MONOTONIC, &uptime);
 
     // Print all information to standard output
     printf("Memory Total:     %u KB\r\n"
            "Memory Available: %u KB\r\n"
+           "Memory Zeroed:    %u KB\r\n"
            "Processor Cores:  %u\r\n"
            "Timer:            %l ticks (%u hertz)\r\n"
            "Uptime:           %l.%us\r\n",
             info.memorySize / 1024,
             info.memoryAvail / 1024,
+            info.memoryZeroed * (PAGESIZE / 1024),
             msg.size,
             (u32) timer.ticks,
             timer.frequency,
-            (u32) tv.tv_sec, tv.tv_usec);
+            (u32) uptime.tv_sec, (u32) uptime.tv_nsec / 1000);
+
+    // Print kernel heap caches
+    if (arguments().get("caches"))
+    {
+        printf("\r\n%16s %6s %6s %8s %9s %12s\r\n",
+               "CACHE", "SIZE", "SLABS", "OBJECTS", "CAPACITY", "ALLOCATIONS");
+
+        for (Size i = 0; i < info.cacheCount; i++)
+        {
+            printf("%16s %6u %6u %8u %9u %12u\r\n",
+                    info.caches[i].name,
+                    info.caches[i].objectSize,
+                    info.caches[i].slabs,
+                    info.caches[i].objects,
+                    info.caches[i].capacity,
+                    info.caches[i].allocations);
+        }
+    }
 
     // Done
     return Success;
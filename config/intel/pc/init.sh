@@ -11,7 +11,6 @@ stdio /console/tty0 /console/tty0
 #
 # System Servers and Drivers.
 #
-/server/time/server &
 /server/filesystem/tmp/server /tmp &
 /server/network/loopback/server &
 
@@ -31,6 +31,7 @@ API::API()
     m_apis.insert(VMCtlNumber,      (Handler *) VMCtlHandler);
     m_apis.insert(VMShareNumber,    (Handler *) VMShareHandler);
     m_apis.insert(IOCtlNumber,      (Handler *) IOCtlHandler);
+    m_apis.insert(SystemCallEnterNumber, (Handler *) SystemCallEnterHandler);
 }
 
 API::Result API::invoke(Number number,
@@ -59,6 +60,7 @@ Log & operator << (Log &log, API::Operation op)
         case API::SendReceive: log.append("SendReceive"); break;
         case API::Read:        log.append("Read");        break;
         case API::ReadPhys:    log.append("ReadPhys");    break;
+        case API::Connect:     log.append("Connect");     break;
         case API::Write:       log.append("Write");       break;
     }
     return log;
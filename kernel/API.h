@@ -52,7 +52,8 @@ class API
         VMCopyNumber,
         VMCtlNumber,
         VMShareNumber,
-        IOCtlNumber
+        IOCtlNumber,
+        SystemCallEnterNumber
     }
     Number;
 
@@ -68,7 +69,8 @@ class API
         InvalidArgument = -4,
         OutOfMemory     = -5,
         IOError         = -6,
-        AlreadyExists   = -7
+        AlreadyExists   = -7,
+        Cancelled       = -8
     }
     Error;
 
@@ -93,7 +95,8 @@ class API
         SendReceive = 4,
         Read        = 5,
         Write       = 6,
-        ReadPhys    = 7
+        ReadPhys    = 7,
+        Connect     = 8
     }
     Operation;
 
@@ -138,6 +141,7 @@ Log & operator << (Log &log, API::Operation op);
 #include "API/VMCtl.h"
 #include "API/VMShare.h"
 #include "API/IOCtl.h"
+#include "API/SystemCallEnter.h"
 #include "API/ProcessID.h"
 
 #endif /* __KERNEL_API_H */
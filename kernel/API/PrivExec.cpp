@@ -16,6 +16,7 @@
  */
 
 #include <Log.h>
+#include <SplitAllocator.h>
 #include "PrivExec.h"
 
 API::Result PrivExecHandler(PrivOperation op, Address addr)
@@ -28,10 +29,24 @@ API::Result PrivExecHandler(PrivOperation op, Address addr)
         ProcessManager *procs = Kernel::instance->getProcessManager();
         procs->setIdle(procs->current());
 #ifdef INTEL
+        SplitAllocator *alloc = Kernel::instance->getAllocator();
+
+        // Other cores may run the kernel while this core idles
+        Kernel::instance->unlock();
         irq_enable();
 
+        // Clear free pages one at a time while there is nothing else to do
         while (true)
-            idle();
+        {
+            irq_disable();
+            Kernel::instance->lock();
+            Size cleared = alloc->fillZeroPool(1);
+            Kernel::instance->unlock();
+            irq_enable();
+
+            if (!cleared)
+                idle();
+        }
 #endif /* INTEL */
         }
         return API::Success;
@@ -44,6 +59,9 @@ API::Result PrivExecHandler(PrivOperation op, Address addr)
         cpu_shutdown();
         return API::Success;
 
+    case ZeroPages:
+        return (API::Result) Kernel::instance->getAllocator()->fillZeroPool(ZEROPOOL_BATCH);
+
     case WriteConsole:
         if (Log::instance)
         {
@@ -28,6 +28,9 @@
  * @{
  */
 
+/** Maximum number of pages cleared by one PrivExec(ZeroPages) call. */
+#define ZEROPOOL_BATCH 8
+
 /**
  * Available operations to perform using PrivExec().
  *
@@ -38,7 +41,8 @@ typedef enum PrivOperation
     Idle         = 0,
     Reboot       = 1,
     Shutdown     = 2,
-    WriteConsole = 3
+    WriteConsole = 3,
+    ZeroPages    = 4
 }
 PrivOperation;
 
@@ -48,6 +52,7 @@ PrivOperation;
  * @param op The operation to perform.
  *
  * @return API::Success on success and other API::ErrorCode on failure.
+ *         For ZeroPages, the number of free pages cleared for the zero pool.
  */
 inline API::Result PrivExec(PrivOperation op, Address param = 0)
 {
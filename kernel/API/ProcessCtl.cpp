@@ -19,20 +19,9 @@
 #include <FreeNOS/Kernel.h>
 #include <FreeNOS/Config.h>
 #include <FreeNOS/Process.h>
-#include <FreeNOS/ProcessEvent.h>
 #include <Log.h>
 #include "ProcessCtl.h"
 
-void interruptNotify(CPUState *st, Process *p)
-{
-    ProcessEvent event;
-
-    event.type   = InterruptEvent;
-    event.number = IRQ_REG(st);
-
-    p->raiseEvent(&event);
-}
-
 API::Result ProcessCtlHandler(ProcessID procID,
                               ProcessOperation action,
                               Address addr,
@@ -40,6 +29,13 @@ API::Result ProcessCtlHandler(ProcessID procID,
 {
     Process *proc = ZERO;
     ProcessInfo *info = (ProcessInfo *) addr;
+    InterruptInfo *irqInfo = (InterruptInfo *) addr;
+    TimerSpec *timerSpec = (TimerSpec *) addr;
+    TimerEvent *timerEvents = (TimerEvent *) addr;
+    ThreadSpec *threadSpec = (ThreadSpec *) addr;
+    Memory::Access access;
+    Address paddr;
+    Size count = 0;
     ProcessManager *procs = Kernel::instance->getProcessManager();
     Timer *timer;
     Arch::MemoryMap map;
@@ -47,7 +43,7 @@ API::Result ProcessCtlHandler(ProcessID procID,
     DEBUG("#" << procs->current()->getID() << " " << action << " -> " << procID << " (" << addr << ")");
 
     // Does the target process exist?
-    if(action != GetPID && action != Spawn)
+    if(action != GetPID && action != Spawn && action != SpawnThread && action != InfoTable)
     {
         if (procID == SELF)
             proc = procs->current();
@@ -58,10 +54,47 @@ API::Result ProcessCtlHandler(ProcessID procID,
     switch (action)
     {
     case Spawn:
-        proc = procs->create(addr, map);
+        if (!(proc = procs->create(addr, map)))
+            return API::OutOfMemory;
+
         proc->setParent(procs->current()->getID());
         return proc->getID();
 
+    case SpawnThread:
+        // The thread runs in the memory context of the current Process
+        if (!(proc = procs->create(threadSpec->entry, map, procs->current(),
+                                   threadSpec->stack, threadSpec->data)))
+            return API::OutOfMemory;
+
+        proc->setParent(procs->current()->getID());
+        proc->setSystem(procs->current()->isSystem());
+        proc->wakeup();
+        return proc->getID();
+
+    case GetThreadData:
+        return procs->current()->getThreadData();
+
+    case WaitAddress:
+    case WakeAddress:
+        // Wait queues are keyed by physical address to work across shared mappings
+        if ((addr & (sizeof(u32) - 1)) ||
+            procs->current()->getMemoryContext()->access(addr, &access) != MemoryContext::Success ||
+            !(access & Memory::User) ||
+            procs->current()->getMemoryContext()->lookup(addr, &paddr) != MemoryContext::Success)
+            return API::AccessViolation;
+
+        if (action == WakeAddress)
+            return procs->getWaitTable()->wake(paddr, output);
+
+        // Only sleep if the address still holds the expected value
+        if (*(volatile u32 *) addr == output)
+        {
+            procs->getWaitTable()->insert(procs->current(), paddr);
+            procs->current()->setState(Process::Sleeping);
+            procs->schedule();
+        }
+        break;
+
     case KillPID:
         procs->remove(proc, addr); // Addr contains the exit status
         procs->schedule();
@@ -83,9 +116,32 @@ API::Result ProcessCtlHandler(ProcessID procID,
         break;
 
     case WatchIRQ:
-        Kernel::instance->hookIntVector(IRQ(addr), (InterruptHandler *)interruptNotify, (ulong)proc);
+        if (proc->watchInterrupt(addr, IRQ(addr)) != Process::Success)
+            return API::OutOfMemory;
+        break;
+
+    case ReadIRQ:
+        if (proc->readInterrupt(&irqInfo->irq, &irqInfo->count, &irqInfo->timestamp) != Process::Success)
+            return API::NotFound;
+        break;
+
+    case ArmTimer:
+        if (proc->armTimer(timerSpec->id, timerSpec->ticks, timerSpec->interval) != Process::Success)
+            return API::OutOfMemory;
         break;
 
+    case DisarmTimer:
+        if (proc->disarmTimer(addr) != Process::Success)
+            return API::NotFound;
+        break;
+
+    case ReadTimers:
+        // Return all expired timers at once
+        while (count < output && proc->readTimer(&timerEvents[count].id,
+                                                 &timerEvents[count].count) == Process::Success)
+            count++;
+        return count;
+
     case EnableIRQ:
         Kernel::instance->enableIRQ(addr, true);
         break;
@@ -101,8 +157,29 @@ API::Result ProcessCtlHandler(ProcessID procID,
         info->kernelStack   = proc->getKernelStack();
         info->pageDirectory = proc->getPageDirectory();
         info->parent = proc->getParent();
+        info->threadGroup = proc->getThreadGroup();
+        info->cpuTime = proc->getCpuTime();
         break;
 
+    case InfoTable:
+        // Snapshot all processes at once
+        for (Size i = 0; i < MAX_PROCS && count < output; i++)
+        {
+            if ((proc = procs->getProcessTable()->get(i)) != ZERO)
+            {
+                info[count].id    = proc->getID();
+                info[count].state = proc->getState();
+                info[count].userStack     = proc->getUserStack();
+                info[count].kernelStack   = proc->getKernelStack();
+                info[count].pageDirectory = proc->getPageDirectory();
+                info[count].parent = proc->getParent();
+                info[count].threadGroup = proc->getThreadGroup();
+                info[count].cpuTime = proc->getCpuTime();
+                count++;
+            }
+        }
+        return count;
+
     case WaitPID:
         procs->current()->setWait(proc->getID());
         procs->current()->setState(Process::Waiting);
@@ -132,6 +209,39 @@ API::Result ProcessCtlHandler(ProcessID procID,
     case SetStack:
         proc->setUserStack(addr);
         break;
+
+    case SetTime:
+        if (!procs->current()->isSystem())
+            return API::AccessViolation;
+
+        Kernel::instance->setTime(addr);
+        break;
+
+    case DropSystem:
+        procs->current()->setSystem(false);
+        break;
+
+    case GrantSystem:
+        // Only system processes can grant it, and only to their own children
+        if (!procs->current()->isSystem() || proc->getParent() != procs->current()->getID())
+            return API::AccessViolation;
+
+        proc->setSystem(true);
+        break;
+
+    case ResumeSleep:
+        // Wakeup the target and switch directly to it, donating our timeslice
+        proc->wakeup();
+
+        if (procs->current()->sleep((Timer::Info *)addr) == Process::Success)
+            procs->schedule(proc->getState() == Process::Ready ? proc : ZERO);
+        break;
+
+    case SwitchSleep:
+        // Same as EnterSleep, but prefer to run the target if it is ready
+        if (procs->current()->sleep((Timer::Info *)addr) == Process::Success)
+            procs->schedule(proc->getState() == Process::Ready ? proc : ZERO);
+        break;
     }
     return API::Success;
 }
@@ -154,6 +264,20 @@ Log & operator << (Log &log, ProcessOperation op)
         case Schedule:  log.append("Schedule"); break;
         case Resume:    log.append("Resume"); break;
         case SetStack:  log.append("SetStack"); break;
+        case SetTime:   log.append("SetTime"); break;
+        case ResumeSleep: log.append("ResumeSleep"); break;
+        case SwitchSleep: log.append("SwitchSleep"); break;
+        case ReadIRQ:   log.append("ReadIRQ"); break;
+        case ArmTimer:  log.append("ArmTimer"); break;
+        case DisarmTimer: log.append("DisarmTimer"); break;
+        case ReadTimers: log.append("ReadTimers"); break;
+        case SpawnThread: log.append("SpawnThread"); break;
+        case GetThreadData: log.append("GetThreadData"); break;
+        case WaitAddress: log.append("WaitAddress"); break;
+        case WakeAddress: log.append("WakeAddress"); break;
+        case InfoTable: log.append("InfoTable"); break;
+        case DropSystem: log.append("DropSystem"); break;
+        case GrantSystem: log.append("GrantSystem"); break;
         default:        log.append("???"); break;
     }
     return log;
@@ -51,7 +51,21 @@ typedef enum ProcessOperation
     EnterSleep,
     Schedule,
     Resume,
-    SetStack
+    SetStack,
+    SetTime,
+    ResumeSleep,
+    SwitchSleep,
+    ReadIRQ,
+    ArmTimer,
+    DisarmTimer,
+    ReadTimers,
+    SpawnThread,
+    GetThreadData,
+    WaitAddress,
+    WakeAddress,
+    InfoTable,
+    DropSystem,
+    GrantSystem
 }
 ProcessOperation;
 
@@ -77,9 +91,76 @@ typedef struct ProcessInfo
 
     /** Physical address of the page directory. */
     Address pageDirectory;
+
+    /** Process which owns the memory context. Equal to id unless a thread. */
+    ProcessID threadGroup;
+
+    /** Consumed processor time in timestamp() cycles. */
+    u64 cpuTime;
 }
 ProcessInfo;
 
+/**
+ * Interrupt information structure, used for ReadIRQ.
+ */
+typedef struct InterruptInfo
+{
+    /** Interrupt number as given to WatchIRQ. */
+    u32 irq;
+
+    /** Number of interrupts since the last ReadIRQ. */
+    Size count;
+
+    /** Value of timestamp() when the first of them arrived. */
+    u64 timestamp;
+}
+InterruptInfo;
+
+/**
+ * Timer specification, used for ArmTimer.
+ */
+typedef struct TimerSpec
+{
+    /** Timer identifier, chosen by the caller. */
+    u32 id;
+
+    /** Number of timer ticks until the first expiration. */
+    u32 ticks;
+
+    /** Number of timer ticks between expirations or zero for a one-shot timer. */
+    u32 interval;
+}
+TimerSpec;
+
+/**
+ * Timer expiration event, used for ReadTimers.
+ */
+typedef struct TimerEvent
+{
+    /** Timer identifier. */
+    u32 id;
+
+    /** Number of expirations since the last ReadTimers. */
+    Size count;
+}
+TimerEvent;
+
+/**
+ * Thread specification, used for SpawnThread.
+ */
+typedef struct ThreadSpec
+{
+    /** Initial program counter value. */
+    Address entry;
+
+    /** Initial user stack pointer, or zero to map a stack in the UserStack region. */
+    Address stack;
+
+    /** User address of the thread-local data, returned by GetThreadData. */
+    Address data;
+}
+ThreadSpec;
+
 /** Operator to print a ProcessOperation to a Log */
 Log & operator << (Log &log, ProcessOperation op);
 
@@ -89,10 +170,24 @@ Log & operator << (Log &log, ProcessOperation op);
  * @param proc Target Process' ID.
  * @param op The operation to perform.
  * @param addr Input argument address, used for program entry point for Spawn,
- *             ProcessInfo pointer for Info.
- * @param output Output argument address (optional).
+ *             ProcessInfo pointer for Info, InterruptInfo pointer for ReadIRQ,
+ *             TimerSpec pointer for ArmTimer, timer identifier for DisarmTimer,
+ *             TimerEvent array for ReadTimers, seconds since the epoch for SetTime,
+ *             optional Timer::Info pointer for EnterSleep, ResumeSleep and SwitchSleep,
+ *             ThreadSpec pointer for SpawnThread, u32 user address for WaitAddress and WakeAddress,
+ *             ProcessInfo array for InfoTable.
+ * @param output Output argument address (optional), maximum number of TimerEvents for ReadTimers,
+ *               expected value for WaitAddress, maximum number of waiters to wakeup for WakeAddress,
+ *               maximum number of ProcessInfos for InfoTable.
  *
  * @return API::Success on success and other API::ErrorCode on failure.
+ *         ReadTimers returns the number of TimerEvents written and
+ *         InfoTable the number of ProcessInfos written, ordered by their process table slot
+ *         (ProcessID modulo MAX_PROCS) rather than by ProcessID. ProcessIDs wrap around
+ *         from KERNEL_PID to ROOTFS_PID + 1, so a ProcessID may belong to a newer
+ *         Process than its value suggests.
+ *         SpawnThread returns the ProcessID of the thread, GetThreadData the thread data
+ *         address and WakeAddress the number of woken up Processes.
  */
 inline API::Result ProcessCtl(ProcessID proc, ProcessOperation op, Address addr = 0, Address output = 0)
 {
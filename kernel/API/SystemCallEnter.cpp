@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <FreeNOS/Kernel.h>
+#include <Log.h>
+#include "SystemCallEnter.h"
+
+/**
+ * Check if a system call may switch to another process.
+ *
+ * The batch cannot continue after a switch, because the
+ * ring is only accessible in the address space of the caller.
+ */
+static bool isScheduling(const SystemCallEntry *entry)
+{
+    if (entry->number == API::SystemCallEnterNumber)
+        return true;
+
+    if (entry->number != API::ProcessCtlNumber)
+        return false;
+
+    switch (entry->args[1])
+    {
+        case KillPID:
+        case WaitPID:
+        case WaitTimer:
+        case EnterSleep:
+        case Schedule:
+        case ResumeSleep:
+        case SwitchSleep:
+        case WaitAddress:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+API::Result SystemCallEnterHandler(SystemCallRing *ring)
+{
+    API *api = Kernel::instance->getAPI();
+    API::Result result = API::Success;
+    Size count = 0;
+
+    DEBUG("head = " << ring->submitHead << " tail = " << ring->submitTail);
+
+    while (ring->submitHead != ring->submitTail &&
+           ring->completeTail - ring->completeHead < SYSTEMCALL_RING_SIZE)
+    {
+        const SystemCallEntry *entry = &ring->submit[ring->submitHead % SYSTEMCALL_RING_SIZE];
+        SystemCallCompletion *done = &ring->complete[ring->completeTail % SYSTEMCALL_RING_SIZE];
+
+        // Execute the system call, unless the previous linked entry failed
+        if (result < 0)
+            result = API::Cancelled;
+        else if (isScheduling(entry))
+            result = API::InvalidArgument;
+        else
+            result = api->invoke((API::Number) entry->number,
+                                 entry->args[0], entry->args[1], entry->args[2],
+                                 entry->args[3], entry->args[4]);
+        done->userData = entry->userData;
+        done->result   = result;
+
+        // Only failures of linked entries affect the next entry
+        if (!(entry->flags & SystemCallLinked))
+            result = API::Success;
+
+        ring->submitHead++;
+        ring->completeTail++;
+        count++;
+    }
+    return count;
+}
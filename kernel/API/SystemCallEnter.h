@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __API_SYSTEMCALLENTER_H
+#define __API_SYSTEMCALLENTER_H
+
+#include <FreeNOS/System.h>
+#include <Types.h>
+
+/**
+ * @addtogroup kernel
+ * @{
+ *
+ * @addtogroup kernelapi
+ * @{
+ */
+
+/** Number of entries in the submission and completion queues. Must be a power of two. */
+#define SYSTEMCALL_RING_SIZE 64
+
+/**
+ * Flags for a SystemCallEntry.
+ */
+typedef enum SystemCallFlags
+{
+    /** Cancel the next entry if this entry fails */
+    SystemCallLinked = (1 << 0)
+}
+SystemCallFlags;
+
+/**
+ * System call submitted to the kernel.
+ */
+typedef struct SystemCallEntry
+{
+    /** API::Number of the system call */
+    u32 number;
+
+    /** Bitwise combination of SystemCallFlags */
+    u32 flags;
+
+    /** Arguments of the system call */
+    ulong args[5];
+
+    /** Copied unmodified to the SystemCallCompletion */
+    u32 userData;
+}
+SystemCallEntry;
+
+/**
+ * Result of a system call executed by the kernel.
+ */
+typedef struct SystemCallCompletion
+{
+    /** Copied from the SystemCallEntry */
+    u32 userData;
+
+    /** Return value of the system call or API::Cancelled */
+    API::Result result;
+}
+SystemCallCompletion;
+
+/**
+ * Submission and completion queues for batched system calls.
+ *
+ * The program adds entries at submitTail and consumes results at completeHead.
+ * The kernel consumes entries at submitHead and adds results at completeTail.
+ * All positions are free running counters, taken modulo SYSTEMCALL_RING_SIZE.
+ */
+typedef struct SystemCallRing
+{
+    /** Next entry to be executed by the kernel */
+    u32 submitHead;
+
+    /** Next free entry for the program */
+    u32 submitTail;
+
+    /** Next result to be consumed by the program */
+    u32 completeHead;
+
+    /** Next free result for the kernel */
+    u32 completeTail;
+
+    /** Submission queue */
+    SystemCallEntry submit[SYSTEMCALL_RING_SIZE];
+
+    /** Completion queue */
+    SystemCallCompletion complete[SYSTEMCALL_RING_SIZE];
+}
+SystemCallRing;
+
+/**
+ * Prototype for user applications. Executes all submitted system calls in one kernel entry.
+ *
+ * Operations which switch to another process, such as EnterSleep or WaitPID,
+ * are not allowed in a batch and complete with API::InvalidArgument.
+ *
+ * @param ring Submission and completion queues.
+ *
+ * @return Number of system calls executed on success and API::ErrorCode on failure.
+ */
+inline API::Result SystemCallEnter(SystemCallRing *ring)
+{
+    return trapKernel1(API::SystemCallEnterNumber, (Address) ring);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __KERNEL__
+
+/**
+ * @addtogroup kernelapi_handler
+ * @{
+ */
+
+/**
+ * Kernel handler prototype. Executes a batch of system calls.
+ *
+ * @param ring Submission and completion queues.
+ *
+ * @return Number of system calls executed.
+ */
+extern API::Result SystemCallEnterHandler(SystemCallRing *ring);
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL__ */
+
+/**
+ * @}
+ */
+
+#endif /* __API_SYSTEMCALLENTER_H */
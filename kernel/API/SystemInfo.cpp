@@ -19,6 +19,7 @@
 #include <FreeNOS/Config.h>
 #include <FreeNOS/Kernel.h>
 #include <SplitAllocator.h>
+#include <FreeNOS/KernelHeap.h>
 #include <CoreInfo.h>
 
 API::Result SystemInfoHandler(SystemInformation *info)
@@ -32,13 +33,18 @@ API::Result SystemInfoHandler(SystemInformation *info)
     info->version          = VERSIONCODE;
     info->memorySize       = memory->size();
     info->memoryAvail      = memory->available();
+    info->memoryZeroed     = memory->getZeroPool();
     info->coreId           = core->coreId;
+    info->coreCount        = Kernel::instance->getCoreCount();
 
     info->bootImageAddress = core->bootImageAddress;
     info->bootImageSize    = core->bootImageSize;
     info->timerCounter     = core->timerCounter;
+    info->timerIrq         = Kernel::instance->getTimerIrq();
     info->coreChannelAddress = core->coreChannelAddress;
     info->coreChannelSize    = core->coreChannelSize;
+    info->cacheCount = Kernel::instance->getHeap()->getCacheInfo(info->caches,
+                                                                KERNELHEAP_CACHES_MAX);
 
     MemoryBlock::copy(info->cmdline, coreInfo.kernelCommand, 64);
     return API::Success;
@@ -21,6 +21,7 @@
 #include <FreeNOS/System.h>
 #include <FreeNOS/Config.h>
 #include <FreeNOS/Kernel.h>
+#include <FreeNOS/KernelHeap.h>
 
 struct SystemInformation;
 
@@ -93,9 +94,15 @@ typedef struct SystemInformation
     /** Total and available memory in bytes. */
     Size memorySize, memoryAvail;
 
+    /** Number of available pages which are already cleared. */
+    Size memoryZeroed;
+
     /** Core Identifier */
     uint coreId;
 
+    /** Number of cores which run this kernel. */
+    uint coreCount;
+
     /** BootImage physical address */
     Address bootImageAddress;
 
@@ -107,6 +114,15 @@ typedef struct SystemInformation
 
     /** Timer counter */
     uint timerCounter;
+
+    /** Interrupt number of the kernel timer, for use with WatchIRQ. */
+    uint timerIrq;
+
+    /** Number of kernel heap caches. */
+    Size cacheCount;
+
+    /** Statistics of the kernel heap caches. */
+    SlabCacheInfo caches[KERNELHEAP_CACHES_MAX];
 }
 SystemInformation;
 
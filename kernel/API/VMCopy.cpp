@@ -41,6 +41,10 @@ API::Result VMCopyHandler(ProcessID procID, API::Operation how, Address ours,
     // Keep on going until all memory is processed
     while (total < sz)
     {
+        // Writes through the kernel mapping below bypass copy-on-write
+        if (how == API::Write && Kernel::instance->copyOnWrite(remote, theirs) == Kernel::ProcessError)
+            return API::OutOfMemory;
+
         // Update variables
         if (how == API::ReadPhys)
             paddr = theirs & PAGEMASK;
@@ -17,6 +17,7 @@
 
 #include <FreeNOS/System.h>
 #include <SplitAllocator.h>
+#include <MemoryBlock.h>
 #include "VMCtl.h"
 #include "ProcessID.h"
 
@@ -48,13 +49,44 @@ API::Result VMCtlHandler(ProcessID procID, MemoryOperation op, Memory::Range *ra
             break;
 
         case Map:
+        case MapZero: {
+            bool cleared = false;
+
             if (!range->virt)
             {
                 mem->findFree(range->size, MemoryMap::UserPrivate, &range->virt);
                 range->virt += range->phys & ~PAGEMASK;
             }
+            // New pages for MapZero preferably come cleared from the zero pool
+            if (op == MapZero && !range->phys &&
+                Kernel::instance->getAllocator()->allocateZero(range->size, &range->phys) == Allocator::Success)
+                cleared = true;
+
             mem->mapRange(range);
+
+            // Copy-on-write pages of the boot image are shared with other processes
+            if (op == Map && (range->access & Memory::CopyOnWrite))
+                Kernel::instance->shareBootImage(range->phys, range->size);
+
+            // Clear the pages through a temporary kernel mapping
+            if (op == MapZero && !cleared)
+            {
+                MemoryContext *local = procs->current()->getMemoryContext();
+                Address paddr, vaddr;
+
+                for (Size i = 0; i < range->size; i += PAGESIZE)
+                {
+                    if (mem->lookup((range->virt & PAGEMASK) + i, &paddr) != MemoryContext::Success ||
+                        local->findFree(PAGESIZE, MemoryMap::KernelPrivate, &vaddr) != MemoryContext::Success)
+                        return API::AccessViolation;
+
+                    local->map(vaddr, paddr & PAGEMASK, Memory::Readable | Memory::Writable);
+                    zero_page(vaddr);
+                    local->unmap(vaddr);
+                }
+            }
             break;
+        }
 
         case UnMap:
             mem->unmapRange(range);
@@ -79,6 +111,11 @@ API::Result VMCtlHandler(ProcessID procID, MemoryOperation op, Memory::Range *ra
             break;
         }
 
+        case ReclaimBootImage:
+            if (Kernel::instance->reclaimBootImage() != Kernel::Success)
+                return API::IOError;
+            break;
+
         case ReserveMem:
             for (uint i = 0; i < range->size; i+=PAGESIZE)
             {
@@ -40,7 +40,9 @@ typedef enum MemoryOperation
     Access,
     ReserveMem,
     AddMem,
-    CacheClean
+    CacheClean,
+    MapZero,
+    ReclaimBootImage
 }
 MemoryOperation;
 
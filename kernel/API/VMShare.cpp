@@ -24,7 +24,7 @@
 API::Result VMShareHandler(ProcessID procID, API::Operation op, ProcessShares::MemoryShare *share)
 {
     ProcessManager *procs = Kernel::instance->getProcessManager();
-    Process *proc = ZERO;
+    Process *proc = ZERO, *peer = ZERO;
     Error ret = API::Success;
 
     DEBUG("");
@@ -55,6 +55,24 @@ API::Result VMShareHandler(ProcessID procID, API::Operation op, ProcessShares::M
             break;
         }
 
+        case API::Connect:
+        {
+            // Only the parent may connect a child to another process
+            if (proc->getParent() != procs->current()->getID() || share->pid == procID)
+                return API::AccessViolation;
+
+            if (!(peer = procs->get(share->pid)))
+                return API::NotFound;
+
+            switch (proc->getShares().createShare(peer->getShares(), share))
+            {
+                case ProcessShares::Success: return API::Success;
+                case ProcessShares::AlreadyExists: return API::AlreadyExists;
+                default: return API::IOError;
+            }
+            break;
+        }
+
         case API::Read:
             if (procs->current()->getShares().readShare(share) != ProcessShares::Success)
             {
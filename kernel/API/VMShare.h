@@ -31,6 +31,10 @@
 /**
  * Prototype for user applications. Creates and removes shared virtual memory mappings.
  *
+ * With API::Connect, the share is created between the child process pid and the
+ * process share->pid, as if the child had called API::Create itself. This lets a
+ * parent pre-establish channels for a child before it starts to run.
+ *
  * @param op Determines which operation to perform.
  * @param pid Remote process.
  * @param parameter Parameter for the operation.
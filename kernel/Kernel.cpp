@@ -17,21 +17,25 @@
 
 #include <FreeNOS/System.h>
 #include <Log.h>
-#include <ListIterator.h>
 #include <SplitAllocator.h>
 #include <BubbleAllocator.h>
 #include <PoolAllocator.h>
 #include <IntController.h>
 #include <BootImage.h>
 #include <CoreInfo.h>
+#include <MemoryChannel.h>
 #include "Kernel.h"
+#include "KernelHeap.h"
 #include "Memory.h"
 #include "Process.h"
 #include "ProcessManager.h"
+#include "ProcessShares.h"
 #include "Scheduler.h"
+#include "SystemClock.h"
+#include "TimerWheel.h"
 
 Kernel::Kernel(CoreInfo *info)
-    : Singleton<Kernel>(this), m_interrupts(256)
+    : Singleton<Kernel>(this)
 {
     // Output log banners
     if (Log::instance)
@@ -53,6 +57,11 @@ Kernel::Kernel(CoreInfo *info)
     m_coreInfo   = info;
     m_intControl = ZERO;
     m_timer      = ZERO;
+    m_timerIrq   = 0;
+    m_timerWheel = new TimerWheel();
+    m_lockOwner  = MAX_CORES;
+    m_lockDepth  = 0;
+    m_coreCount  = 1;
 
     // Mark kernel memory used (first 4MB in phys memory)
     for (Size i = 0; i < info->kernel.size; i += PAGESIZE)
@@ -62,6 +71,12 @@ Kernel::Kernel(CoreInfo *info)
     for (Size i = 0; i < m_coreInfo->bootImageSize; i += PAGESIZE)
         m_alloc->allocate(m_coreInfo->bootImageAddress + i);
 
+    // Program segments are shared with the BootImage until written
+    m_copyOnWrite      = false;
+    m_bootImageMaps    = new u16[(m_coreInfo->bootImageSize / PAGESIZE) + 1];
+    m_bootImageReclaim = false;
+    MemoryBlock::set(m_bootImageMaps, 0, ((m_coreInfo->bootImageSize / PAGESIZE) + 1) * sizeof(u16));
+
     // Mark heap memory used
     for (Size i = 0; i < m_coreInfo->heapSize; i += PAGESIZE)
         m_alloc->allocate(m_coreInfo->heapAddress + i);
@@ -70,8 +85,23 @@ Kernel::Kernel(CoreInfo *info)
     for (Size i = 0; i < m_coreInfo->coreChannelSize; i += PAGESIZE)
         m_alloc->allocate(m_coreInfo->coreChannelAddress + i);
 
-    // Clear interrupts table
-    m_interrupts.fill(ZERO);
+    // Grow the heap from physical memory, with caches for frequently allocated objects
+    m_heap = new KernelHeap(m_alloc, m_coreInfo->heapAddress, m_coreInfo->heapSize);
+    m_heap->createCache("Process", sizeof(Arch::Process));
+    m_heap->createCache("MemoryShare", sizeof(ProcessShares::MemoryShare));
+    m_heap->createCache("MemoryChannel", sizeof(MemoryChannel));
+    m_heap->createCache("ListNode", sizeof(List<HashTable<ProcessShares::ShareKey,
+                                                          ProcessShares::MemoryShare *>::Bucket>::Node));
+    Allocator::setDefault(m_heap);
+
+    // Allocate the clock page
+    m_alloc->allocateZero(PAGESIZE, &m_clockAddress);
+    m_clock = (SystemClock *) m_alloc->toVirtual(m_clockAddress);
+    m_clockBaseTicks   = 0;
+    m_clockBaseCounter = 0;
+
+    // Allocate the mounts page
+    m_alloc->allocateZero(PAGESIZE, &m_mountsAddress);
 }
 
 Error Kernel::heap(Address base, Size size)
@@ -80,7 +110,8 @@ Error Kernel::heap(Address base, Size size)
     Size meta = sizeof(BubbleAllocator) + sizeof(PoolAllocator);
 
     // Clear the heap first
-    MemoryBlock::set((void *) base, 0, size);
+    for (Size i = 0; i < size; i += PAGESIZE)
+        zero_page(base + i);
 
     // Setup the dynamic memory heap
     bubble = new (base) BubbleAllocator(base + meta, size - meta);
@@ -97,6 +128,11 @@ SplitAllocator * Kernel::getAllocator()
     return m_alloc;
 }
 
+KernelHeap * Kernel::getHeap()
+{
+    return m_heap;
+}
+
 ProcessManager * Kernel::getProcessManager()
 {
     return m_procs;
@@ -122,6 +158,131 @@ Timer * Kernel::getTimer()
     return m_timer;
 }
 
+u32 Kernel::getTimerIrq() const
+{
+    return m_timerIrq;
+}
+
+TimerWheel * Kernel::getTimerWheel()
+{
+    return m_timerWheel;
+}
+
+Address Kernel::getClockAddress() const
+{
+    return m_clockAddress;
+}
+
+Address Kernel::getMountsAddress() const
+{
+    return m_mountsAddress;
+}
+
+Size Kernel::getCoreCount() const
+{
+    return m_coreCount;
+}
+
+void Kernel::lock()
+{
+    Size core = core_index();
+
+    if (m_lockOwner == core)
+        m_lockDepth++;
+    else
+    {
+        m_lock.lock();
+        m_lockOwner = core;
+        m_lockDepth = 1;
+    }
+}
+
+void Kernel::unlock()
+{
+    if (--m_lockDepth == 0)
+    {
+        m_lockOwner = MAX_CORES;
+        m_lock.unlock();
+    }
+}
+
+void Kernel::unwindLock()
+{
+    assert(m_lockOwner == core_index());
+
+    while (m_lockDepth > 1)
+        unlock();
+}
+
+void Kernel::rescheduleCore(Size core)
+{
+}
+
+void Kernel::updateClock()
+{
+    Timer::Info info;
+    Arch::Cache cache;
+    u64 counter = timestamp();
+
+    if (!m_timer || m_timer->getCurrent(&info) != Timer::Success || !info.frequency)
+        return;
+
+    // Mark the page inconsistent while updating
+    m_clock->sequence++;
+    asm volatile ("" ::: "memory");
+
+    m_clock->frequency       = info.frequency;
+    m_clock->ticks           = info.ticks;
+    m_clock->tickNanoseconds = 1000000000 / info.frequency;
+    m_clock->nanoseconds     = (u64) info.ticks * m_clock->tickNanoseconds;
+    m_clock->counter         = counter;
+
+    // Calibrate the counter against the timer during the first second
+    if (counter && !m_clock->counterFrequency)
+    {
+        if (!m_clockBaseCounter)
+        {
+            m_clockBaseTicks   = info.ticks;
+            m_clockBaseCounter = counter;
+        }
+        else if (info.ticks - m_clockBaseTicks >= info.frequency)
+        {
+            m_clock->counterFrequency  = ((counter - m_clockBaseCounter) * info.frequency) /
+                                          (info.ticks - m_clockBaseTicks);
+            m_clock->counterMultiplier = ((u64) 1000000000 << SYSTEMCLOCK_SHIFT) /
+                                          m_clock->counterFrequency;
+        }
+    }
+    asm volatile ("" ::: "memory");
+    m_clock->sequence++;
+
+    // The clock page is mapped separately in low memory
+    cache.cleanData((Address) m_clock);
+}
+
+void Kernel::expireTimers()
+{
+    Timer::Info info;
+
+    if (m_timer && m_timer->getCurrent(&info) == Timer::Success)
+        m_timerWheel->advance(info.ticks);
+}
+
+void Kernel::setTime(u32 seconds)
+{
+    Arch::Cache cache;
+
+    // Mark the page inconsistent while updating
+    m_clock->sequence++;
+    asm volatile ("" ::: "memory");
+
+    m_clock->bootTime = seconds - (u32) (m_clock->nanoseconds / 1000000000);
+
+    asm volatile ("" ::: "memory");
+    m_clock->sequence++;
+    cache.cleanData((Address) m_clock);
+}
+
 void Kernel::enableIRQ(u32 irq, bool enabled)
 {
     if (m_intControl)
@@ -133,20 +294,46 @@ void Kernel::enableIRQ(u32 irq, bool enabled)
     }
 }
 
-void Kernel::hookIntVector(u32 vec, InterruptHandler h, ulong p)
+Kernel::Result Kernel::hookIntVector(u32 vec, InterruptHandler h, ulong p)
 {
-    InterruptHook hook(h, p);
+    if (vec >= INTERRUPT_VECTORS)
+        return InvalidVector;
 
-    // Insert into interrupts; create List if neccesary
-    if (!m_interrupts[vec])
+    // Append to the first free hook, unless already hooked
+    for (Size i = 0; i < INTERRUPT_HOOKS_MAX; i++)
     {
-        m_interrupts.insert(vec, new List<InterruptHook *>());
+        InterruptHook *hook = &m_interrupts[vec][i];
+
+        if (!hook->handler)
+        {
+            hook->handler = h;
+            hook->param   = p;
+            return Success;
+        }
+        else if (hook->handler == h && hook->param == p)
+            return Success;
     }
-    // Just append it. */
-    if (!m_interrupts[vec]->contains(&hook))
+    return HookLimitReached;
+}
+
+Kernel::Result Kernel::unhookIntVector(u32 vec, InterruptHandler h, ulong p)
+{
+    if (vec >= INTERRUPT_VECTORS)
+        return InvalidVector;
+
+    for (Size i = 0; i < INTERRUPT_HOOKS_MAX && m_interrupts[vec][i].handler; i++)
     {
-        m_interrupts[vec]->append(new InterruptHook(h, p));
+        if (m_interrupts[vec][i].handler == h && m_interrupts[vec][i].param == p)
+        {
+            // Keep the used hooks in front
+            for (; i < INTERRUPT_HOOKS_MAX - 1; i++)
+                m_interrupts[vec][i] = m_interrupts[vec][i + 1];
+
+            m_interrupts[vec][INTERRUPT_HOOKS_MAX - 1] = InterruptHook();
+            return Success;
+        }
     }
+    return NotFound;
 }
 
 void Kernel::executeIntVector(u32 vec, CPUState *state)
@@ -156,18 +343,14 @@ void Kernel::executeIntVector(u32 vec, CPUState *state)
     // interrupt loops in case the kernel cannot clear the IRQ immediately.
     enableIRQ(vec, false);
 
-    // Fetch the list of interrupt hooks (for this vector)
-    List<InterruptHook *> *lst = m_interrupts[vec];
-
-    // Does at least one handler exist?
-    if (!lst)
+    if (vec >= INTERRUPT_VECTORS)
         return;
 
-    // Execute them all
-    for (ListIterator<InterruptHook *> i(lst); i.hasCurrent(); i++)
-    {
-        i.current()->handler(state, i.current()->param);
-    }
+    // Execute all hooks for this vector
+    const InterruptHook *hooks = m_interrupts[vec];
+
+    for (Size i = 0; i < INTERRUPT_HOOKS_MAX && hooks[i].handler; i++)
+        hooks[i].handler(state, hooks[i].param);
 }
 
 Kernel::Result Kernel::loadBootImage()
@@ -186,6 +369,9 @@ Kernel::Result Kernel::loadBootImage()
         for (Size i = 0; i < image->symbolTableCount; i++)
             loadBootProcess(image, m_coreInfo->bootImageAddress, i);
 
+        if (m_copyOnWrite)
+            NOTICE("bootimage: " << (sharedBootImage() * (PAGESIZE / 1024)) <<
+                   " KB of program segments shared copy-on-write");
         return Success;
     }
     ERROR("invalid boot image signature: " << (unsigned) image->magic[0] << ", " << (unsigned) image->magic[1]);
@@ -217,32 +403,39 @@ Kernel::Result Kernel::loadBootProcess(BootImage *image, Address imagePAddr, Siz
         FATAL("failed to create boot program: " << program->name);
         return ProcessError;
     }
+    proc->setSystem(true);
     proc->setState(Process::Ready);
 
     // Obtain process memory
     MemoryContext *mem = proc->getMemoryContext();
 
-    // Map program segment into it's virtual memory
+    // Map program segments straight from the boot image. Pages
+    // are copied on the first write, if supported by the architecture.
+    Memory::Access access = Memory::User | Memory::Readable | Memory::Executable;
+    if (m_copyOnWrite)
+        access |= Memory::CopyOnWrite;
+    else
+        access |= Memory::Writable;
+
     for (Size i = 0; i < program->segmentsCount; i++)
     {
         for (Size j = 0; j < segment[i].size; j += PAGESIZE)
         {
             mem->map(segment[i].virtualAddress + j,
                      imagePAddr + segment[i].offset + j,
-                     Memory::User     |
-                     Memory::Readable |
-                     Memory::Writable |
-                     Memory::Executable);
+                     access);
+
+            if (m_copyOnWrite)
+                m_bootImageMaps[(segment[i].offset + j) / PAGESIZE]++;
         }
     }
     // Map program arguments into the process
     argRange.access = Memory::User | Memory::Readable | Memory::Writable;
-    m_alloc->allocateLow(argRange.size, &argRange.phys);
+    m_alloc->allocateZero(argRange.size, &argRange.phys);
     mem->mapRange(&argRange);
 
     // Copy program arguments
     vaddr = (char *) m_alloc->toVirtual(argRange.phys);
-    MemoryBlock::set(vaddr, 0, argRange.size);
     MemoryBlock::copy(vaddr, program->name, BOOTIMAGE_NAMELEN);
 
     // Done
@@ -250,15 +443,113 @@ Kernel::Result Kernel::loadBootProcess(BootImage *image, Address imagePAddr, Siz
     return Success;
 }
 
+Kernel::Result Kernel::copyOnWrite(MemoryContext *mem, Address virt)
+{
+    Address page = virt & PAGEMASK, source, copy;
+    Memory::Access access;
+
+    // Only pages which are mapped copy-on-write
+    if (mem->access(page, &access) != MemoryContext::Success ||
+        !(access & Memory::CopyOnWrite) ||
+        mem->lookup(page, &source) != MemoryContext::Success)
+        return NotFound;
+
+    // Copy into a private page
+    source &= PAGEMASK;
+    if (m_alloc->allocateLow(PAGESIZE, &copy) != Allocator::Success)
+        return ProcessError;
+
+    MemoryBlock::copy(m_alloc->toVirtual(copy), m_alloc->toVirtual(source), PAGESIZE);
+
+    // Replace the mapping with a writable one
+    mem->unmap(page);
+    mem->map(page, copy, (Memory::Access) ((access & ~Memory::CopyOnWrite) | Memory::Writable));
+
+    // Release the boot image page once no other process maps it,
+    // such as the pages of the shared library
+    if (source >= m_coreInfo->bootImageAddress &&
+        source <  m_coreInfo->bootImageAddress + m_coreInfo->bootImageSize)
+    {
+        u16 *maps = &m_bootImageMaps[(source - m_coreInfo->bootImageAddress) / PAGESIZE];
+
+        if (*maps && --(*maps) == 0 && m_bootImageReclaim)
+            m_alloc->release(source);
+    }
+    return Success;
+}
+
+void Kernel::shareBootImage(Address phys, Size size)
+{
+    for (Address page = phys & PAGEMASK; page < phys + size; page += PAGESIZE)
+    {
+        if (page >= m_coreInfo->bootImageAddress &&
+            page <  m_coreInfo->bootImageAddress + m_coreInfo->bootImageSize)
+        {
+            m_bootImageMaps[(page - m_coreInfo->bootImageAddress) / PAGESIZE]++;
+        }
+    }
+}
+
+Size Kernel::sharedBootImage() const
+{
+    Size count = 0;
+
+    for (Size i = 0; i < (m_coreInfo->bootImageSize / PAGESIZE) + 1; i++)
+        if (m_bootImageMaps[i])
+            count++;
+
+    return count;
+}
+
+Kernel::Result Kernel::reclaimBootImage()
+{
+    BootImage *image = (BootImage *) (m_alloc->toVirtual(m_coreInfo->bootImageAddress));
+    BootSymbol *program;
+    BootSegment *segment;
+    Size reclaimed = 0;
+
+    if (m_bootImageReclaim || !m_copyOnWrite)
+        return Success;
+
+    m_bootImageReclaim = true;
+
+    // Release program pages which were already copied on write
+    for (Size i = 0; i < image->symbolTableCount; i++)
+    {
+        program = &((BootSymbol *) ((Address) image + image->symbolTableOffset))[i];
+        segment = &((BootSegment *) ((Address) image + image->segmentsTableOffset))[program->segmentsOffset];
+
+        if (program->type != BootProgram)
+            continue;
+
+        for (Size j = 0; j < program->segmentsCount; j++)
+        {
+            for (Size k = 0; k < segment[j].size; k += PAGESIZE)
+            {
+                if (!m_bootImageMaps[(segment[j].offset + k) / PAGESIZE])
+                {
+                    m_alloc->release(m_coreInfo->bootImageAddress + segment[j].offset + k);
+                    reclaimed++;
+                }
+            }
+        }
+    }
+    NOTICE("bootimage: reclaimed " << (reclaimed * (PAGESIZE / 1024)) << " KB, " <<
+           (sharedBootImage() * (PAGESIZE / 1024)) << " KB still shared");
+    return Success;
+}
+
 int Kernel::run()
 {
     NOTICE("");
 
+    // Initialize the clock page
+    updateClock();
+
     // Load boot image programs
     loadBootImage();
 
     // Start the scheduler
-    m_procs->getScheduler()->setTimer(m_timer);
     m_procs->schedule();
 
     // Never actually returns.
@@ -24,21 +24,32 @@
 #include <BootImage.h>
 #include <Memory.h>
 #include <CoreInfo.h>
+#include <TicketLock.h>
 #include "Process.h"
 #include "ProcessManager.h"
 
 /** Forward declarations. */
 class API;
 class SplitAllocator;
+class KernelHeap;
 class IntController;
 class Timer;
 struct CPUState;
+struct SystemClock;
+class TimerWheel;
+class MemoryContext;
 
 /**
  * @addtogroup kernel
  * @{
  */
 
+/** Number of interrupt vectors supported by the kernel. */
+#define INTERRUPT_VECTORS 256
+
+/** Maximum number of hooks per interrupt vector. */
+#define INTERRUPT_HOOKS_MAX 4
+
 /**
  * Function which is called when the CPU is interrupted.
  *
@@ -52,6 +63,13 @@ typedef void InterruptHandler(struct CPUState *state, ulong param);
  */
 typedef struct InterruptHook
 {
+    /**
+     * Default constructor.
+     */
+    InterruptHook() : handler(ZERO), param(0)
+    {
+    }
+
     /**
      * Constructor function.
      *
@@ -83,6 +101,11 @@ InterruptHook;
 
 /**
  * FreeNOS kernel implementation.
+ *
+ * The kernel lock is a big kernel lock: one core at a time runs the kernel,
+ * from interrupt entry until the next Process continues. The Scheduler run
+ * queues, WaitTable, TimerWheel, ProcessShares and KernelHeap have no locks
+ * of their own and rely on it.
  */
 class Kernel : public Singleton<Kernel>
 {
@@ -95,7 +118,10 @@ class Kernel : public Singleton<Kernel>
     {
         Success,
         InvalidBootImage,
-        ProcessError
+        ProcessError,
+        InvalidVector,
+        HookLimitReached,
+        NotFound
     };
 
     /**
@@ -108,10 +134,11 @@ class Kernel : public Singleton<Kernel>
     /**
      * Initialize heap.
      *
-     * This function sets up the kernel heap for
+     * This function sets up the boot heap for
      * dynamic memory allocation with new() and delete()
      * operators. It must be called before any object
-     * is created using new().
+     * is created using new(). The Kernel replaces it with
+     * the growable KernelHeap once physical memory is available.
      *
      * @return Zero on success or error code on failure.
      */
@@ -124,6 +151,13 @@ class Kernel : public Singleton<Kernel>
      */
     SplitAllocator * getAllocator();
 
+    /**
+     * Get kernel heap.
+     *
+     * @return KernelHeap object pointer.
+     */
+    KernelHeap * getHeap();
+
     /**
      * Get process manager.
      *
@@ -159,6 +193,92 @@ class Kernel : public Singleton<Kernel>
      */
     Timer * getTimer();
 
+    /**
+     * Get the interrupt number of the Timer.
+     *
+     * @return Interrupt number as accepted by WatchIRQ.
+     */
+    u32 getTimerIrq() const;
+
+    /**
+     * Get the TimerWheel with all Process timers.
+     *
+     * @return TimerWheel object pointer
+     */
+    TimerWheel * getTimerWheel();
+
+    /**
+     * Get clock page.
+     *
+     * @return Physical address of the SystemClock page.
+     */
+    Address getClockAddress() const;
+
+    /**
+     * Get mounts page.
+     *
+     * @return Physical address of the filesystem mounts page.
+     */
+    Address getMountsAddress() const;
+
+    /**
+     * Get the number of cores which execute the kernel.
+     *
+     * @return Number of cores.
+     */
+    Size getCoreCount() const;
+
+    /**
+     * Acquire the kernel lock.
+     *
+     * Serializes the whole kernel between cores. The owning core may
+     * acquire the lock again, for example on an exception.
+     */
+    virtual void lock();
+
+    /**
+     * Release the kernel lock.
+     *
+     * Releases the lock once for each time it was acquired.
+     */
+    virtual void unlock();
+
+    /**
+     * Release the kernel lock for interrupted code which never continues.
+     *
+     * Releases each acquisition except the one of the current interrupt,
+     * which is released when the next Process continues.
+     */
+    void unwindLock();
+
+    /**
+     * Let another core select a new Process to run.
+     *
+     * @param core Core index.
+     */
+    virtual void rescheduleCore(Size core);
+
+    /**
+     * Update the clock page.
+     *
+     * Must be called on each timer interrupt, after the Timer is ticked.
+     */
+    void updateClock();
+
+    /**
+     * Expire Process timers.
+     *
+     * Must be called on each timer interrupt, after the Timer is ticked.
+     */
+    void expireTimers();
+
+    /**
+     * Set the wall-clock time.
+     *
+     * @param seconds Current time in seconds since the epoch.
+     */
+    void setTime(u32 seconds);
+
     /**
      * Execute the kernel.
      */
@@ -178,8 +298,21 @@ class Kernel : public Singleton<Kernel>
      * @param vec Interrupt vector to hook on.
      * @param h Handler function.
      * @param p Parameter to pass to the handler function.
+     *
+     * @return Result code.
+     */
+    virtual Result hookIntVector(u32 vec, InterruptHandler h, ulong p);
+
+    /**
+     * Removes a function from an hardware interrupt.
+     *
+     * @param vec Interrupt vector to unhook from.
+     * @param h Handler function.
+     * @param p Parameter of the handler function.
+     *
+     * @return Result code.
      */
-    virtual void hookIntVector(u32 vec, InterruptHandler h, ulong p);
+    virtual Result unhookIntVector(u32 vec, InterruptHandler h, ulong p);
 
     /**
      * Execute an interrupt handler.
@@ -194,6 +327,40 @@ class Kernel : public Singleton<Kernel>
      */
     virtual Result loadBootImage();
 
+    /**
+     * Resolve a write to a copy-on-write page.
+     *
+     * Gives the page a private, writable copy. Boot image pages
+     * which are no longer mapped are released if reclaimBootImage()
+     * was called before.
+     *
+     * @param mem MemoryContext in which the write occurred.
+     * @param virt Virtual address of the write.
+     *
+     * @return Result code. NotFound if the page is not copy-on-write.
+     */
+    Result copyOnWrite(MemoryContext *mem, Address virt);
+
+    /**
+     * Count new copy-on-write mappings of boot image pages.
+     *
+     * Pages outside the boot image are ignored.
+     *
+     * @param phys Physical address of the mapped pages.
+     * @param size Number of bytes mapped.
+     */
+    void shareBootImage(Address phys, Size size);
+
+    /**
+     * Reclaim boot image memory which is no longer needed.
+     *
+     * Releases the pages of boot program segments which were copied
+     * on write. The boot image must not be copied to other cores afterwards.
+     *
+     * @return Result code.
+     */
+    Result reclaimBootImage();
+
   private:
 
     /**
@@ -205,11 +372,21 @@ class Kernel : public Singleton<Kernel>
      */
     virtual Result loadBootProcess(BootImage *image, Address imagePAddr, Size index);
 
+    /**
+     * Count the boot image pages which are mapped copy-on-write.
+     *
+     * @return Number of pages.
+     */
+    Size sharedBootImage() const;
+
   protected:
 
     /** Physical memory allocator */
     SplitAllocator *m_alloc;
 
+    /** Kernel heap with object caches */
+    KernelHeap *m_heap;
+
     /** Process Manager */
     ProcessManager *m_procs;
 
@@ -219,14 +396,61 @@ class Kernel : public Singleton<Kernel>
     /** CoreInfo object for this core. */
     CoreInfo *m_coreInfo;
 
-    /** Interrupt handlers. */
-    Vector<List<InterruptHook *> *> m_interrupts;
+    /** Interrupt handlers per vector. Unused hooks follow the used hooks. */
+    InterruptHook m_interrupts[INTERRUPT_VECTORS][INTERRUPT_HOOKS_MAX];
 
     /** Interrupt Controller. */
     IntController *m_intControl;
 
     /** Timer device. */
     Timer *m_timer;
+
+    /** Interrupt number for the timer */
+    u32 m_timerIrq;
+
+    /** Timers armed by processes */
+    TimerWheel *m_timerWheel;
+
+    /** Clock page, mapped read-only in every Process. */
+    SystemClock *m_clock;
+
+    /** Physical address of the clock page. */
+    Address m_clockAddress;
+
+    /** Physical address of the mounts page, mapped in every Process and written by sysfs. */
+    Address m_mountsAddress;
+
+    /** Timer ticks at the start of the counter calibration. */
+    u32 m_clockBaseTicks;
+
+    /** Counter value at the start of the counter calibration. */
+    u64 m_clockBaseCounter;
+
+    /** True if the architecture resolves copy-on-write page faults. */
+    bool m_copyOnWrite;
+
+    /**
+     * Number of copy-on-write mappings of each boot image page.
+     *
+     * A boot image page may only be released once no mapping is left,
+     * because the shared library is mapped into many processes.
+     */
+    u16 *m_bootImageMaps;
+
+    /** Serializes the kernel between cores. */
+    TicketLock m_lock;
+
+    /** Core index which holds the kernel lock or MAX_CORES if none. */
+    Size m_lockOwner;
+
+    /** Number of times the owning core acquired the kernel lock. */
+    Size m_lockDepth;
+
+    /** Number of cores which execute the kernel. */
+    Size m_coreCount;
+
+    /** True after reclaimBootImage() was called. */
+    bool m_bootImageReclaim;
 };
 
 /**
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <SplitAllocator.h>
+#include <MemoryBlock.h>
+#include "KernelHeap.h"
+
+/** Number of generic caches. */
+#define KERNELHEAP_GENERIC (KERNELHEAP_MAX_POWER - KERNELHEAP_MIN_POWER + 1)
+
+/** Names of the generic caches. */
+static const char *genericNames[KERNELHEAP_GENERIC] =
+{
+    "size-16", "size-32", "size-64", "size-128",
+    "size-256", "size-512", "size-1024", "size-2048"
+};
+
+KernelHeap::KernelHeap(SplitAllocator *alloc, Address bootBase, Size bootSize)
+    : Allocator()
+    , m_alloc(alloc)
+    , m_boot(Allocator::getDefault())
+    , m_bootBase(bootBase)
+    , m_bootSize(bootSize)
+    , m_count(0)
+    , m_largePages(0)
+{
+    MemoryBlock::set(m_caches, 0, sizeof(m_caches));
+
+    for (Size i = 0; i < KERNELHEAP_GENERIC; i++)
+        createCache(genericNames[i], 1 << (KERNELHEAP_MIN_POWER + i));
+}
+
+Allocator::Result KernelHeap::createCache(const char *name, Size objectSize)
+{
+    if (m_count == KERNELHEAP_CACHES_MAX)
+        return OutOfMemory;
+
+    if (!objectSize || objectSize > (1 << KERNELHEAP_MAX_POWER))
+        return InvalidSize;
+
+    if (!(m_caches[m_count] = new SlabCache(name, objectSize, m_alloc)))
+        return OutOfMemory;
+
+    m_count++;
+    return Success;
+}
+
+Size KernelHeap::getCacheInfo(SlabCacheInfo *info, Size count) const
+{
+    Size i;
+
+    for (i = 0; i < count && i < m_count; i++)
+        MemoryBlock::copy(&info[i], &m_caches[i]->getInfo(), sizeof(SlabCacheInfo));
+
+    return i;
+}
+
+Size KernelHeap::size() const
+{
+    Size total = m_largePages * PAGESIZE;
+
+    for (Size i = 0; i < m_count; i++)
+        total += m_caches[i]->getInfo().slabs * SLAB_SIZE;
+
+    return total;
+}
+
+Size KernelHeap::available() const
+{
+    Size total = 0;
+
+    for (Size i = 0; i < m_count; i++)
+    {
+        const SlabCacheInfo & info = m_caches[i]->getInfo();
+        total += (info.capacity - info.objects) * info.objectSize;
+    }
+    return total;
+}
+
+Allocator::Result KernelHeap::allocate(Size *size, Address *addr, Size align)
+{
+    SlabCache *cache = find(*size);
+    Size offset = (sizeof(Slab) + MEMALIGN - 1) & ~(MEMALIGN - 1);
+    Size pages;
+    Address phys;
+    Slab *slab;
+
+    if (cache)
+    {
+        if (!(*addr = (Address) cache->allocate()))
+            return OutOfMemory;
+
+        *size = cache->getObjectSize();
+        return Success;
+    }
+
+    // Too large for a slab: take whole pages with a Slab header in front
+    pages = (*size + offset + PAGESIZE - 1) / PAGESIZE;
+
+    if (m_alloc->allocateLow(pages * PAGESIZE, &phys, SLAB_SIZE) != Success)
+    {
+        *addr = ZERO;
+        return OutOfMemory;
+    }
+    slab = (Slab *) m_alloc->toVirtual(phys);
+    slab->cache = ZERO;
+    slab->used  = pages;
+    m_largePages += pages;
+
+    *addr = (Address) slab + offset;
+    *size = (pages * PAGESIZE) - offset;
+    return Success;
+}
+
+Allocator::Result KernelHeap::release(Address addr)
+{
+    Slab *slab;
+    Address phys;
+
+    if (!addr)
+        return InvalidAddress;
+
+    // Allocated before the KernelHeap was installed
+    if (addr >= m_bootBase && addr < m_bootBase + m_bootSize)
+        return m_boot->release(addr);
+
+    slab = SlabCache::slabOf((void *) addr);
+
+    if (slab->cache)
+    {
+        slab->cache->release((void *) addr);
+        return Success;
+    }
+
+    // Large allocation
+    phys = (Address) m_alloc->toPhysical((Address) slab);
+    m_largePages -= slab->used;
+
+    for (Size i = 0; i < slab->used; i++)
+        m_alloc->release(phys + (i * PAGESIZE));
+
+    return Success;
+}
+
+SlabCache * KernelHeap::find(Size size) const
+{
+    Size rounded = (size + MEMALIGN - 1) & ~(MEMALIGN - 1);
+
+    // Named caches match on the exact object size
+    for (Size i = KERNELHEAP_GENERIC; i < m_count; i++)
+        if (m_caches[i]->getObjectSize() == rounded)
+            return m_caches[i];
+
+    // Generic cache of the next power of two
+    for (Size i = 0; i < KERNELHEAP_GENERIC; i++)
+        if (size <= m_caches[i]->getObjectSize())
+            return m_caches[i];
+
+    return ZERO;
+}
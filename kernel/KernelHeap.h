@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __KERNEL_KERNELHEAP_H
+#define __KERNEL_KERNELHEAP_H
+
+#include <Types.h>
+#include <Macros.h>
+#include <Allocator.h>
+#include "SlabCache.h"
+
+/** Forward declarations */
+class SplitAllocator;
+
+/**
+ * @addtogroup kernel
+ * @{
+ */
+
+/** Maximum number of caches in the KernelHeap. */
+#define KERNELHEAP_CACHES_MAX 16
+
+/** Power of two of the smallest generic cache. */
+#define KERNELHEAP_MIN_POWER 4
+
+/** Power of two of the largest generic cache. Larger allocations use whole pages. */
+#define KERNELHEAP_MAX_POWER 11
+
+/**
+ * Growable kernel heap.
+ *
+ * Serves kernel dynamic memory from SlabCache instances. Named caches
+ * hold objects of one exact size, such as Process and MemoryShare objects,
+ * and are searched first. Other allocations go to a generic cache of the
+ * next power of two, or directly to whole pages from the SplitAllocator
+ * when too large for a slab.
+ *
+ * Memory allocated from the boot heap before the KernelHeap was
+ * installed is released back to the boot heap.
+ */
+class KernelHeap : public Allocator
+{
+  public:
+
+    /**
+     * Constructor.
+     *
+     * Must be called with the boot heap as default Allocator,
+     * which provides the memory for the SlabCache objects.
+     *
+     * @param alloc Physical memory allocator to pull slabs from.
+     * @param bootBase Start address of the boot heap.
+     * @param bootSize Size of the boot heap in bytes.
+     */
+    KernelHeap(SplitAllocator *alloc, Address bootBase, Size bootSize);
+
+    /**
+     * Create a named cache.
+     *
+     * @param name Name of the cache.
+     * @param objectSize Size of each object in bytes.
+     *
+     * @return Result code.
+     */
+    Result createCache(const char *name, Size objectSize);
+
+    /**
+     * Get cache statistics.
+     *
+     * @param info Output array of SlabCacheInfo.
+     * @param count Maximum number of entries in the array.
+     *
+     * @return Number of entries filled.
+     */
+    Size getCacheInfo(SlabCacheInfo *info, Size count) const;
+
+    /**
+     * Get memory size.
+     *
+     * @return Size of memory in slabs and large allocations.
+     */
+    virtual Size size() const;
+
+    /**
+     * Get memory available.
+     *
+     * @return Size of memory in free objects of all caches.
+     */
+    virtual Size available() const;
+
+    /**
+     * Allocate memory.
+     *
+     * @param size Amount of memory in bytes to allocate on input.
+     *             On output, the amount of memory in bytes actually allocated.
+     * @param addr Output parameter which contains the address
+     *             allocated on success.
+     * @param align Alignment of the required memory or use ZERO for default.
+     *
+     * @return Result value.
+     */
+    virtual Result allocate(Size *size, Address *addr, Size align = ZERO);
+
+    /**
+     * Release memory.
+     *
+     * @param addr Points to memory previously returned by allocate().
+     *
+     * @return Result value.
+     *
+     * @see allocate
+     */
+    virtual Result release(Address addr);
+
+  private:
+
+    /**
+     * Find the cache for an allocation.
+     *
+     * @param size Size of the allocation in bytes.
+     *
+     * @return SlabCache pointer or ZERO if too large for a slab.
+     */
+    SlabCache * find(Size size) const;
+
+  private:
+
+    /** Physical memory allocator. */
+    SplitAllocator *m_alloc;
+
+    /** Boot heap which served allocations before the KernelHeap. */
+    Allocator *m_boot;
+
+    /** Start address of the boot heap. */
+    Address m_bootBase;
+
+    /** Size of the boot heap. */
+    Size m_bootSize;
+
+    /** Generic caches, followed by the named caches. */
+    SlabCache *m_caches[KERNELHEAP_CACHES_MAX];
+
+    /** Number of caches. */
+    Size m_count;
+
+    /** Number of pages in large allocations. */
+    Size m_largePages;
+};
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL_KERNELHEAP_H */
@@ -19,7 +19,7 @@
 #include <FreeNOS/API.h>
 #include <Index.h>
 #include <MemoryBlock.h>
-#include <MemoryChannel.h>
+#include <FixedMemoryChannel.h>
 #include <SplitAllocator.h>
 #include "Process.h"
 #include "ProcessEvent.h"
@@ -30,29 +30,58 @@ Process::Process(ProcessID id, Address entry, bool privileged, const MemoryMap &
     m_state         = Stopped;
     m_kernelStack   = 0;
     m_userStack     = 0;
+    m_userStackSlot = 0;
     m_pageDirectory = 0;
     m_parent        = 0;
     m_waitId        = 0;
+    m_threadGroup   = id;
+    m_threadData    = 0;
+    m_waitAddress   = 0;
+    m_waitNext      = ZERO;
+    m_waitPrev      = ZERO;
     m_wakeups       = 0;
+    m_cpuTime       = 0;
     m_entry         = entry;
     m_privileged    = privileged;
+    m_system        = false;
     m_memoryContext = ZERO;
-    m_kernelChannel = new MemoryChannel;
+    m_kernelChannel = new FixedMemoryChannel<ProcessEvent>;
     MemoryBlock::set(&m_sleepTimer, 0, sizeof(m_sleepTimer));
+    MemoryBlock::set(m_interrupts, 0, sizeof(m_interrupts));
+    MemoryBlock::set(m_timers, 0, sizeof(m_timers));
+    MemoryBlock::set(&m_sleepWheelTimer, 0, sizeof(m_sleepWheelTimer));
+    m_queueNext     = ZERO;
+    m_queuePrev     = ZERO;
+    m_queued        = false;
+    m_core          = 0;
 }
 
 Process::~Process()
 {
     delete m_kernelChannel;
+    terminate();
 
-    if (m_memoryContext)
+    // Release the user stack of a thread
+    if (m_userStackSlot && m_threadGroup != m_id)
+    {
+        Memory::Range range;
+        range.virt = m_userStackSlot;
+        range.size = PROCESS_STACK_SIZE;
+        m_memoryContext->releaseRange(&range);
+    }
+
+    // Threads leave the memory context to the owner, which is released last
+    if (m_memoryContext && m_threadGroup == m_id)
     {
         m_memoryContext->releaseRegion(MemoryMap::UserData);
         m_memoryContext->releaseRegion(MemoryMap::UserHeap);
         m_memoryContext->releaseRegion(MemoryMap::UserStack);
         m_memoryContext->releaseRegion(MemoryMap::UserPrivate);
         m_memoryContext->releaseRegion(MemoryMap::UserArgs);
+        m_memoryContext->releaseRegion(MemoryMap::UserLibrary);
         m_memoryContext->releaseRegion(MemoryMap::UserShare, true);
+        m_memoryContext->releaseRegion(MemoryMap::UserClock, true);
+        m_memoryContext->releaseRegion(MemoryMap::UserMounts, true);
         delete m_memoryContext;
     }
 }
@@ -72,11 +101,36 @@ ProcessID Process::getWait() const
     return m_waitId;
 }
 
+ProcessID Process::getThreadGroup() const
+{
+    return m_threadGroup;
+}
+
+u64 Process::getCpuTime() const
+{
+    return m_cpuTime;
+}
+
+Address Process::getThreadData() const
+{
+    return m_threadData;
+}
+
+Address Process::getWaitAddress() const
+{
+    return m_waitAddress;
+}
+
 Process::State Process::getState() const
 {
     return m_state;
 }
 
+Size Process::getCore() const
+{
+    return m_core;
+}
+
 ProcessShares & Process::getShares()
 {
     return m_shares;
@@ -112,9 +166,35 @@ bool Process::isPrivileged() const
     return m_privileged;
 }
 
+bool Process::isSystem() const
+{
+    return m_privileged || m_system;
+}
+
+void Process::setSystem(bool system)
+{
+    m_system = system;
+}
+
 void Process::setState(Process::State st)
 {
+    ProcessManager *procs = Kernel::instance->getProcessManager();
+
     m_state = st;
+
+    // Only Ready processes are kept in the run queue
+    if (st == Ready)
+    {
+        procs->getScheduler()->enqueue(this);
+        procs->wakeupCore(m_core);
+    }
+    else
+        procs->getScheduler()->dequeue(this);
+}
+
+void Process::setCore(Size core)
+{
+    m_core = core;
 }
 
 void Process::setParent(ProcessID id)
@@ -122,14 +202,43 @@ void Process::setParent(ProcessID id)
     m_parent = id;
 }
 
+void Process::addCpuTime(u64 cycles)
+{
+    m_cpuTime += cycles;
+}
+
 void Process::setWait(ProcessID id)
 {
     m_waitId = id;
 }
 
+void Process::setThreadGroup(Process *owner, Address stack, Address data)
+{
+    m_threadGroup   = owner->getThreadGroup();
+    m_memoryContext = owner->getMemoryContext();
+    m_userStack     = stack;
+    m_threadData    = data;
+}
+
 void Process::setSleepTimer(const Timer::Info *sleepTimer)
 {
+    TimerWheel *wheel = Kernel::instance->getTimerWheel();
+
     MemoryBlock::copy(&m_sleepTimer, sleepTimer, sizeof(m_sleepTimer));
+    wheel->remove(&m_sleepWheelTimer);
+
+    // The sleep timer is expired once the timer passed its tick
+    if (m_sleepTimer.frequency)
+    {
+        m_sleepWheelTimer.process  = this;
+        m_sleepWheelTimer.expiry   = m_sleepTimer.ticks + 1;
+        m_sleepWheelTimer.interval = 0;
+
+        if ((s32) (m_sleepWheelTimer.expiry - wheel->getCurrent()) <= 0)
+            m_sleepWheelTimer.expiry = wheel->getCurrent() + 1;
+
+        wheel->insert(&m_sleepWheelTimer);
+    }
 }
 
 void Process::setPageDirectory(Address addr)
@@ -158,6 +267,167 @@ Process::Result Process::raiseEvent(ProcessEvent *event)
     return wakeup();
 }
 
+Process::Result Process::watchInterrupt(u32 irq, u32 vector)
+{
+    WatchedIRQ *slot = ZERO;
+
+    for (Size i = 0; i < PROCESS_WATCH_IRQ_MAX; i++)
+    {
+        if (m_interrupts[i].process && m_interrupts[i].irq == irq)
+            return Success;
+        else if (!m_interrupts[i].process && !slot)
+            slot = &m_interrupts[i];
+    }
+    if (!slot)
+        return OutOfMemory;
+
+    slot->irq       = irq;
+    slot->vector    = vector;
+    slot->pending   = 0;
+    slot->timestamp = 0;
+
+    if (Kernel::instance->hookIntVector(vector, interruptHandler, (ulong) slot) != Kernel::Success)
+        return OutOfMemory;
+
+    slot->process = this;
+    return Success;
+}
+
+Process::Result Process::readInterrupt(u32 *irq, Size *count, u64 *time)
+{
+    for (Size i = 0; i < PROCESS_WATCH_IRQ_MAX; i++)
+    {
+        WatchedIRQ *slot = &m_interrupts[i];
+
+        if (slot->process && slot->pending)
+        {
+            *irq   = slot->irq;
+            *count = slot->pending;
+            *time  = slot->timestamp;
+            slot->pending = 0;
+            return Success;
+        }
+    }
+    return NotFound;
+}
+
+void Process::interruptHandler(CPUState *state, ulong param)
+{
+    WatchedIRQ *slot = (WatchedIRQ *) param;
+
+    // Only the first pending interrupt needs to wakeup the Process,
+    // because it reads all pending interrupts before sleeping again.
+    if (slot->pending++ == 0)
+    {
+        slot->timestamp = timestamp();
+        slot->process->wakeup();
+    }
+}
+
+Process::Result Process::armTimer(u32 id, u32 ticks, u32 interval)
+{
+    TimerWheel *wheel = Kernel::instance->getTimerWheel();
+    WheelTimer *timer = ZERO;
+
+    // Find the timer with this identifier or a free one
+    for (Size i = 0; i < PROCESS_TIMER_MAX; i++)
+    {
+        if (m_timers[i].process && m_timers[i].id == id)
+        {
+            timer = &m_timers[i];
+            break;
+        }
+        else if (!m_timers[i].process && !timer)
+            timer = &m_timers[i];
+    }
+    if (!timer)
+        return OutOfMemory;
+
+    wheel->remove(timer);
+    timer->process     = this;
+    timer->id          = id;
+    timer->expiry      = wheel->getCurrent() + (ticks ? ticks : 1);
+    timer->interval    = interval;
+    timer->expirations = 0;
+    wheel->insert(timer);
+    return Success;
+}
+
+Process::Result Process::disarmTimer(u32 id)
+{
+    for (Size i = 0; i < PROCESS_TIMER_MAX; i++)
+    {
+        if (m_timers[i].process && m_timers[i].id == id)
+        {
+            Kernel::instance->getTimerWheel()->remove(&m_timers[i]);
+            m_timers[i].process = ZERO;
+            return Success;
+        }
+    }
+    return NotFound;
+}
+
+Process::Result Process::readTimer(u32 *id, Size *count)
+{
+    for (Size i = 0; i < PROCESS_TIMER_MAX; i++)
+    {
+        WheelTimer *timer = &m_timers[i];
+
+        if (timer->process && timer->expirations)
+        {
+            *id    = timer->id;
+            *count = timer->expirations;
+            timer->expirations = 0;
+
+            // Release expired one-shot timers
+            if (!timer->armed)
+                timer->process = ZERO;
+
+            return Success;
+        }
+    }
+    return NotFound;
+}
+
+void Process::expireTimer(WheelTimer *timer)
+{
+    if (timer == &m_sleepWheelTimer)
+    {
+        if (m_state == Sleeping)
+            wakeup();
+        return;
+    }
+
+    // Only the first expiration needs to wakeup the Process,
+    // because it reads all expired timers before sleeping again.
+    if (timer->expirations++ == 0)
+        wakeup();
+}
+
+void Process::terminate()
+{
+    TimerWheel *wheel = Kernel::instance->getTimerWheel();
+
+    // Remove interrupt hooks
+    for (Size i = 0; i < PROCESS_WATCH_IRQ_MAX; i++)
+    {
+        if (m_interrupts[i].process)
+            Kernel::instance->unhookIntVector(m_interrupts[i].vector, interruptHandler,
+                                              (ulong) &m_interrupts[i]);
+        m_interrupts[i].process = ZERO;
+    }
+
+    // Remove timers
+    for (Size i = 0; i < PROCESS_TIMER_MAX; i++)
+        wheel->remove(&m_timers[i]);
+    wheel->remove(&m_sleepWheelTimer);
+
+    // Never schedule the Process again
+    Kernel::instance->getProcessManager()->getWaitTable()->remove(this);
+    Kernel::instance->getProcessManager()->getScheduler()->dequeue(this);
+    m_state = Stopped;
+}
+
 Process::Result Process::initialize()
 {
     Memory::Range range;
@@ -165,12 +435,11 @@ Process::Result Process::initialize()
     Arch::Cache cache;
 
     // Allocate two pages for the kernel event channel
-    if (Kernel::instance->getAllocator()->allocateLow(PAGESIZE*2, &paddr) != Allocator::Success)
+    if (Kernel::instance->getAllocator()->allocateZero(PAGESIZE*2, &paddr) != Allocator::Success)
         return OutOfMemory;
 
     // Translate to virtual address in kernel low memory
     vaddr = (Address) Kernel::instance->getAllocator()->toVirtual(paddr);
-    MemoryBlock::set((void *)vaddr, 0, PAGESIZE*2);
     cache.cleanData(vaddr);
     cache.cleanData(vaddr + PAGESIZE);
 
@@ -192,20 +461,77 @@ Process::Result Process::initialize()
 
     // Setup the kernel event channel
     m_kernelChannel->setMode(Channel::Producer);
-    m_kernelChannel->setMessageSize(sizeof(ProcessEvent));
     m_kernelChannel->setVirtual(vaddr, vaddr + PAGESIZE);
 
+    // Map the shared pages, unless the owner already did
+    if (m_threadGroup != m_id)
+        return Success;
+
+    // Map the kernel clock page read-only
+    range = m_map.range(MemoryMap::UserClock);
+    range.phys   = Kernel::instance->getClockAddress();
+    range.access = Memory::User | Memory::Readable;
+    if (m_memoryContext->mapRange(&range) != MemoryContext::Success)
+        return MemoryMapError;
+
+    // Map the mounts page, which only sysfs may write
+    range = m_map.range(MemoryMap::UserMounts);
+    range.phys   = Kernel::instance->getMountsAddress();
+    range.access = Memory::User | Memory::Readable;
+    if (m_id == SYSFS_PID)
+        range.access |= Memory::Writable;
+    if (m_memoryContext->mapRange(&range) != MemoryContext::Success)
+        return MemoryMapError;
+
     return Success;
 }
 
+Process::Result Process::mapUserStack(Address *top)
+{
+    Memory::Range range = m_map.range(MemoryMap::UserStack);
+    Memory::Access access;
+    Address base = range.virt;
+
+    range.size   = PROCESS_STACK_SIZE;
+    range.access = Memory::Readable | Memory::Writable | Memory::User;
+
+    // Take the highest stack which is not mapped yet
+    for (range.virt = base + m_map.range(MemoryMap::UserStack).size - PROCESS_STACK_SIZE;
+         range.virt >= base; range.virt -= PROCESS_STACK_SIZE)
+    {
+        if (m_memoryContext->access(range.virt, &access) == MemoryContext::Success)
+            continue;
+
+        if (Kernel::instance->getAllocator()->allocate(&range.size, &range.phys) != Allocator::Success)
+            return OutOfMemory;
+
+        if (m_memoryContext->mapRange(&range) != MemoryContext::Success)
+            return MemoryMapError;
+
+        m_userStackSlot = range.virt;
+        *top = range.virt + range.size;
+        return Success;
+    }
+    return OutOfMemory;
+}
+
 Process::Result Process::wakeup()
 {
-    m_wakeups++;
+    // A sleeping Process consumes the wakeup directly,
+    // otherwise it stays pending for the next sleep().
+    if (m_state == Sleeping)
+        setState(Ready);
+    else
+    {
+        m_wakeups++;
 
-    if (m_state != Running)
-        m_state = Ready;
+        if (m_state != Running)
+            setState(Ready);
+    }
 
     MemoryBlock::set(&m_sleepTimer, 0, sizeof(m_sleepTimer));
+    Kernel::instance->getTimerWheel()->remove(&m_sleepWheelTimer);
+    Kernel::instance->getProcessManager()->getWaitTable()->remove(this);
     return Success;
 }
 
@@ -213,10 +539,10 @@ Process::Result Process::sleep(Timer::Info *timer)
 {
     if (!m_wakeups)
     {
-        m_state = Sleeping;
+        setState(Sleeping);
 
         if (timer)
-            MemoryBlock::copy(&m_sleepTimer, timer, sizeof(m_sleepTimer));
+            setSleepTimer(timer);
 
         return Success;
     }
@@ -24,24 +24,45 @@
 #include <MemoryMap.h>
 #include <Timer.h>
 #include <Index.h>
+#include <ConcurrentIndex.h>
 #include "ProcessShares.h"
+#include "TimerWheel.h"
 
 /** @see IPCMessage.h. */
 struct Message;
 class MemoryContext;
 class MemoryChannel;
 struct ProcessEvent;
+struct CPUState;
 
 /**
  * @addtogroup kernel
  * @{
  */
 
+/** Maximum number of processes. */
+#define MAX_PROCS 1024
+
+/** Maximum number of interrupts a Process can watch. */
+#define PROCESS_WATCH_IRQ_MAX 4
+
+/** Maximum number of timers a Process can arm. */
+#define PROCESS_TIMER_MAX 16
+
+/** Size of the user stack of each thread. The UserStack region holds one stack per thread. */
+#define PROCESS_STACK_SIZE KiloByte(16)
+
 /**
  * Represents a process which may run on the host.
  */
 class Process
 {
+    /** The Scheduler maintains the run queue links. */
+    friend class Scheduler;
+
+    /** The WaitTable maintains the wait queue links. */
+    friend class WaitTable;
+
   public:
 
     enum Result
@@ -49,7 +70,8 @@ class Process
         Success,
         MemoryMapError,
         OutOfMemory,
-        WakeupPending
+        WakeupPending,
+        NotFound
     };
 
     enum State
@@ -61,6 +83,28 @@ class Process
         Waiting
     };
 
+    /**
+     * Notification state of an interrupt watched by the Process.
+     */
+    typedef struct WatchedIRQ
+    {
+        /** Process which watches the interrupt or ZERO if unused. */
+        Process *process;
+
+        /** Interrupt number as given to watchInterrupt(). */
+        u32 irq;
+
+        /** Interrupt vector hooked in the kernel. */
+        u32 vector;
+
+        /** Number of interrupts not yet read by the Process. */
+        Size pending;
+
+        /** Value of timestamp() when the first pending interrupt arrived. */
+        u64 timestamp;
+    }
+    WatchedIRQ;
+
     /**
      * Constructor function.
      *
@@ -94,6 +138,35 @@ class Process
      */
     ProcessID getWait() const;
 
+    /**
+     * Get thread group.
+     *
+     * @return ProcessID of the Process which owns the memory context.
+     *         Equal to getID() unless this Process is a thread.
+     */
+    ProcessID getThreadGroup() const;
+
+    /**
+     * Get consumed processor time.
+     *
+     * @return Number of timestamp() cycles the Process executed.
+     */
+    u64 getCpuTime() const;
+
+    /**
+     * Get thread data.
+     *
+     * @return User address of the thread-local data or ZERO if not set.
+     */
+    Address getThreadData() const;
+
+    /**
+     * Get wait address.
+     *
+     * @return Physical address on which the Process sleeps or ZERO if none.
+     */
+    Address getWaitAddress() const;
+
     /**
      * Get sleep timer.
      *
@@ -115,6 +188,13 @@ class Process
      */
     State getState() const;
 
+    /**
+     * Get the core which runs the Process.
+     *
+     * @return Core index.
+     */
+    Size getCore() const;
+
     /**
      * Get the address of our page directory.
      *
@@ -150,6 +230,78 @@ class Process
      */
     Result raiseEvent(struct ProcessEvent *event);
 
+    /**
+     * Watch an hardware interrupt.
+     *
+     * Each time the interrupt triggers, its pending counter is incremented
+     * and the Process is woken up directly. No event message is sent.
+     *
+     * @param irq Interrupt number reported by readInterrupt().
+     * @param vector Interrupt vector to hook in the kernel.
+     *
+     * @return Result code
+     */
+    Result watchInterrupt(u32 irq, u32 vector);
+
+    /**
+     * Read and clear one pending interrupt.
+     *
+     * @param irq Output interrupt number.
+     * @param count Output number of interrupts since the last read.
+     * @param time Output value of timestamp() when the first of them arrived.
+     *
+     * @return Result code
+     */
+    Result readInterrupt(u32 *irq, Size *count, u64 *time);
+
+    /**
+     * Arm a timer.
+     *
+     * Re-arms the timer if a timer with the same identifier is already armed.
+     *
+     * @param id Timer identifier.
+     * @param ticks Number of timer ticks until the first expiration.
+     * @param interval Number of ticks between expirations or zero for a one-shot timer.
+     *
+     * @return Result code
+     */
+    Result armTimer(u32 id, u32 ticks, u32 interval);
+
+    /**
+     * Disarm a timer.
+     *
+     * @param id Timer identifier.
+     *
+     * @return Result code
+     */
+    Result disarmTimer(u32 id);
+
+    /**
+     * Read and clear the expirations of one expired timer.
+     *
+     * @param id Output timer identifier.
+     * @param count Output number of expirations since the last read.
+     *
+     * @return Result code
+     */
+    Result readTimer(u32 *id, Size *count);
+
+    /**
+     * Called by the TimerWheel when a timer expires.
+     *
+     * @param timer WheelTimer object pointer.
+     */
+    void expireTimer(WheelTimer *timer);
+
+    /**
+     * Stop all event sources of the Process.
+     *
+     * Unhooks watched interrupts, disarms all timers and removes
+     * the Process from the run queue. Called when the Process is removed,
+     * before its memory is released.
+     */
+    void terminate();
+
     /**
      * Get privilege.
      *
@@ -157,6 +309,25 @@ class Process
      */
     bool isPrivileged() const;
 
+    /**
+     * Check if the Process is a system process.
+     *
+     * System processes may perform operations which affect
+     * the whole system, such as setting the time. Boot programs
+     * are system processes. Other processes only become one if
+     * their parent grants it with GrantSystem.
+     *
+     * @return True for system processes, false otherwise.
+     */
+    bool isSystem() const;
+
+    /**
+     * Set or clear system process status.
+     *
+     * @param system True to make it a system process.
+     */
+    void setSystem(bool system);
+
     /**
      * Puts the Process in a new state.
      *
@@ -164,20 +335,50 @@ class Process
      */
     void setState(State st);
 
+    /**
+     * Move the Process to another core.
+     *
+     * Must only be called if the Process is not in a run queue.
+     *
+     * @param core Core index.
+     */
+    void setCore(Size core);
+
     /**
      * Set parent process ID.
      */
     void setParent(ProcessID id);
 
+    /**
+     * Account processor time.
+     *
+     * @param cycles Number of timestamp() cycles the Process executed.
+     */
+    void addCpuTime(u64 cycles);
+
     /**
      * Set Wait ID.
      */
     void setWait(ProcessID id);
 
+    /**
+     * Make this Process a thread of another Process.
+     *
+     * The thread shares the memory context of the owner and runs on the
+     * given user stack. Must be called before initialize().
+     *
+     * @param owner Process which owns the memory context.
+     * @param stack User stack address of the thread.
+     * @param data User address of the thread-local data.
+     */
+    void setThreadGroup(Process *owner, Address stack, Address data);
+
     /**
      * Set sleep timer.
      *
-     * @param sleeptimer New sleep timer value.
+     * The Process is woken up on the first timer tick after the sleep timer.
+     *
+     * @param sleeptimer New sleep timer value. Zero frequency disables the timer.
      */
     void setSleepTimer(const Timer::Info *sleeptimer);
 
@@ -244,6 +445,32 @@ class Process
      */
     virtual void execute(Process *previous) = 0;
 
+  protected:
+
+    /**
+     * Map a user stack in the UserStack region.
+     *
+     * Uses the highest PROCESS_STACK_SIZE bytes of the region which are
+     * not mapped yet. The owner of a thread group thus gets the top of
+     * the region and its threads the stacks below. The stack of a thread
+     * is released when the thread is removed.
+     *
+     * @param top Output top address of the user stack.
+     *
+     * @return Result code
+     */
+    Result mapUserStack(Address *top);
+
+  private:
+
+    /**
+     * Kernel interrupt hook for watched interrupts.
+     *
+     * @param state CPU state on the moment the interrupt occurred.
+     * @param param WatchedIRQ object pointer.
+     */
+    static void interruptHandler(struct CPUState *state, ulong param);
+
   protected:
 
     /** Process Identifier */
@@ -258,9 +485,27 @@ class Process
     /** Waits for exit of this Process. */
     ProcessID m_waitId;
 
+    /** Process which owns the memory context. */
+    ProcessID m_threadGroup;
+
+    /** User address of the thread-local data. */
+    Address m_threadData;
+
+    /** Physical address on which the Process sleeps. */
+    Address m_waitAddress;
+
+    /** Next Process in the same WaitTable bucket. */
+    Process *m_waitNext;
+
+    /** Previous Process in the same WaitTable bucket. */
+    Process *m_waitPrev;
+
     /** Privilege level */
     bool m_privileged;
 
+    /** May perform operations which affect the whole system. */
+    bool m_system;
+
     /** Entry point of the program */
     Address m_entry;
 
@@ -276,6 +521,9 @@ class Process
     /** User stack address. */
     Address m_userStack;
 
+    /** Start of the stack of this thread in the UserStack region or zero if none. */
+    Address m_userStackSlot;
+
     /** Current kernel stack address (changes during execution). */
     Address m_kernelStack;
 
@@ -285,6 +533,9 @@ class Process
     /** Number of wakeups received */
     Size m_wakeups;
 
+    /** Consumed processor time in timestamp() cycles */
+    u64 m_cpuTime;
+
     /**
      * Sleep timer value.
      * If non-zero, set the process in the Ready state
@@ -297,8 +548,32 @@ class Process
 
     /** Channel for sending kernel events to the Process */
     MemoryChannel *m_kernelChannel;
+
+    /** Interrupts watched by the Process */
+    WatchedIRQ m_interrupts[PROCESS_WATCH_IRQ_MAX];
+
+    /** Timers of the Process */
+    WheelTimer m_timers[PROCESS_TIMER_MAX];
+
+    /** Wakes up the Process when the sleep timer expires. */
+    WheelTimer m_sleepWheelTimer;
+
+    /** Next Process in the run queue. */
+    Process *m_queueNext;
+
+    /** Previous Process in the run queue. */
+    Process *m_queuePrev;
+
+    /** True if the Process is in the run queue. */
+    bool m_queued;
+
+    /** Index of the core which runs the Process. */
+    Size m_core;
 };
 
+/** Table of all processes, indexed by ProcessID modulo MAX_PROCS. */
+typedef ConcurrentIndex<Process, MAX_PROCS> ProcessTable;
+
 /**
  * @}
  */
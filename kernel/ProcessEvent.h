@@ -29,7 +29,6 @@
 
 enum ProcessEventType
 {
-    InterruptEvent,
     ShareCreated,
     ProcessTerminated
 };
@@ -17,16 +17,21 @@
 
 #include <FreeNOS/System.h>
 #include <Log.h>
+#include <MemoryBlock.h>
 #include "ProcessManager.h"
 
 ProcessManager::ProcessManager(Scheduler *scheduler)
-    : m_procs(MAX_PROCS)
 {
     DEBUG("m_procs = " << MAX_PROCS);
     m_scheduler = scheduler;
-    m_current   = ZERO;
-    m_previous  = ZERO;
-    m_idle      = ZERO;
+    m_nextId    = 0;
+    m_cores     = 1;
+    m_nextCore  = 0;
+    MemoryBlock::set(m_current, 0, sizeof(m_current));
+    MemoryBlock::set(m_previous, 0, sizeof(m_previous));
+    MemoryBlock::set(m_idle, 0, sizeof(m_idle));
+    MemoryBlock::set(m_accounted, 0, sizeof(m_accounted));
+    MemoryBlock::set(m_retired, 0, sizeof(m_retired));
 }
 
 ProcessManager::~ProcessManager()
@@ -38,67 +43,153 @@ Scheduler * ProcessManager::getScheduler()
     return m_scheduler;
 }
 
-Process * ProcessManager::create(Address entry, const MemoryMap &map)
+WaitTable * ProcessManager::getWaitTable()
 {
-    Process *proc = new Arch::Process(m_procs.count(), entry, false, map);
+    return &m_waitTable;
+}
+
+Process * ProcessManager::create(Address entry, const MemoryMap &map,
+                                 Process *owner, Address stack, Address data)
+{
+    Process *proc = ZERO;
+
+    // Find the next ProcessID with a free slot. Twice MAX_PROCS covers
+    // the slots which are skipped when the ProcessIDs wrap around.
+    for (Size i = 0; i < MAX_PROCS * 2; i++, advanceId())
+    {
+        if (!m_procs.get(m_nextId % MAX_PROCS))
+        {
+            proc = new Arch::Process(m_nextId, entry, false, map);
+            advanceId();
 
-    // Insert to the process table
+            // Spread new processes over the cores
+            proc->setCore(m_nextCore);
+            m_nextCore = (m_nextCore + 1) % m_cores;
+
+            if (owner)
+                proc->setThreadGroup(owner, stack, data);
+            break;
+        }
+    }
+
+    // Publish in the process table
     if (proc && proc->initialize() == Process::Success)
     {
-        m_procs.insert(proc);
+        m_procs.insert(proc->getID() % MAX_PROCS, proc);
         return proc;
     }
+    else if (proc)
+        delete proc;
+
     return ZERO;
 }
 
 Process * ProcessManager::get(ProcessID id)
 {
-    Process **p = (Process **) m_procs.get(id);
-    return p ? *p : ZERO;
+    Process *p = m_procs.get(id % MAX_PROCS);
+
+    return p && p->getID() == id ? p : ZERO;
 }
 
 void ProcessManager::remove(Process *proc, uint exitStatus)
 {
-    if (proc == m_previous)
-        m_previous = ZERO;
+    bool running = false;
 
-    if (proc == m_idle)
-        m_idle = ZERO;
+    // The Process may run on any core
+    for (Size i = 0; i < MAX_CORES; i++)
+    {
+        if (proc == m_previous[i])
+            m_previous[i] = ZERO;
 
-    if (proc == m_current)
-        m_current = ZERO;
+        if (proc == m_idle[i])
+            m_idle[i] = ZERO;
 
-    // Wakeup any Processes which are waiting for this Process
-    Size size = m_procs.size();
+        // Its kernel stack and memory context stay in use until the core switches away
+        if (proc == m_current[i])
+        {
+            // The core switched away from its previously retired Process
+            if (m_retired[i])
+                delete m_retired[i];
 
-    for (Size i = 0; i < size; i++)
+            m_current[i] = ZERO;
+            m_retired[i] = proc;
+            running = true;
+
+            // Stop the Process on other cores right away
+            if (i != core_index())
+                Kernel::instance->rescheduleCore(i);
+        }
+    }
+
+    // Threads cannot outlive the owner of their memory context. They are
+    // retired before the owner, such that the owner is released last.
+    if (proc->getThreadGroup() == proc->getID())
     {
-        if (m_procs[i] != ZERO &&
-            m_procs[i]->getState() == Process::Waiting &&
-            m_procs[i]->getWait() == proc->getID())
+        for (Size i = 0; i < MAX_PROCS; i++)
         {
-            m_procs[i]->setState(Process::Ready);
-            m_procs[i]->setWait(exitStatus);
+            Process *p = m_procs.get(i);
+
+            if (p != ZERO && p != proc && p->getThreadGroup() == proc->getID())
+                remove(p, exitStatus);
+        }
+    }
+
+    // Stop interrupts and timers from waking up the Process
+    proc->terminate();
+
+    // Wakeup any Processes which are waiting for this Process
+    for (Size i = 0; i < MAX_PROCS; i++)
+    {
+        Process *p = m_procs.get(i);
+
+        if (p != ZERO &&
+            p->getState() == Process::Waiting &&
+            p->getWait() == proc->getID())
+        {
+            p->setState(Process::Ready);
+            p->setWait(exitStatus);
         }
     }
 
     // Remove process from administration
-    m_procs[proc->getID()] = ZERO;
+    m_procs.remove(proc->getID() % MAX_PROCS);
 
-    // Free the process memory
-    delete proc;
+    // Free the process memory, unless a core still executes it
+    if (!running)
+        delete proc;
+}
+
+void ProcessManager::advanceId()
+{
+    if (m_nextId + 1 >= PROCESSID_RESERVED)
+        m_nextId = PROCESSID_WRAP;
+    else
+        m_nextId++;
 }
 
 Process * ProcessManager::schedule(Process *proc)
 {
+    Size core = core_index();
+
+    // Account the processor time of the current process
+    u64 now = timestamp();
+    if (m_current[core])
+        m_current[core]->addCpuTime(now - m_accounted[core]);
+    m_accounted[core] = now;
+
     // If needed, let the scheduler select a new process
     if (!proc)
     {
-        proc = m_scheduler->select(&m_procs, m_idle);
+        // A preempted Process goes to the tail of the run queue
+        if (m_current[core] && m_current[core] != m_idle[core] &&
+            m_current[core]->getState() == Process::Running)
+            m_current[core]->setState(Process::Ready);
+
+        proc = m_scheduler->select(core);
 
         // If no process ready, let us idle
         if (!proc)
-            proc = m_idle;
+            proc = m_idle[core];
     }
 
     if (!proc)
@@ -107,37 +198,64 @@ Process * ProcessManager::schedule(Process *proc)
     }
 
     // Only execute if its a different process
-    if (proc != m_current)
+    if (proc != m_current[core])
     {
-        m_previous = m_current;
-        m_current  = proc;
+        m_previous[core] = m_current[core];
+        m_current[core]  = proc;
 
-        if (m_previous && m_previous->getState() == Process::Running)
-            m_previous->setState(Process::Ready);
+        if (m_previous[core] && m_previous[core] != m_idle[core] &&
+            m_previous[core]->getState() == Process::Running)
+            m_previous[core]->setState(Process::Ready);
 
+        // Leave the run queue before moving to this core
         proc->setState(Process::Running);
-        proc->execute(m_previous);
-        return m_current;
+        proc->setCore(core);
+        proc->execute(m_previous[core]);
+
+        // Execution may continue on another core, which no longer runs a removed Process
+        core = core_index();
+        if (m_retired[core])
+        {
+            delete m_retired[core];
+            m_retired[core] = ZERO;
+        }
+        return current();
     }
+    proc->setState(Process::Running);
     return (Process *) NULL;
 }
 
 Process * ProcessManager::current()
 {
-    return m_current;
+    return m_current[core_index()];
 }
 
 Process * ProcessManager::previous()
 {
-    return m_previous;
+    return m_previous[core_index()];
 }
 
 void ProcessManager::setIdle(Process *proc)
 {
-    m_idle = proc;
+    m_idle[core_index()] = proc;
+}
+
+void ProcessManager::setCoreCount(Size cores)
+{
+    m_cores = cores;
+}
+
+void ProcessManager::wakeupCore(Size core)
+{
+    // Only idle cores need to reschedule right away
+    if (core != core_index() && core < m_cores &&
+        m_idle[core] && m_current[core] == m_idle[core])
+    {
+        Kernel::instance->rescheduleCore(core);
+    }
 }
 
-Vector<Process *> * ProcessManager::getProcessTable()
+ProcessTable * ProcessManager::getProcessTable()
 {
     return &m_procs;
 }
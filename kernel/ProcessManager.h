@@ -20,19 +20,33 @@
 
 #include <Types.h>
 #include <MemoryMap.h>
+#include <ConcurrentIndex.h>
 #include "Process.h"
 #include "Scheduler.h"
+#include "WaitTable.h"
 
 /**
  * @addtogroup kernel
  * @{
  */
 
-/** Maximum number of processes. */
-#define MAX_PROCS 1024
+/** First ProcessID handed out after wrapping around. Skips the static ProcessIDs. */
+#define PROCESSID_WRAP (ROOTFS_PID + 1)
+
+/** ProcessIDs from here on are reserved for KERNEL_PID, SELF and ANY. */
+#define PROCESSID_RESERVED KERNEL_PID
 
 /**
  * Represents a process which may run on the host.
+ *
+ * All functions are called with the kernel lock held. A removed Process is
+ * deleted right away, unless a core still executes it. Such a Process is
+ * deleted once that core switched to another Process in schedule().
+ *
+ * ProcessIDs increase up to PROCESSID_RESERVED and then wrap around to
+ * PROCESSID_WRAP, skipping ProcessIDs which are still in use. Therefore, the
+ * ProcessID of a removed Process is eventually reused and ProcessIDs are not
+ * ordered by creation time after wrapping around.
  */
 class ProcessManager
 {
@@ -55,10 +69,26 @@ class ProcessManager
      */
     Scheduler * getScheduler();
 
+    /**
+     * Get wait queues
+     *
+     * @return WaitTable object instance
+     */
+    WaitTable * getWaitTable();
+
     /**
      * Create and add a new Process.
+     *
+     * @param entry Initial program counter value.
+     * @param map Virtual memory layout.
+     * @param owner If set, create a thread which shares the memory context of owner.
+     * @param stack User stack address of the thread.
+     * @param data User address of the thread-local data.
+     *
+     * @return Process pointer or ZERO on failure.
      */
-    Process * create(Address entry, const MemoryMap &map);
+    Process * create(Address entry, const MemoryMap &map,
+                     Process *owner = ZERO, Address stack = 0, Address data = 0);
 
     /**
      * Retrieve a Process by it's ID.
@@ -71,6 +101,8 @@ class ProcessManager
 
     /**
      * Remove a Process.
+     *
+     * Removing the owner of a thread group also removes all its threads.
      */
     void remove(Process *proc, uint exitStatus = 0);
 
@@ -82,19 +114,35 @@ class ProcessManager
     Process * schedule(Process *proc = ZERO);
 
     /**
-     * Set the idle process.
+     * Set the idle process of the executing core.
      */
     void setIdle(Process *proc);
 
     /**
-     * Current process running. NULL if no process running yet.
+     * Set the number of cores which run processes.
+     *
+     * New processes are spread over the cores in turn.
+     *
+     * @param cores Number of cores.
+     */
+    void setCoreCount(Size cores);
+
+    /**
+     * Let an idle core select a Process which became Ready.
+     *
+     * @param core Core index.
+     */
+    void wakeupCore(Size core);
+
+    /**
+     * Current process running on the executing core. NULL if no process running yet.
      *
      * @return Process pointer
      */
     Process * current();
 
     /**
-     * Get the previous process running.
+     * Get the previous process running on the executing core.
      *
      * @return Process pointer
      */
@@ -105,24 +153,56 @@ class ProcessManager
      *
      * @return Pointer to the process table.
      */
-    Vector<Process *> * getProcessTable();
+    ProcessTable * getProcessTable();
 
   private:
 
-    /** All known Processes. */
-    Vector<Process *> m_procs;
+    /**
+     * Advance to the next ProcessID.
+     *
+     * Wraps around to PROCESSID_WRAP before the reserved ProcessIDs.
+     */
+    void advanceId();
+
+  private:
+
+    /** All known Processes, indexed by ProcessID modulo MAX_PROCS. */
+    ProcessTable m_procs;
+
+    /**
+     * ProcessID for the next created Process.
+     *
+     * ProcessIDs increase until the reserved ProcessIDs and then wrap around,
+     * so the ProcessID of a removed Process is eventually reused.
+     */
+    ProcessID m_nextId;
 
     /** Object which selects processes to run. */
     Scheduler *m_scheduler;
 
-    /** Currently executing process */
-    Process *m_current;
+    /** Processes which sleep on a memory word. */
+    WaitTable m_waitTable;
+
+    /** Currently executing process of each core */
+    Process *m_current[MAX_CORES];
+
+    /** Previous process executing of each core */
+    Process *m_previous[MAX_CORES];
+
+    /** Idle process of each core */
+    Process *m_idle[MAX_CORES];
+
+    /** Value of timestamp() when processor time was last accounted on each core */
+    u64 m_accounted[MAX_CORES];
+
+    /** Removed process which each core executed, deleted when the core switches away */
+    Process *m_retired[MAX_CORES];
 
-    /** Previous process executing */
-    Process *m_previous;
+    /** Number of cores which run processes. */
+    Size m_cores;
 
-    /** Idle process */
-    Process *m_idle;
+    /** Core index which receives the next created Process. */
+    Size m_nextCore;
 };
 
 /**
@@ -23,6 +23,7 @@
 #include "ProcessEvent.h"
 
 ProcessShares::ProcessShares(ProcessID pid)
+    : m_shares(PROCESSSHARES_BUCKETS), m_peers(PROCESSSHARES_BUCKETS)
 {
     m_pid    = pid;
     m_memory = ZERO;
@@ -39,19 +40,19 @@ ProcessShares::~ProcessShares()
 
     // Make a list of unique process IDs which
     // have a share with this Process
-    Size size = m_shares.size();
-    for (Size i = 0; i < size; i++)
+    for (ListIterator<MemoryShare *> i(m_shares.values()); i.hasCurrent(); i++)
     {
-        MemoryShare *sh = (MemoryShare *) m_shares.get(i);
-        if (sh)
-        {
-            if (!pids.contains(sh->pid))
-                pids.append(sh->pid);
+        MemoryShare *sh = i.current();
 
-            releaseShare(sh, i);
-        }
+        if (!pids.contains(sh->pid))
+            pids.append(sh->pid);
+
+        releaseShare(sh);
     }
 
+    for (ListIterator<List<MemoryShare *> *> i(m_peers.values()); i.hasCurrent(); i++)
+        delete i.current();
+
     // Raise process terminated events
     for (ListIterator<ProcessID> i(pids); i.hasCurrent(); i++)
     {
@@ -94,6 +95,10 @@ ProcessShares::Result ProcessShares::createShare(ProcessID pid,
     if (size == 0 || size % PAGESIZE)
         return InvalidArgument;
 
+    // Check if the share already exists
+    if (m_shares.get(ShareKey(pid, coreId, tagId)))
+        return AlreadyExists;
+
     // Allocate MemoryShare objects
     share  = new MemoryShare;
     if (!share)
@@ -108,8 +113,8 @@ ProcessShares::Result ProcessShares::createShare(ProcessID pid,
     m_memory->lookup(share->range.virt, &share->range.phys);
     m_memory->access(share->range.virt, &share->range.access);
 
-    // insert into shares list
-    m_shares.insert(*share);
+    // insert into shares index
+    insertShare(share);
     return Success;
 }
 
@@ -142,13 +147,12 @@ ProcessShares::Result ProcessShares::createShare(ProcessShares & instance,
         delete localShare;
         return OutOfMemory;
     }
-    // Allocate actual pages
-    if (Kernel::instance->getAllocator()->allocateLow(share->range.size, &paddr) != Allocator::Success)
+    // Allocate cleared pages
+    if (Kernel::instance->getAllocator()->allocateZero(share->range.size, &paddr) != Allocator::Success)
         return OutOfMemory;
 
-    // Zero out the pages
+    // Flush the cleared pages to memory
     vaddr = (Address) Kernel::instance->getAllocator()->toVirtual(paddr);
-    MemoryBlock::set((void *)vaddr, 0, share->range.size);
     for (Size i = 0; i < share->range.size; i+=PAGESIZE)
         cache.cleanData(vaddr + i);
 
@@ -186,9 +190,9 @@ ProcessShares::Result ProcessShares::createShare(ProcessShares & instance,
         delete remoteShare;
         return OutOfMemory;
     }
-    // insert into shares list
-    m_shares.insert(*localShare);
-    instance.m_shares.insert(*remoteShare);
+    // insert into shares index
+    insertShare(localShare);
+    instance.insertShare(remoteShare);
 
     // raise event on the remote process
     Process *proc = Kernel::instance->getProcessManager()->get(instance.getProcessID());
@@ -205,23 +209,62 @@ ProcessShares::Result ProcessShares::createShare(ProcessShares & instance,
 
 ProcessShares::Result ProcessShares::removeShares(ProcessID pid)
 {
-    Size size = m_shares.size();
-    MemoryShare *s = 0;
+    List<MemoryShare *> * const *peer = m_peers.get(pid);
+    List<MemoryShare *> shares;
+
+    if (!peer)
+        return Success;
 
-    for (Size i = 0; i < size; i++)
+    // Copy the list of the peer, which is deleted with its last share
+    shares = **peer;
+
+    // Remove and release each share
+    for (ListIterator<MemoryShare *> i(shares); i.hasCurrent(); i++)
     {
-        if ((s = (MemoryShare *) m_shares.get(i)) != ZERO)
-        {
-            if (s->pid != pid)
-                continue;
+        MemoryShare *s = i.current();
 
-            releaseShare(s, i);
-        }
+        removeShare(s);
+        releaseShare(s);
     }
     return Success;
 }
 
-ProcessShares::Result ProcessShares::releaseShare(MemoryShare *s, Size idx)
+void ProcessShares::insertShare(MemoryShare *share)
+{
+    List<MemoryShare *> * const *peer = m_peers.get(share->pid);
+    List<MemoryShare *> *list;
+
+    if (peer)
+        list = *peer;
+    else
+    {
+        list = new List<MemoryShare *>;
+        m_peers.insert(share->pid, list);
+    }
+    list->append(share);
+    m_shares.insert(ShareKey(share->pid, share->coreId, share->tagId), share);
+}
+
+void ProcessShares::removeShare(MemoryShare *share)
+{
+    List<MemoryShare *> * const *peer = m_peers.get(share->pid);
+    List<MemoryShare *> *list = peer ? *peer : ZERO;
+
+    m_shares.remove(ShareKey(share->pid, share->coreId, share->tagId));
+
+    if (list)
+    {
+        list->remove(share);
+
+        if (list->isEmpty())
+        {
+            m_peers.remove(share->pid);
+            delete list;
+        }
+    }
+}
+
+ProcessShares::Result ProcessShares::releaseShare(MemoryShare *s)
 {
     // Only release physical memory if both processes have detached.
     // Note that in case all memory shares for a certain ProcessID have
@@ -236,16 +279,18 @@ ProcessShares::Result ProcessShares::releaseShare(MemoryShare *s, Size idx)
         if (proc)
         {
             ProcessShares & shares = proc->getShares();
-            Size size = shares.m_shares.size();
+            List<MemoryShare *> * const *peer = shares.m_peers.get(m_pid);
 
             // Mark all process shares detached in the other process
-            for (Size i = 0; i < size; i++)
+            if (peer)
             {
-                MemoryShare *otherShare = (MemoryShare *) shares.m_shares.get(i);
-                if (otherShare && otherShare->pid == m_pid
-                               && otherShare->coreId == s->coreId)
+                for (ListIterator<MemoryShare *> i(*peer); i.hasCurrent(); i++)
                 {
-                    otherShare->attached = false;
+                    MemoryShare *otherShare = i.current();
+                    if (otherShare->coreId == s->coreId)
+                    {
+                        otherShare->attached = false;
+                    }
                 }
             }
         }
@@ -261,30 +306,17 @@ ProcessShares::Result ProcessShares::releaseShare(MemoryShare *s, Size idx)
     }
     // Unmap the share
     m_memory->unmapRange(&s->range);
-
-    // Remove share from our administration
-    m_shares.remove(idx);
     delete s;
     return Success;
 }
 
 ProcessShares::Result ProcessShares::readShare(MemoryShare *share)
 {
-    Size size = m_shares.size();
-    const MemoryShare *s = 0;
+    MemoryShare * const *s = m_shares.get(ShareKey(share->pid, share->coreId, share->tagId));
 
-    for (Size i = 0; i < size; i++)
-    {
-        if ((s = m_shares.get(i)) != ZERO)
-        {
-            if (s->pid == share->pid &&
-                s->coreId == share->coreId &&
-                s->tagId == share->tagId)
-            {
-                MemoryBlock::copy(share, s, sizeof(MemoryShare));
-                return Success;
-            }
-        }
-    }
-    return NotFound;
+    if (!s)
+        return NotFound;
+
+    MemoryBlock::copy(share, *s, sizeof(MemoryShare));
+    return Success;
 }
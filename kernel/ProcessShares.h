@@ -22,7 +22,7 @@
 #include <Macros.h>
 #include <List.h>
 #include <MemoryMap.h>
-#include <Index.h>
+#include <HashTable.h>
 #include <MemoryContext.h>
 
 class MemoryChannel;
@@ -33,6 +33,9 @@ class Process;
  * @{
  */
 
+/** Initial number of buckets in the share index. Grows with the number of shares. */
+#define PROCESSSHARES_BUCKETS 8
+
 /**
  * Manages memory shares for a Process.
  */
@@ -68,6 +71,51 @@ class ProcessShares
     }
     MemoryShare;
 
+    /**
+     * Key of a MemoryShare in the share index.
+     */
+    typedef struct ShareKey
+    {
+        /**
+         * Default constructor.
+         */
+        ShareKey()
+            : pid(0), coreId(0), tagId(0)
+        {
+        }
+
+        /**
+         * Constructor.
+         *
+         * @param p Remote process id.
+         * @param c CoreId for the other process.
+         * @param t Share tag id.
+         */
+        ShareKey(ProcessID p, Size c, Size t)
+            : pid(p), coreId(c), tagId(t)
+        {
+        }
+
+        /** Remote process id for this share */
+        ProcessID pid;
+
+        /** CoreId for the other process */
+        Size coreId;
+
+        /** Share tag id is defined by the application */
+        Size tagId;
+
+        bool operator == (const struct ShareKey & key) const
+        {
+            return pid == key.pid && coreId == key.coreId && tagId == key.tagId;
+        }
+        bool operator != (const struct ShareKey & key) const
+        {
+            return !(*this == key);
+        }
+    }
+    ShareKey;
+
     enum Result
     {
         Success,
@@ -152,15 +200,30 @@ class ProcessShares
 
   private:
 
+    /**
+     * Add a share to the share index and the list of its peer.
+     *
+     * @param share MemoryShare object pointer
+     */
+    void insertShare(MemoryShare *share);
+
+    /**
+     * Remove a share from the share index and the list of its peer.
+     *
+     * @param share MemoryShare object pointer
+     */
+    void removeShare(MemoryShare *share);
+
     /**
      * Release one memory share
      *
+     * The caller must remove the share from the share index.
+     *
      * @param share MemoryShare object pointer
-     * @param idx Index position of the object
      *
      * @return Result code
      */
-    Result releaseShare(MemoryShare *share, Size idx);
+    Result releaseShare(MemoryShare *share);
 
   private:
 
@@ -173,10 +236,32 @@ class ProcessShares
     /** Memory channel for sending kernel events to the associated Process */
     MemoryChannel *m_kernelChannel;
 
-    /** Contains all memory shares */
-    Index<MemoryShare> m_shares;
+    /**
+     * Contains all memory shares.
+     *
+     * Keys hash on the ProcessID, CoreID and TagID, such that many
+     * shares with one process are spread over the buckets. The HashTable
+     * adds buckets as shares are created, which keeps the buckets short.
+     */
+    HashTable<ShareKey, MemoryShare *> m_shares;
+
+    /** Shares per peer ProcessID, for removing all shares with a process. */
+    HashTable<ProcessID, List<MemoryShare *> *> m_peers;
 };
 
+/**
+ * Compute a hash for a MemoryShare key.
+ *
+ * @param key Share key to hash.
+ * @param mod Modulo value.
+ *
+ * @return Computed hash of the key's ProcessID, CoreID and TagID.
+ */
+inline Size hash(const ProcessShares::ShareKey & key, Size mod)
+{
+    return hash((int) ((((key.pid * 31) + key.coreId) * 31) + key.tagId), mod);
+}
+
 /**
  * @}
  */
@@ -16,47 +16,70 @@
  */
 
 #include <Log.h>
+#include <MemoryBlock.h>
 #include "Scheduler.h"
 
 Scheduler::Scheduler()
 {
     DEBUG("");
 
-    m_index = 0;
-    m_timer = 0;
+    MemoryBlock::set(m_queues, 0, sizeof(m_queues));
 }
 
-void Scheduler::setTimer(Timer *timer)
+void Scheduler::enqueue(Process *proc)
 {
-    m_timer = timer;
+    RunQueue *queue = &m_queues[proc->getCore()];
+
+    if (proc->m_queued)
+        return;
+
+    proc->m_queueNext = ZERO;
+    proc->m_queuePrev = queue->tail;
+    proc->m_queued    = true;
+
+    if (queue->tail)
+        queue->tail->m_queueNext = proc;
+    else
+        queue->head = proc;
+
+    queue->tail = proc;
+    queue->count++;
+}
+
+void Scheduler::dequeue(Process *proc)
+{
+    RunQueue *queue = &m_queues[proc->getCore()];
+
+    if (!proc->m_queued)
+        return;
+
+    if (proc->m_queuePrev)
+        proc->m_queuePrev->m_queueNext = proc->m_queueNext;
+    else
+        queue->head = proc->m_queueNext;
+
+    if (proc->m_queueNext)
+        proc->m_queueNext->m_queuePrev = proc->m_queuePrev;
+    else
+        queue->tail = proc->m_queuePrev;
+
+    proc->m_queueNext = ZERO;
+    proc->m_queuePrev = ZERO;
+    proc->m_queued    = false;
+    queue->count--;
 }
 
-Process * Scheduler::select(Vector<Process *> *procs, Process *idle)
+Process * Scheduler::select(Size core)
 {
-    Size size = procs->size();
-
-    for (Size i = 0; i < size; i++)
-    {
-        // Increment process index
-        m_index = (m_index + 1) % size;
-
-        // Pick the process
-        Process *p = procs->at(m_index);
-
-        if (p)
-        {
-            Process::State state = p->getState();
-
-            // Wakeup the process if its sleeptimer expired
-            if (state == Process::Sleeping && m_timer->isExpired(p->getSleepTimer()))
-                p->wakeup();
-
-            // Select this process if it wants to run
-            if (p != idle && (state == Process::Ready || state == Process::Running))
-            {
-                return p;
-            }
-        }
-    }
-    return (Process *) NULL;
+    RunQueue *busiest = &m_queues[core];
+
+    if (busiest->head)
+        return busiest->head;
+
+    // Take over work from the core with the most Ready processes
+    for (Size i = 0; i < MAX_CORES; i++)
+        if (m_queues[i].count > busiest->count)
+            busiest = &m_queues[i];
+
+    return busiest->head;
 }
@@ -21,10 +21,9 @@
 
 #include <Vector.h>
 #include <Macros.h>
+#include <CoreInfo.h>
 #include "Process.h"
 
-class Timer;
-
 /**
  * @addtogroup kernel
  * @{
@@ -32,6 +31,11 @@ class Timer;
 
 /**
  * Responsible for deciding which Process may execute on the CPU(s).
+ *
+ * Processes in the Ready state are kept in a run queue in order of arrival,
+ * such that selecting the next Process takes constant time regardless of the
+ * number of sleeping Processes. Each core has its own run queue. A core without
+ * Ready processes takes one from the longest run queue of another core.
  */
 class Scheduler
 {
@@ -44,29 +48,48 @@ class Scheduler
     Scheduler();
 
     /**
-     * Set timer to use
+     * Add a Process to the tail of the run queue of its core.
+     *
+     * @param proc Process which became Ready. Ignored if already queued.
+     */
+    void enqueue(Process *proc);
+
+    /**
+     * Remove a Process from the run queue.
      *
-     * @param timer Timer instance
+     * @param proc Process which is no longer Ready. Ignored if not queued.
      */
-    void setTimer(Timer *timer);
+    void dequeue(Process *proc);
 
     /**
      * Select the next process to run.
      *
-     * @param procs Process table
-     * @param idle Idle process, if any
+     * @param core Index of the core which runs the process.
      *
      * @return Process pointer or NULL if no matching process found
      */
-    virtual Process * select(Vector<Process *> *procs, Process *idle);
+    virtual Process * select(Size core);
 
   private:
 
-    /** Contains last used index for scheduling */
-    Size m_index;
+    /**
+     * Ready processes of a single core.
+     */
+    typedef struct RunQueue
+    {
+        /** First Process in the run queue. */
+        Process *head;
+
+        /** Last Process in the run queue. */
+        Process *tail;
+
+        /** Number of processes in the run queue. */
+        Size count;
+    }
+    RunQueue;
 
-    /** Points to the Timer to use for sleep timeouts */
-    Timer *m_timer;
+    /** Run queue of each core. */
+    RunQueue m_queues[MAX_CORES];
 };
 
 /**
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <SplitAllocator.h>
+#include <MemoryBlock.h>
+#include "SlabCache.h"
+
+SlabCache::SlabCache(const char *name, Size objectSize, SplitAllocator *alloc)
+    : m_alloc(alloc)
+    , m_partial(ZERO)
+    , m_full(ZERO)
+    , m_empty(ZERO)
+{
+    // Objects must be able to hold the free list pointer
+    if (objectSize < sizeof(void *))
+        objectSize = sizeof(void *);
+
+    objectSize = (objectSize + MEMALIGN - 1) & ~(MEMALIGN - 1);
+    m_offset   = (sizeof(Slab) + MEMALIGN - 1) & ~(MEMALIGN - 1);
+    m_perSlab  = (SLAB_SIZE - m_offset) / objectSize;
+
+    MemoryBlock::set(&m_info, 0, sizeof(m_info));
+    MemoryBlock::copy(m_info.name, (char *) name, SLAB_NAME_MAX);
+    m_info.objectSize = objectSize;
+}
+
+void * SlabCache::allocate()
+{
+    Slab *slab = m_partial;
+    void *object;
+
+    // Take a slab with free objects, then the empty slab or a new slab
+    if (!slab)
+    {
+        if ((slab = m_empty) != ZERO)
+            m_empty = ZERO;
+        else if (!(slab = grow()))
+            return ZERO;
+
+        link(&m_partial, slab);
+    }
+    object     = slab->free;
+    slab->free = *(void **) object;
+    slab->used++;
+
+    if (slab->used == m_perSlab)
+    {
+        unlink(&m_partial, slab);
+        link(&m_full, slab);
+    }
+    m_info.objects++;
+    m_info.allocations++;
+    return object;
+}
+
+void SlabCache::release(void *object)
+{
+    Slab *slab = slabOf(object);
+
+    if (slab->used == m_perSlab)
+    {
+        unlink(&m_full, slab);
+        link(&m_partial, slab);
+    }
+    *(void **) object = slab->free;
+    slab->free = object;
+    slab->used--;
+    m_info.objects--;
+
+    // Keep one empty slab and return any other to the SplitAllocator
+    if (!slab->used)
+    {
+        unlink(&m_partial, slab);
+
+        if (m_empty)
+            shrink(slab);
+        else
+            m_empty = slab;
+    }
+}
+
+Size SlabCache::getObjectSize() const
+{
+    return m_info.objectSize;
+}
+
+const SlabCacheInfo & SlabCache::getInfo() const
+{
+    return m_info;
+}
+
+Slab * SlabCache::grow()
+{
+    Address phys, obj;
+    Slab *slab;
+
+    if (m_alloc->allocateLow(SLAB_SIZE, &phys, SLAB_SIZE) != Allocator::Success)
+        return ZERO;
+
+    slab        = (Slab *) m_alloc->toVirtual(phys);
+    slab->cache = this;
+    slab->prev  = ZERO;
+    slab->next  = ZERO;
+    slab->free  = ZERO;
+    slab->used  = 0;
+
+    // Thread all objects on the free list, lowest address first
+    obj = (Address) slab + m_offset + ((m_perSlab - 1) * m_info.objectSize);
+
+    for (Size i = 0; i < m_perSlab; i++, obj -= m_info.objectSize)
+    {
+        *(void **) obj = slab->free;
+        slab->free = (void *) obj;
+    }
+    m_info.slabs++;
+    m_info.capacity += m_perSlab;
+    return slab;
+}
+
+void SlabCache::shrink(Slab *slab)
+{
+    Address phys = (Address) m_alloc->toPhysical((Address) slab);
+
+    for (Size i = 0; i < SLAB_SIZE; i += PAGESIZE)
+        m_alloc->release(phys + i);
+
+    m_info.slabs--;
+    m_info.capacity -= m_perSlab;
+}
+
+void SlabCache::link(Slab **list, Slab *slab)
+{
+    slab->prev = ZERO;
+    slab->next = *list;
+
+    if (*list)
+        (*list)->prev = slab;
+    *list = slab;
+}
+
+void SlabCache::unlink(Slab **list, Slab *slab)
+{
+    if (slab->prev)
+        slab->prev->next = slab->next;
+    else
+        *list = slab->next;
+
+    if (slab->next)
+        slab->next->prev = slab->prev;
+
+    slab->prev = ZERO;
+    slab->next = ZERO;
+}
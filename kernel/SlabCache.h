@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __KERNEL_SLABCACHE_H
+#define __KERNEL_SLABCACHE_H
+
+#include <Types.h>
+#include <Macros.h>
+
+/** Forward declarations */
+class SplitAllocator;
+class SlabCache;
+
+/**
+ * @addtogroup kernel
+ * @{
+ */
+
+/** Size of each slab in bytes. Slabs are aligned on their size. */
+#define SLAB_SIZE (PAGESIZE * 4)
+
+/** Maximum length of a cache name, including the terminating zero. */
+#define SLAB_NAME_MAX 16
+
+/**
+ * Statistics of a SlabCache.
+ */
+typedef struct SlabCacheInfo
+{
+    /** Name of the cache. */
+    char name[SLAB_NAME_MAX];
+
+    /** Size of each object in bytes. */
+    Size objectSize;
+
+    /** Number of slabs owned by the cache. */
+    Size slabs;
+
+    /** Number of objects in use. */
+    Size objects;
+
+    /** Number of objects which fit in all slabs. */
+    Size capacity;
+
+    /** Total number of allocations since boot. */
+    Size allocations;
+}
+SlabCacheInfo;
+
+/**
+ * Slab header.
+ *
+ * Placed at the start of each slab and directly followed by the objects.
+ */
+typedef struct Slab
+{
+    /** Cache which owns the slab or ZERO for a large allocation. */
+    SlabCache *cache;
+
+    /** Previous slab in the same list. */
+    struct Slab *prev;
+
+    /** Next slab in the same list. */
+    struct Slab *next;
+
+    /** First free object. */
+    void *free;
+
+    /** Objects in use or number of pages for a large allocation. */
+    Size used;
+}
+Slab;
+
+/**
+ * Cache of equally sized objects.
+ *
+ * Objects are carved out of slabs of SLAB_SIZE bytes, which the cache
+ * pulls from the SplitAllocator when all slabs are full. A single empty
+ * slab is kept to absorb allocate/release cycles and any other slab
+ * which becomes empty is returned to the SplitAllocator.
+ */
+class SlabCache
+{
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param name Name of the cache.
+     * @param objectSize Size of each object in bytes.
+     * @param alloc Physical memory allocator to pull slabs from.
+     */
+    SlabCache(const char *name, Size objectSize, SplitAllocator *alloc);
+
+    /**
+     * Allocate an object.
+     *
+     * @return Pointer to the object or ZERO if out of memory.
+     */
+    void * allocate();
+
+    /**
+     * Release an object.
+     *
+     * @param object Object previously returned by allocate().
+     */
+    void release(void *object);
+
+    /**
+     * Get the size of each object.
+     *
+     * @return Object size in bytes.
+     */
+    Size getObjectSize() const;
+
+    /**
+     * Get statistics.
+     *
+     * @return SlabCacheInfo reference.
+     */
+    const SlabCacheInfo & getInfo() const;
+
+    /**
+     * Get the slab of an object.
+     *
+     * @param object Object or large allocation inside the slab.
+     *
+     * @return Slab header.
+     */
+    static Slab * slabOf(const void *object)
+    {
+        return (Slab *) ((Address) object & ~(SLAB_SIZE - 1));
+    }
+
+  private:
+
+    /**
+     * Pull a new slab from the SplitAllocator.
+     *
+     * @return Slab pointer or ZERO if out of memory.
+     */
+    Slab * grow();
+
+    /**
+     * Return a slab to the SplitAllocator.
+     *
+     * @param slab Empty slab.
+     */
+    void shrink(Slab *slab);
+
+    /**
+     * Insert a slab at the head of a list.
+     *
+     * @param list List head.
+     * @param slab Slab to insert.
+     */
+    static void link(Slab **list, Slab *slab);
+
+    /**
+     * Remove a slab from a list.
+     *
+     * @param list List head.
+     * @param slab Slab to remove.
+     */
+    static void unlink(Slab **list, Slab *slab);
+
+  private:
+
+    /** Physical memory allocator. */
+    SplitAllocator *m_alloc;
+
+    /** Slabs with at least one free and one used object. */
+    Slab *m_partial;
+
+    /** Slabs without free objects. */
+    Slab *m_full;
+
+    /** Empty slab kept for reuse, if any. */
+    Slab *m_empty;
+
+    /** Offset of the first object in a slab. */
+    Size m_offset;
+
+    /** Number of objects per slab. */
+    Size m_perSlab;
+
+    /** Statistics. */
+    SlabCacheInfo m_info;
+};
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL_SLABCACHE_H */
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __KERNEL_SYSTEMCLOCK_H
+#define __KERNEL_SYSTEMCLOCK_H
+
+#include <Types.h>
+
+/**
+ * @addtogroup kernel
+ * @{
+ */
+
+/** Fixed-point shift used for SystemClock::counterMultiplier */
+#define SYSTEMCLOCK_SHIFT 20
+
+/**
+ * Kernel maintained clock page.
+ *
+ * The kernel updates this page on every timer interrupt and maps it
+ * read-only at the MemoryMap::UserClock region of every process. This allows
+ * processes to read the current time without entering the kernel.
+ *
+ * Readers must retry while the sequence number is odd or changed during the read.
+ * Between timer interrupts, the time can be interpolated with timestamp()
+ * once the counter frequency has been calibrated against the timer.
+ */
+typedef struct SystemClock
+{
+    /** Incremented before and after each update. Odd while the kernel updates the page. */
+    volatile u32 sequence;
+
+    /** Timer interrupt frequency in hertz. */
+    u32 frequency;
+
+    /** Number of timer interrupts since boot. */
+    u32 ticks;
+
+    /** Nanoseconds per timer interrupt. */
+    u32 tickNanoseconds;
+
+    /** Monotonic nanoseconds since boot at the last timer interrupt. */
+    u64 nanoseconds;
+
+    /** Value of timestamp() at the last timer interrupt. */
+    u64 counter;
+
+    /** Frequency of timestamp() in hertz or zero if not (yet) calibrated. */
+    u64 counterFrequency;
+
+    /** Nanoseconds per timestamp() cycle, shifted left by SYSTEMCLOCK_SHIFT. */
+    u32 counterMultiplier;
+
+    /** Seconds since the epoch at boot time or zero if unknown. */
+    u32 bootTime;
+}
+SystemClock;
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL_SYSTEMCLOCK_H */
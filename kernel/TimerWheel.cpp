@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <MemoryBlock.h>
+#include "Process.h"
+#include "TimerWheel.h"
+
+TimerWheel::TimerWheel()
+{
+    m_current = 0;
+    MemoryBlock::set(m_slots, 0, sizeof(m_slots));
+}
+
+u32 TimerWheel::getCurrent() const
+{
+    return m_current;
+}
+
+void TimerWheel::insert(WheelTimer *timer)
+{
+    WheelTimer **slot = &m_slots[timer->expiry & (TIMERWHEEL_SLOTS - 1)];
+
+    timer->prev  = ZERO;
+    timer->next  = *slot;
+    timer->armed = true;
+
+    if (*slot)
+        (*slot)->prev = timer;
+    *slot = timer;
+}
+
+void TimerWheel::remove(WheelTimer *timer)
+{
+    if (!timer->armed)
+        return;
+
+    if (timer->prev)
+        timer->prev->next = timer->next;
+    else
+        m_slots[timer->expiry & (TIMERWHEEL_SLOTS - 1)] = timer->next;
+
+    if (timer->next)
+        timer->next->prev = timer->prev;
+
+    timer->prev  = ZERO;
+    timer->next  = ZERO;
+    timer->armed = false;
+}
+
+void TimerWheel::advance(u32 ticks)
+{
+    while (m_current != ticks)
+    {
+        WheelTimer *expired = ZERO;
+
+        m_current++;
+
+        // Collect expired timers of this slot
+        for (WheelTimer *t = m_slots[m_current & (TIMERWHEEL_SLOTS - 1)], *next; t; t = next)
+        {
+            next = t->next;
+
+            if ((s32) (t->expiry - m_current) <= 0)
+            {
+                remove(t);
+                t->next = expired;
+                expired = t;
+            }
+        }
+
+        // Report to the owners and re-arm periodic timers
+        for (WheelTimer *t = expired, *next; t; t = next)
+        {
+            next = t->next;
+            t->next = ZERO;
+            t->process->expireTimer(t);
+
+            if (t->interval)
+            {
+                t->expiry = m_current + t->interval;
+                insert(t);
+            }
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __KERNEL_TIMERWHEEL_H
+#define __KERNEL_TIMERWHEEL_H
+
+#include <Types.h>
+#include <Macros.h>
+
+/** Forward declarations */
+class Process;
+
+/**
+ * @addtogroup kernel
+ * @{
+ */
+
+/** Number of slots in the TimerWheel. Must be a power of two. */
+#define TIMERWHEEL_SLOTS 256
+
+/**
+ * One-shot or periodic timer, owned by a Process.
+ */
+typedef struct WheelTimer
+{
+    /** Process which armed the timer or ZERO if unused. */
+    Process *process;
+
+    /** Timer identifier, chosen by the Process. */
+    u32 id;
+
+    /** Timer tick at which the timer expires. */
+    u32 expiry;
+
+    /** Interval in ticks for periodic timers or zero for one-shot timers. */
+    u32 interval;
+
+    /** Number of expirations not yet read by the Process. */
+    Size expirations;
+
+    /** True if the timer is inserted in the TimerWheel. */
+    bool armed;
+
+    /** Previous timer in the same slot. */
+    struct WheelTimer *prev;
+
+    /** Next timer in the same slot. */
+    struct WheelTimer *next;
+}
+WheelTimer;
+
+/**
+ * Hashed timing wheel.
+ *
+ * Timers are kept in the slot of their expiry tick modulo the number of slots.
+ * Arming and disarming is constant time and each timer tick only visits the
+ * timers in a single slot. Timers which expire more than one revolution
+ * ahead stay in their slot until their expiry tick is reached.
+ */
+class TimerWheel
+{
+  public:
+
+    /**
+     * Constructor.
+     */
+    TimerWheel();
+
+    /**
+     * Get the last processed tick.
+     *
+     * @return Timer tick.
+     */
+    u32 getCurrent() const;
+
+    /**
+     * Insert a timer.
+     *
+     * @param timer WheelTimer with its expiry tick set.
+     */
+    void insert(WheelTimer *timer);
+
+    /**
+     * Remove a timer.
+     *
+     * @param timer WheelTimer to remove. Ignored if not armed.
+     */
+    void remove(WheelTimer *timer);
+
+    /**
+     * Expire timers.
+     *
+     * Processes all ticks since the last call. Expired timers
+     * are reported to their Process and periodic timers are re-armed.
+     *
+     * @param ticks Current timer tick.
+     */
+    void advance(u32 ticks);
+
+  private:
+
+    /** Slots with a list of timers each. */
+    WheelTimer *m_slots[TIMERWHEEL_SLOTS];
+
+    /** Last processed tick. */
+    u32 m_current;
+};
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL_TIMERWHEEL_H */
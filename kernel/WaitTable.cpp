@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <MemoryBlock.h>
+#include "Process.h"
+#include "WaitTable.h"
+
+WaitTable::WaitTable()
+{
+    MemoryBlock::set(m_head, 0, sizeof(m_head));
+    MemoryBlock::set(m_tail, 0, sizeof(m_tail));
+}
+
+Size WaitTable::bucket(Address key) const
+{
+    // Words are aligned, mix in the page number
+    return ((key >> 2) ^ (key >> PAGESHIFT)) & (WAITTABLE_BUCKETS - 1);
+}
+
+void WaitTable::insert(Process *proc, Address key)
+{
+    Size b = bucket(key);
+
+    remove(proc);
+    proc->m_waitAddress = key;
+    proc->m_waitNext    = ZERO;
+    proc->m_waitPrev    = m_tail[b];
+
+    if (m_tail[b])
+        m_tail[b]->m_waitNext = proc;
+    else
+        m_head[b] = proc;
+
+    m_tail[b] = proc;
+}
+
+void WaitTable::remove(Process *proc)
+{
+    Size b = bucket(proc->m_waitAddress);
+
+    if (!proc->m_waitAddress)
+        return;
+
+    if (proc->m_waitPrev)
+        proc->m_waitPrev->m_waitNext = proc->m_waitNext;
+    else
+        m_head[b] = proc->m_waitNext;
+
+    if (proc->m_waitNext)
+        proc->m_waitNext->m_waitPrev = proc->m_waitPrev;
+    else
+        m_tail[b] = proc->m_waitPrev;
+
+    proc->m_waitAddress = 0;
+    proc->m_waitNext    = ZERO;
+    proc->m_waitPrev    = ZERO;
+}
+
+Size WaitTable::wake(Address key, Size count)
+{
+    Size woken = 0;
+
+    for (Process *p = m_head[bucket(key)], *next; p && woken < count; p = next)
+    {
+        next = p->m_waitNext;
+
+        if (p->m_waitAddress == key)
+        {
+            // Also removes the Process from the wait queue
+            p->wakeup();
+            woken++;
+        }
+    }
+    return woken;
+}
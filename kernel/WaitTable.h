@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __KERNEL_WAITTABLE_H
+#define __KERNEL_WAITTABLE_H
+
+#include <Types.h>
+#include <Macros.h>
+
+/** Forward declarations */
+class Process;
+
+/**
+ * @addtogroup kernel
+ * @{
+ */
+
+/** Number of buckets in the WaitTable. Must be a power of two. */
+#define WAITTABLE_BUCKETS 64
+
+/**
+ * Wait queues of Processes which sleep on a memory word.
+ *
+ * Queues are keyed by the physical address of the word, such that
+ * Processes which map the same memory at different virtual addresses
+ * wait on the same queue. Each bucket keeps its Processes in order
+ * of arrival, which wakes up the longest waiting Process first.
+ */
+class WaitTable
+{
+  public:
+
+    /**
+     * Constructor.
+     */
+    WaitTable();
+
+    /**
+     * Add a Process to the wait queue of an address.
+     *
+     * @param proc Process which is about to sleep.
+     * @param key Physical address of the word.
+     */
+    void insert(Process *proc, Address key);
+
+    /**
+     * Remove a Process from its wait queue.
+     *
+     * @param proc Process to remove. Ignored if not waiting.
+     */
+    void remove(Process *proc);
+
+    /**
+     * Wakeup Processes waiting on an address.
+     *
+     * @param key Physical address of the word.
+     * @param count Maximum number of Processes to wakeup.
+     *
+     * @return Number of Processes woken up.
+     */
+    Size wake(Address key, Size count);
+
+  private:
+
+    /**
+     * Get the bucket of an address.
+     *
+     * @param key Physical address of the word.
+     *
+     * @return Bucket index.
+     */
+    Size bucket(Address key) const;
+
+    /** First waiting Process per bucket. */
+    Process *m_head[WAITTABLE_BUCKETS];
+
+    /** Last waiting Process per bucket. */
+    Process *m_tail[WAITTABLE_BUCKETS];
+};
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL_WAITTABLE_H */
@@ -23,6 +23,7 @@
 #include <arm/ARMConstant.h>
 #include <arm/broadcom/BroadcomInterrupt.h>
 #include "ARMKernel.h"
+#include "ARMProcess.h"
 
 ARMKernel::ARMKernel(ARMInterrupt *intr,
                      CoreInfo *info)
@@ -75,10 +76,31 @@ ARMKernel::ARMKernel(ARMInterrupt *intr,
     // Set ARMCore modes
     ctrl.set(ARMControl::AlignmentFaults);
 
+#ifdef ARMV7
+    // Allow user processes to read the generic timer virtual counter
+    mcr(p15, 0, 0, c14, c1, mrc(p15, 0, 0, c14, c1) | CNTKCTL_PL0VCTEN);
+#endif
+
 #ifdef ARMV6
     ctrl.unset(ARMControl::AlignmentCorrect);
     ctrl.unset(ARMControl::BigEndian);
 #endif
+
+    // Allow access to VFP/NEON. Each Process gets the unit on first use.
+    m_fpuOwner = ZERO;
+    mcr(p15, 0, 2, c1, c0, mrc(p15, 0, 2, c1, c0) | CPACR_VFP_ACCESS);
+    isb();
+    writeFPEXC(0);
+}
+
+ARMProcess * ARMKernel::getFPUOwner() const
+{
+    return m_fpuOwner;
+}
+
+void ARMKernel::setFPUOwner(ARMProcess *proc)
+{
+    m_fpuOwner = proc;
 }
 
 void ARMKernel::interrupt(volatile CPUState state)
@@ -104,6 +126,8 @@ void ARMKernel::interrupt(volatile CPUState state)
     if (tick)
     {
         kernel->m_timer->tick();
+        kernel->updateClock();
+        kernel->expireTimers();
         next = (ARMProcess *)kernel->getProcessManager()->schedule();
         if (next)
         {
@@ -122,11 +146,31 @@ void ARMKernel::interrupt(volatile CPUState state)
 
 }
 
-void ARMKernel::undefinedInstruction(CPUState state)
+void ARMKernel::undefinedInstruction(volatile CPUState state)
 {
+    ARMKernel *kernel = (ARMKernel *) Kernel::instance;
+    ARMProcess *proc = (ARMProcess *) kernel->getProcessManager()->current();
     ARMCore core;
-    core.logException(&state);
-    FATAL("procId = " << Kernel::instance->getProcessManager()->current()->getID());
+
+    // First VFP/NEON instruction since the last context switch
+    if (!(readFPEXC() & FPEXC_EN))
+    {
+        writeFPEXC(FPEXC_EN);
+
+        if (kernel->m_fpuOwner != proc)
+        {
+            if (kernel->m_fpuOwner)
+                kernel->m_fpuOwner->saveFPU();
+
+            proc->restoreFPU();
+            kernel->m_fpuOwner = proc;
+        }
+        // Retry the instruction
+        state.pc -= 4;
+        return;
+    }
+    core.logException((CPUState *) &state);
+    FATAL("procId = " << proc->getID());
     for(;;);
 }
 
@@ -30,6 +30,7 @@
 
 /** Forward declaration */
 class ARMInterrupt;
+class ARMProcess;
 
 /**
  * @addtogroup kernel
@@ -197,6 +198,20 @@ class ARMKernel : public Kernel
     ARMKernel(ARMInterrupt *intr,
               CoreInfo *info);
 
+    /**
+     * Get the Process which owns the VFP/NEON registers.
+     *
+     * @return Process with its VFP/NEON registers loaded or ZERO if none.
+     */
+    ARMProcess * getFPUOwner() const;
+
+    /**
+     * Set the Process which owns the VFP/NEON registers.
+     *
+     * @param proc Process with its VFP/NEON registers loaded or ZERO if none.
+     */
+    void setFPUOwner(ARMProcess *proc);
+
   private:
 
     /**
@@ -216,6 +231,9 @@ class ARMKernel : public Kernel
     /**
      * Undefined instruction routine
      *
+     * Also raised on the first VFP/NEON instruction after a context switch,
+     * in which case the VFP/NEON registers are switched and the instruction is retried.
+     *
      * @param state Saved CPU register state
      */
     static void undefinedInstruction(CPUState state);
@@ -254,8 +272,8 @@ class ARMKernel : public Kernel
     /** Broadcom specific timer module */
     BroadcomTimer m_bcmTimer;
 
-    /** Interrupt number for the timer */
-    u8 m_timerIrq;
+    /** Process which has its VFP/NEON registers loaded */
+    ARMProcess *m_fpuOwner;
 };
 
 /**
@@ -18,6 +18,7 @@
 #include <FreeNOS/System.h>
 #include <Log.h>
 #include <SplitAllocator.h>
+#include "ARMKernel.h"
 #include "ARMProcess.h"
 
 #define MEMALIGN8 8
@@ -28,29 +29,39 @@ extern u8 svcStack[PAGESIZE];
 ARMProcess::ARMProcess(ProcessID id, Address entry, bool privileged, const MemoryMap &map)
     : Process(id, entry, privileged, map)
 {
+    m_fpuUsed = false;
 }
 
 Process::Result ARMProcess::initialize()
 {
-    Memory::Range range;
+    Address stackTop;
+    Result r;
 
-    // Create MMU context
-    m_memoryContext = new ARMPaging(
-        &m_map,
-        Kernel::instance->getAllocator()
-    );
+    // Threads share the MMU context of their owner
     if (!m_memoryContext)
-        return OutOfMemory;
-
-    // User stack (high memory).
-    range = m_map.range(MemoryMap::UserStack);
-    range.access = Memory::Readable | Memory::Writable | Memory::User;
-    if (Kernel::instance->getAllocator()->allocate(&range.size, &range.phys) != Allocator::Success)
-        return OutOfMemory;
+    {
+        // Create MMU context
+        m_memoryContext = new ARMPaging(
+            &m_map,
+            Kernel::instance->getAllocator()
+        );
+        if (!m_memoryContext)
+            return OutOfMemory;
+
+        // User stack (high memory).
+        if ((r = mapUserStack(&stackTop)) != Success)
+            return r;
+
+        setUserStack(stackTop - MEMALIGN8);
+    }
+    // Threads without their own user stack get one below the stack of the owner
+    else if (!m_userStack)
+    {
+        if ((r = mapUserStack(&stackTop)) != Success)
+            return r;
 
-    if (m_memoryContext->mapRange(&range) != MemoryContext::Success)
-        return MemoryMapError;
-    setUserStack(range.virt + range.size - MEMALIGN8);
+        setUserStack(stackTop - MEMALIGN8);
+    }
 
     // Fill usermode program registers
     MemoryBlock::set(&m_cpuState, 0, sizeof(m_cpuState));
@@ -64,6 +75,11 @@ Process::Result ARMProcess::initialize()
 
 ARMProcess::~ARMProcess()
 {
+    ARMKernel *kernel = (ARMKernel *) Kernel::instance;
+
+    // Our VFP/NEON registers must not be saved after we are gone
+    if (kernel->getFPUOwner() == this)
+        kernel->setFPUOwner(ZERO);
 }
 
 const CPUState * ARMProcess::cpuState() const
@@ -79,6 +95,11 @@ void ARMProcess::setCpuState(const CPUState *cpuState)
 
 void ARMProcess::execute(Process *previous)
 {
+    ARMKernel *kernel = (ARMKernel *) Kernel::instance;
+
+    // Trap on the first VFP/NEON instruction, unless our registers are still loaded
+    writeFPEXC(kernel->getFPUOwner() == this ? FPEXC_EN : 0);
+
     // Activate the memory context of this process
     m_memoryContext->activate();
 
@@ -97,3 +118,18 @@ void ARMProcess::execute(Process *previous)
                       "bx r0\n" : : "i" (sizeof(m_cpuState) - sizeof(m_cpuState.padding)) );
     }
 }
+
+void ARMProcess::saveFPU()
+{
+    ::saveFPU(&m_fpuState);
+}
+
+void ARMProcess::restoreFPU()
+{
+    if (!m_fpuUsed)
+    {
+        MemoryBlock::set(&m_fpuState, 0, sizeof(m_fpuState));
+        m_fpuUsed = true;
+    }
+    ::restoreFPU(&m_fpuState);
+}
@@ -81,10 +81,30 @@ class ARMProcess : public Process
      */
     virtual void execute(Process *previous);
 
+    /**
+     * Save the VFP/NEON registers of this Process.
+     *
+     * Called when another Process starts using the VFP/NEON unit.
+     */
+    void saveFPU();
+
+    /**
+     * Load the VFP/NEON registers of this Process.
+     *
+     * Resets the registers instead if this Process did not use them before.
+     */
+    void restoreFPU();
+
   private:
 
     /** Contains all the CPU registers for this task */
     CPUState m_cpuState;
+
+    /** Saved VFP/NEON registers. Only valid if m_fpuUsed is set. */
+    FPUState m_fpuState;
+
+    /** True if this Process used the VFP/NEON unit at least once. */
+    bool m_fpuUsed;
 };
 
 
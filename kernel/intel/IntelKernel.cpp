@@ -27,13 +27,33 @@
 #include <BootImage.h>
 #include <intel/IntelMap.h>
 #include <intel/IntelBoot.h>
+#include <intel/IntelMP.h>
 #include "IntelKernel.h"
+#include "IntelProcess.h"
 
 extern C void executeInterrupt(CPUState state)
 {
+    ProcessManager *procs = Kernel::instance->getProcessManager();
+
+    // The core which requests a shootdown holds the kernel lock
+    if (state.vector != IntelAPIC::ShootdownVector)
+    {
+        Kernel::instance->lock();
+
+        // Another core may have removed the Process meanwhile. Only
+        // exceptions and system calls (0x90) need the interrupted Process.
+        if (!procs->current() && (state.vector < IRQ(0) || state.vector == 0x90))
+            procs->schedule();
+    }
     Kernel::instance->executeIntVector(state.vector, &state);
 }
 
+extern C void leaveInterrupt(CPUState state)
+{
+    if (state.vector != IntelAPIC::ShootdownVector)
+        Kernel::instance->unlock();
+}
+
 IntelKernel::IntelKernel(CoreInfo *info)
     : Kernel(info)
 {
@@ -42,17 +62,40 @@ IntelKernel::IntelKernel(CoreInfo *info)
     IntelCore core;
     IntelPaging memContext(&map, core.readCR3(), m_alloc);
 
+    // The kernel lock is released when the first Process starts
+    MemoryBlock::set(m_fpuOwner, 0, sizeof(m_fpuOwner));
+    MemoryBlock::set(m_tss, 0, sizeof(m_tss));
+    MemoryBlock::set(m_apicId, 0, sizeof(m_apicId));
+    m_tss[0] = &kernelTss;
+    lock();
+
     // Refresh MemoryContext::current()
     memContext.activate();
 
-    // Install interruptRun() callback
-    interruptRun = ::executeInterrupt;
+    // Install interruptRun() and interruptLeave() callbacks
+    interruptRun   = ::executeInterrupt;
+    interruptLeave = ::leaveInterrupt;
 
     // Setup exception handlers
     for (int i = 0; i < 17; i++)
     {
         hookIntVector(i, exception, 0);
     }
+
+    // Switch the FPU state on first use of the FPU
+    unhookIntVector(INTEL_DEVERR, exception, 0);
+    hookIntVector(INTEL_DEVERR, fpuUnavailable, 0);
+
+    // Resolve writes to copy-on-write pages
+    unhookIntVector(INTEL_PAGEFAULT, exception, 0);
+    hookIntVector(INTEL_PAGEFAULT, pageFault, 0);
+    m_copyOnWrite = true;
+
+    // Enable the FPU and SSE. Each Process gets the FPU on first use.
+    // Kernel writes to read-only user pages fault too, which copies them on write.
+    core.writeCR0((core.readCR0() & ~INTEL_CR0_EM) | INTEL_CR0_MP |
+                   INTEL_CR0_NE | INTEL_CR0_TS | INTEL_CR0_WP);
+    core.writeCR4(core.readCR4() | INTEL_CR4_OSFXSR | INTEL_CR4_OSXMMEXCPT);
     // Setup IRQ handlers
     for (int i = 17; i < 256; i++)
     {
@@ -65,6 +108,12 @@ IntelKernel::IntelKernel(CoreInfo *info)
             hookIntVector(i, interrupt, 0);
     }
 
+    // Inter-processor interrupts between cores running this kernel
+    unhookIntVector(IntelAPIC::ShootdownVector, interrupt, 0);
+    hookIntVector(IntelAPIC::ShootdownVector, shootdownInterrupt, 0);
+    unhookIntVector(IntelAPIC::RescheduleVector, interrupt, 0);
+    hookIntVector(IntelAPIC::RescheduleVector, rescheduleInterrupt, 0);
+
     // Only core0 uses PIC and PIT.
     if (info->coreId == 0)
     {
@@ -87,6 +136,7 @@ IntelKernel::IntelKernel(CoreInfo *info)
         hookIntVector(m_apic.getInterrupt(), clocktick, 0);
 
         m_timer = &m_apic;
+        m_timerIrq = m_apic.getInterrupt() - (IRQ(0));
 
         if (m_coreInfo->timerCounter == 0)
         {
@@ -101,6 +151,7 @@ IntelKernel::IntelKernel(CoreInfo *info)
     {
         NOTICE("Using PIT timer");
         m_timer = &m_pit;
+        m_timerIrq = m_pit.getInterrupt();
 
         // Install PIT interrupt vector handler
         hookIntVector(m_intControl->getBase() +
@@ -128,6 +179,230 @@ IntelKernel::IntelKernel(CoreInfo *info)
     kernelTss.esp0   = 0;
     kernelTss.bitmap = sizeof(TSS);
     ltr(KERNEL_TSS_SEL);
+
+    // Run the kernel on all cores, if requested
+    if (m_timer == &m_apic &&
+        String(m_coreInfo->kernelCommand, false).match("* smp*"))
+    {
+        bootCores();
+    }
+}
+
+void IntelKernel::bootCores()
+{
+    IntelMP mp;
+    IntelMap map;
+    Address stack, tss;
+    CoreInfo *info = (CoreInfo *) m_alloc->toVirtual(MPINFOADDR);
+    uint self = m_apic.getIdentifier();
+    Size count = 1;
+
+    if (mp.discover() != IntelMP::Success)
+        return;
+
+    // The realmode startup code enters bootEntrySMP with the kernel of core0
+    MemoryBlock::copy(m_alloc->toVirtual(MPENTRYADDR), (void *) bootEntry16, PAGESIZE);
+    m_apicId[0] = self;
+
+    for (ListIterator<uint> i(mp.getCores()); i.hasCurrent() && count < MAX_CORES; i++)
+    {
+        if (i.current() == self)
+            continue;
+
+        // Allocate a boot stack and a TSS segment
+        if (m_alloc->allocateLow(PAGESIZE * 4, &stack) != Allocator::Success ||
+            m_alloc->allocateZero(PAGESIZE, &tss) != Allocator::Success)
+        {
+            ERROR("failed to allocate memory for core" << count);
+            break;
+        }
+        m_tss[count] = (TSS *) m_alloc->toVirtual(tss);
+        m_tss[count]->ss0    = KERNEL_DS_SEL;
+        m_tss[count]->bitmap = sizeof(TSS);
+        m_apicId[count] = i.current();
+
+        // Each core loads its own TSS segment, which defines its core_index()
+        Address tssAddr = (Address) m_tss[count];
+        gdt[KERNEL_TSS + count] = gdt[KERNEL_TSS];
+        gdt[KERNEL_TSS + count].baseLow  = (tssAddr) & 0xffff;
+        gdt[KERNEL_TSS + count].baseMid  = (tssAddr >> 16) & 0xff;
+        gdt[KERNEL_TSS + count].baseHigh = (tssAddr >> 24) & 0xff;
+        gdt[KERNEL_TSS + count].type     = 9;
+
+        // Fill the CoreInfo for the realmode startup code
+        MemoryBlock::set(info, 0, sizeof(CoreInfo));
+        info->coreId      = count;
+        info->memory.phys = m_coreInfo->memory.phys;
+        info->kernelEntry = (Address) bootEntrySMP;
+        bootStackSMP = (Address) m_alloc->toVirtual(stack) + (PAGESIZE * 4);
+
+        if (m_apic.sendStartupIPI(i.current(), MPENTRYADDR) != IntController::Success)
+            break;
+
+        // Wait at most one second until the core raises the booted flag
+        for (Size j = 0; j < 1000 && !((volatile CoreInfo *) info)->booted; j++)
+            m_apic.wait(1000);
+
+        if (!((volatile CoreInfo *) info)->booted)
+        {
+            ERROR("core" << count << " with APIC " << i.current() << " did not start");
+            break;
+        }
+        count++;
+    }
+
+    // Spread processes over all cores
+    m_coreCount = count;
+    m_procs->setCoreCount(count);
+    MemoryContext::setShootdownHandler(shootdown);
+
+    // Core0 also needs an idle Process before the idle program starts
+    IntelProcess *idle = new IntelProcess(KERNEL_PID, (Address) idleCore, true, map);
+    if (idle->initialize() == Process::Success)
+        m_procs->setIdle(idle);
+
+    NOTICE("running on " << count << " cores");
+}
+
+int IntelKernel::runCore(Size index)
+{
+    IntelMap map;
+    IntelCore core;
+
+    // Load the TSS segment first, such that core_index() is correct
+    ltr(KERNEL_TSS_SEL + (index * sizeof(Segment)));
+    lock();
+
+    // Enable the FPU, SSE and write protection, like on core0
+    core.writeCR0((core.readCR0() & ~INTEL_CR0_EM) | INTEL_CR0_MP |
+                   INTEL_CR0_NE | INTEL_CR0_TS | INTEL_CR0_WP);
+    core.writeCR4(core.readCR4() | INTEL_CR4_OSFXSR | INTEL_CR4_OSXMMEXCPT);
+
+    // Preempt processes with the APIC timer of this core
+    m_apic.initializeCore();
+    m_apic.start(m_coreInfo->timerCounter, m_pit.getFrequency());
+
+    // Idle Process of this core
+    IntelProcess *idle = new IntelProcess(KERNEL_PID, (Address) idleCore, true, map);
+    if (idle->initialize() != Process::Success)
+    {
+        FATAL("failed to create idle process for core" << index);
+        for (;;);
+    }
+    m_procs->setIdle(idle);
+
+    NOTICE("core" << index << " running");
+
+    // Never returns
+    m_procs->schedule();
+    return 0;
+}
+
+void IntelKernel::idleCore()
+{
+    // Runs without the kernel lock until interrupted
+    while (true)
+    {
+        irq_enable();
+        idle();
+    }
+}
+
+IntelProcess * IntelKernel::getFPUOwner() const
+{
+    return m_fpuOwner[core_index()];
+}
+
+void IntelKernel::setFPUOwner(IntelProcess *proc)
+{
+    m_fpuOwner[core_index()] = proc;
+}
+
+void IntelKernel::releaseFPU(IntelProcess *proc)
+{
+    for (Size i = 0; i < MAX_CORES; i++)
+        if (m_fpuOwner[i] == proc)
+            m_fpuOwner[i] = ZERO;
+}
+
+TSS * IntelKernel::getTSS()
+{
+    return m_tss[core_index()];
+}
+
+void IntelKernel::lock()
+{
+    Size core = core_index();
+
+    // Other cores do not wait for our TLB invalidation while we wait
+    m_waiting[core].store(1);
+    Kernel::lock();
+    m_waiting[core].store(0);
+
+    flushTLB();
+}
+
+void IntelKernel::rescheduleCore(Size core)
+{
+    m_apic.sendIPI(m_apicId[core], IntelAPIC::RescheduleVector);
+}
+
+void IntelKernel::executeIntVector(u32 vec, CPUState *state)
+{
+    // Other cores only use their timer to preempt processes
+    if (vec == IntelAPIC::TimerVector && core_index() != 0)
+        clocktick(state, 0);
+    else
+        Kernel::executeIntVector(vec, state);
+}
+
+void IntelKernel::shootdown(u32 cores)
+{
+    IntelKernel *kern = (IntelKernel *) Kernel::instance;
+
+    for (Size i = 0; i < kern->m_coreCount; i++)
+    {
+        if (cores & (1 << i))
+        {
+            kern->m_shootdown[i].store(1);
+            kern->m_apic.sendIPI(kern->m_apicId[i], IntelAPIC::ShootdownVector);
+        }
+    }
+
+    // Cores which wait for the kernel lock invalidate their TLB after acquiring it
+    for (Size i = 0; i < kern->m_coreCount; i++)
+    {
+        if (cores & (1 << i))
+            while (kern->m_shootdown[i].load() && !kern->m_waiting[i].load())
+                ;
+    }
+}
+
+void IntelKernel::flushTLB()
+{
+    Size core = core_index();
+
+    if (m_shootdown[core].load())
+    {
+        tlb_flush_all();
+        m_shootdown[core].store(0);
+    }
+}
+
+void IntelKernel::shootdownInterrupt(CPUState *state, ulong param)
+{
+    IntelKernel *kern = (IntelKernel *) Kernel::instance;
+
+    kern->flushTLB();
+    kern->m_apic.clear(IntelAPIC::ShootdownVector);
+}
+
+void IntelKernel::rescheduleInterrupt(CPUState *state, ulong param)
+{
+    IntelKernel *kern = (IntelKernel *) Kernel::instance;
+
+    kern->m_apic.clear(IntelAPIC::RescheduleVector);
+    kern->getProcessManager()->schedule();
 }
 
 void IntelKernel::exception(CPUState *state, ulong param)
@@ -138,11 +413,31 @@ void IntelKernel::exception(CPUState *state, ulong param)
     ERROR("Exception in Process: " << procs->current()->getID());
     core.logException(state);
 
+    // The interrupted kernel code, if any, never continues
+    Kernel::instance->unwindLock();
+
     assert(procs->current() != ZERO);
     procs->remove(procs->current());
     procs->schedule();
 }
 
+void IntelKernel::pageFault(CPUState *state, ulong param)
+{
+    IntelCore core;
+    ProcessManager *procs = Kernel::instance->getProcessManager();
+
+    // Write to a present page which may be copy-on-write, also by the kernel
+    if ((state->error & (INTEL_PAGEFAULT_PRESENT | INTEL_PAGEFAULT_WRITE)) ==
+        (INTEL_PAGEFAULT_PRESENT | INTEL_PAGEFAULT_WRITE) &&
+        procs->current() &&
+        Kernel::instance->copyOnWrite(procs->current()->getMemoryContext(),
+                                      core.readCR2()) == Kernel::Success)
+    {
+        return;
+    }
+    exception(state, param);
+}
+
 void IntelKernel::interrupt(CPUState *state, ulong param)
 {
     IntelKernel *kern = (IntelKernel *) Kernel::instance;
@@ -178,6 +473,29 @@ void IntelKernel::clocktick(CPUState *state, ulong param)
     if (irq == kern->m_apic.getInterrupt())
         kern->m_apic.clear(irq);
 
-    kern->m_timer->tick();
+    // Only core0 keeps the time, other cores only preempt
+    if (core_index() == 0)
+    {
+        kern->m_timer->tick();
+        kern->updateClock();
+        kern->expireTimers();
+    }
     kern->getProcessManager()->schedule();
 }
+
+void IntelKernel::fpuUnavailable(CPUState *state, ulong param)
+{
+    IntelKernel *kern = (IntelKernel *) Kernel::instance;
+    IntelProcess *proc = (IntelProcess *) kern->getProcessManager()->current();
+
+    clts();
+
+    if (kern->getFPUOwner() != proc)
+    {
+        if (kern->getFPUOwner())
+            kern->getFPUOwner()->saveFPU();
+
+        proc->restoreFPU();
+        kern->setFPUOwner(proc);
+    }
+}
@@ -139,8 +139,13 @@ inline ulong trapKernel5(ulong num, ulong arg1, ulong arg2, ulong arg3,
 #include <intel/IntelPIT.h>
 #include <intel/IntelPIC.h>
 #include <intel/IntelAPIC.h>
+#include <intel/IntelCore.h>
+#include <Atomic.h>
 #include <Timer.h>
 
+/** Forward declaration */
+class IntelProcess;
+
 /**
  * @addtogroup kernel
  * @{
@@ -167,8 +172,111 @@ class IntelKernel : public Kernel
      */
     IntelKernel(CoreInfo *info);
 
+    /**
+     * Get the Process which owns the FPU registers of the executing core.
+     *
+     * @return Process with its FPU/SSE registers loaded or ZERO if none.
+     */
+    IntelProcess * getFPUOwner() const;
+
+    /**
+     * Set the Process which owns the FPU registers of the executing core.
+     *
+     * @param proc Process with its FPU/SSE registers loaded or ZERO if none.
+     */
+    void setFPUOwner(IntelProcess *proc);
+
+    /**
+     * Forget a Process as owner of the FPU registers on all cores.
+     *
+     * @param proc Process which is removed.
+     */
+    void releaseFPU(IntelProcess *proc);
+
+    /**
+     * Get the Task State Segment of the executing core.
+     *
+     * @return TSS pointer.
+     */
+    TSS * getTSS();
+
+    /**
+     * Acquire the kernel lock.
+     *
+     * Also invalidates the TLB if another core requested it meanwhile.
+     */
+    virtual void lock();
+
+    /**
+     * Let another core select a new Process to run.
+     *
+     * @param core Core index.
+     */
+    virtual void rescheduleCore(Size core);
+
+    /**
+     * Execute an interrupt handler.
+     *
+     * @param vec Interrupt vector.
+     * @param state CPU state.
+     */
+    virtual void executeIntVector(u32 vec, CPUState *state);
+
+    /**
+     * Run the kernel on another core than core0.
+     *
+     * @param index Core index.
+     *
+     * @return Never returns.
+     */
+    int runCore(Size index);
+
   private:
 
+    /**
+     * Start the other cores in this kernel.
+     *
+     * Only used if the kernel command line contains "smp".
+     */
+    void bootCores();
+
+    /**
+     * Invalidate the TLB of other cores.
+     *
+     * Waits until each core invalidated its TLB or waits for the kernel lock.
+     *
+     * @param cores Bitmask of core indexes.
+     */
+    static void shootdown(u32 cores);
+
+    /**
+     * Invalidate the TLB of the executing core, if another core requested it.
+     */
+    void flushTLB();
+
+    /**
+     * TLB shootdown interrupt handler.
+     *
+     * Runs without the kernel lock, which is held by the requesting core.
+     *
+     * @param state CPU registers on time of interrupt.
+     * @param param Not used.
+     */
+    static void shootdownInterrupt(CPUState *state, ulong param);
+
+    /**
+     * Reschedule interrupt handler.
+     *
+     * @param state CPU registers on time of interrupt.
+     * @param param Not used.
+     */
+    static void rescheduleInterrupt(CPUState *state, ulong param);
+
+    /**
+     * Idle loop of other cores than core0.
+     */
+    static void idleCore();
+
     /**
      * Called when the CPU detects a fault.
      *
@@ -177,6 +285,17 @@ class IntelKernel : public Kernel
      */
     static void exception(CPUState *state, ulong param);
 
+    /**
+     * Page fault handler.
+     *
+     * Resolves writes to copy-on-write pages and treats
+     * any other page fault as an exception.
+     *
+     * @param state CPU registers on time of the page fault.
+     * @param param Not used.
+     */
+    static void pageFault(CPUState *state, ulong param);
+
     /**
      * Default interrupt handler.
      *
@@ -201,6 +320,18 @@ class IntelKernel : public Kernel
      */
     static void clocktick(CPUState *state, ulong param);
 
+    /**
+     * Device-not-available handler.
+     *
+     * Raised on the first FPU/SSE instruction after a context switch.
+     * Saves the FPU registers of the previous owner and loads those
+     * of the current Process.
+     *
+     * @param state CPU registers on time of the exception.
+     * @param param Not used.
+     */
+    static void fpuUnavailable(CPUState *state, ulong param);
+
   private:
 
     /** PIT timer instance */
@@ -211,6 +342,21 @@ class IntelKernel : public Kernel
 
     /** PIC instance */
     IntelPIC m_pic;
+
+    /** Process which has its FPU/SSE registers loaded on each core */
+    IntelProcess *m_fpuOwner[MAX_CORES];
+
+    /** Task State Segment of each core */
+    TSS *m_tss[MAX_CORES];
+
+    /** APIC identifier of each core */
+    uint m_apicId[MAX_CORES];
+
+    /** Set for each core which must invalidate its TLB */
+    Atomic<u32> m_shootdown[MAX_CORES];
+
+    /** Set for each core which waits for the kernel lock */
+    Atomic<u32> m_waiting[MAX_CORES];
 };
 
 /**
@@ -20,38 +20,49 @@
 #include <Memory.h>
 #include <SplitAllocator.h>
 #include <intel/IntelPaging.h>
+#include "IntelKernel.h"
 #include "IntelProcess.h"
 
 IntelProcess::IntelProcess(ProcessID id, Address entry, bool privileged, const MemoryMap &map)
     : Process(id, entry, privileged, map)
 {
+    m_fpuState = (FPUState *) (((Address) m_fpuBuffer + 15) & ~15);
+    m_fpuUsed  = false;
 }
 
 Process::Result IntelProcess::initialize()
 {
-    Address stackSize, stackAddr;
-    Memory::Range range;
+    Address stackSize, stackAddr, stackTop;
     CPUState *regs;
+    Result r;
     u16 dataSel = m_privileged ? KERNEL_DS_SEL : USER_DS_SEL;
     u16 codeSel = m_privileged ? KERNEL_CS_SEL : USER_CS_SEL;
 
-    // Create MMU context
-    m_memoryContext = new IntelPaging(
-        &m_map,
-        Kernel::instance->getAllocator()
-    );
+    // Threads share the MMU context of their owner
     if (!m_memoryContext)
-        return OutOfMemory;
-
-    // User stack (high memory).
-    range = m_map.range(MemoryMap::UserStack);
-    range.access = Memory::Readable | Memory::Writable | Memory::User;
-    if (Kernel::instance->getAllocator()->allocate(&range.size, &range.phys) != Allocator::Success)
-        return OutOfMemory;
-
-    if (m_memoryContext->mapRange(&range) != MemoryContext::Success)
-        return MemoryMapError;
-    setUserStack(range.virt + range.size - MEMALIGN);
+    {
+        // Create MMU context
+        m_memoryContext = new IntelPaging(
+            &m_map,
+            Kernel::instance->getAllocator()
+        );
+        if (!m_memoryContext)
+            return OutOfMemory;
+
+        // User stack (high memory).
+        if ((r = mapUserStack(&stackTop)) != Success)
+            return r;
+
+        setUserStack(stackTop - MEMALIGN);
+    }
+    // Threads without their own user stack get one below the stack of the owner
+    else if (!m_userStack)
+    {
+        if ((r = mapUserStack(&stackTop)) != Success)
+            return r;
+
+        setUserStack(stackTop - MEMALIGN);
+    }
 
     // Kernel stack (low memory).
     stackSize = KernelStackSize;
@@ -100,6 +111,11 @@ Process::Result IntelProcess::initialize()
 
 IntelProcess::~IntelProcess()
 {
+    IntelKernel *kernel = (IntelKernel *) Kernel::instance;
+
+    // Our FPU registers must not be saved after we are gone
+    kernel->releaseFPU(this);
+
     // Release the kernel stack memory page
     SplitAllocator *alloc = Kernel::instance->getAllocator();
     alloc->release((Address)alloc->toPhysical(m_kernelStackBase) - KernelStackSize);
@@ -108,9 +124,25 @@ IntelProcess::~IntelProcess()
 void IntelProcess::execute(Process *previous)
 {
     IntelProcess *p = (IntelProcess *) previous;
+    IntelKernel *kernel = (IntelKernel *) Kernel::instance;
+    IntelCore core;
+    u32 cr0 = core.readCR0(), next;
+
+    // The previous Process may continue on another core, which needs its FPU registers
+    if (kernel->getCoreCount() > 1 && p && kernel->getFPUOwner() == p)
+    {
+        p->saveFPU();
+        kernel->setFPUOwner(ZERO);
+    }
+    next = kernel->getFPUOwner() == this ? cr0 & ~INTEL_CR0_TS
+                                         : cr0 | INTEL_CR0_TS;
+
+    // Trap on the first FPU/SSE instruction, unless our registers are still loaded
+    if (next != cr0)
+        core.writeCR0(next);
 
     // Reload Task State Register (with kernel stack for interrupts)
-    kernelTss.esp0 = m_kernelStackBase;
+    kernel->getTSS()->esp0 = m_kernelStackBase;
 
     // Activate the memory context of this process
     m_memoryContext->activate();
@@ -119,3 +151,19 @@ void IntelProcess::execute(Process *previous)
     switchCoreState( p ? &p->m_kernelStack : ZERO,
                      m_kernelStack );
 }
+
+void IntelProcess::saveFPU()
+{
+    fxsave(m_fpuState);
+}
+
+void IntelProcess::restoreFPU()
+{
+    if (m_fpuUsed)
+        fxrstor(m_fpuState);
+    else
+    {
+        fninit();
+        m_fpuUsed = true;
+    }
+}
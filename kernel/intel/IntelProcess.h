@@ -19,6 +19,7 @@
 #define __INTEL_PROCESS_H
 
 #include <FreeNOS/Process.h>
+#include <intel/IntelCore.h>
 #include <Types.h>
 
 /**
@@ -72,6 +73,31 @@ class IntelProcess : public Process
      * Saves and restores registers, then perform a context switch.
      */
     virtual void execute(Process *previous);
+
+    /**
+     * Save the FPU/SSE registers of this Process.
+     *
+     * Called when another Process starts using the FPU.
+     */
+    void saveFPU();
+
+    /**
+     * Load the FPU/SSE registers of this Process.
+     *
+     * Resets the FPU instead if this Process did not use it before.
+     */
+    void restoreFPU();
+
+  private:
+
+    /** Storage for the FPU/SSE registers. Heap objects are not 16-byte aligned. */
+    u8 m_fpuBuffer[sizeof(FPUState) + 15];
+
+    /** Saved FPU/SSE registers inside m_fpuBuffer. Only valid if m_fpuUsed is set. */
+    FPUState *m_fpuState;
+
+    /** True if this Process used the FPU at least once. */
+    bool m_fpuUsed;
 };
 
 namespace Arch
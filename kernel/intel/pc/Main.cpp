@@ -45,3 +45,11 @@ extern C int kernel_main(CoreInfo *info)
     IntelKernel *kernel = new IntelKernel(info);
     return kernel->run();
 }
+
+extern C int kernel_smp_main(Size index)
+{
+    IntelKernel *kernel = (IntelKernel *) Kernel::instance;
+
+    // Run the kernel of core0 on this core
+    return kernel->runCore(index);
+}
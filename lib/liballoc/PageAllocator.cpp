@@ -62,10 +62,7 @@ Allocator::Result PageAllocator::allocate(Size *size, Address *addr, Size align)
     range.access = Memory::User | Memory::Readable | Memory::Writable;
     range.virt   = m_base + m_allocated;
     range.phys   = ZERO;
-    VMCtl(SELF, Map, &range);
-
-    // Clear the pages
-    MemoryBlock::set((void *) range.virt, 0, range.size);
+    VMCtl(SELF, MapZero, &range);
 
     // Update count
     m_allocated += range.size; 
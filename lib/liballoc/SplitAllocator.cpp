@@ -16,6 +16,7 @@
  */
 
 #include <FreeNOS/System.h>
+#include <BitArray.h>
 #include "SplitAllocator.h"
 
 SplitAllocator::SplitAllocator(Memory::Range low, Memory::Range high)
@@ -27,11 +28,17 @@ SplitAllocator::SplitAllocator(Memory::Range low, Memory::Range high)
     mem.size += high.size;
 
     m_alloc = new BitAllocator(mem, PAGESIZE);
+
+    // Only the kernel mapped part of lower memory can be cleared in advance
+    m_zeroed     = new BitArray((high.phys - low.phys) / PAGESIZE);
+    m_zeroCount  = 0;
+    m_zeroCursor = 0;
 }
 
 SplitAllocator::~SplitAllocator()
 {
     delete m_alloc;
+    delete m_zeroed;
 }
 
 Size SplitAllocator::size() const
@@ -56,12 +63,22 @@ Allocator::Result SplitAllocator::allocate(Size *size, Address *addr, Size align
 
 Allocator::Result SplitAllocator::allocate(Address addr)
 {
-    return m_alloc->allocate(addr);
+    Result r = m_alloc->allocate(addr);
+
+    if (r == Success)
+        takeZeroPool(addr, PAGESIZE);
+
+    return r;
 }
 
 Allocator::Result SplitAllocator::allocateLow(Size size, Address *addr, Size align)
 {
-    return m_alloc->allocate(&size, addr, align, 0);
+    Result r = m_alloc->allocate(&size, addr, align, 0);
+
+    if (r == Success)
+        takeZeroPool(*addr, size);
+
+    return r;
 }
 
 Allocator::Result SplitAllocator::allocateHigh(Size size, Address *addr, Size align)
@@ -69,8 +86,74 @@ Allocator::Result SplitAllocator::allocateHigh(Size size, Address *addr, Size al
     return m_alloc->allocate(&size, addr, align, m_high.phys - m_alloc->base());
 }
 
+Allocator::Result SplitAllocator::allocateZero(Size size, Address *addr, Size align)
+{
+    Result r = m_alloc->allocate(&size, addr, align, 0);
+
+    if (r != Success)
+        return r;
+
+    // Only clear the pages which did not come from the zero pool
+    for (Size i = 0; i < size; i += PAGESIZE)
+        if (!takeZeroPool(*addr + i, PAGESIZE))
+            zero_page(toVirtual(*addr + i));
+
+    return Success;
+}
+
+Size SplitAllocator::fillZeroPool(Size count)
+{
+    Size pages = m_zeroed->size(), filled = 0;
+
+    for (Size i = 0; i < ZEROPOOL_SCAN && i < pages &&
+                     filled < count && m_zeroCount < ZEROPOOL_SIZE; i++)
+    {
+        Address page = m_low.phys + (m_zeroCursor * PAGESIZE);
+
+        if (!m_zeroed->isSet(m_zeroCursor) && !m_alloc->isAllocated(page))
+        {
+            zero_page(toVirtual(page));
+            m_zeroed->set(m_zeroCursor);
+            m_zeroCount++;
+            filled++;
+        }
+        if (++m_zeroCursor == pages)
+            m_zeroCursor = 0;
+    }
+    return filled;
+}
+
+Size SplitAllocator::getZeroPool() const
+{
+    return m_zeroCount;
+}
+
+Size SplitAllocator::takeZeroPool(Address addr, Size size)
+{
+    Size taken = 0;
+
+    for (Size i = 0; i < size; i += PAGESIZE)
+    {
+        Size page = (addr + i - m_low.phys) / PAGESIZE;
+
+        if (addr + i >= m_low.phys && page < m_zeroed->size() && m_zeroed->isSet(page))
+        {
+            m_zeroed->unset(page);
+            m_zeroCount--;
+            taken++;
+        }
+    }
+    return taken;
+}
+
 Allocator::Result SplitAllocator::release(Address addr)
 {
+    Size page = (addr - m_low.phys) / PAGESIZE;
+
+    // Let fillZeroPool() clear the lowest free pages first, which are allocated first
+    if (addr >= m_low.phys && page < m_zeroCursor)
+        m_zeroCursor = page;
+
     return m_alloc->release(addr);
 }
 
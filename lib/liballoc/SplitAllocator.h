@@ -22,6 +22,9 @@
 #include "Allocator.h"
 #include "BitAllocator.h"
 
+/** Forward declarations */
+class BitArray;
+
 /**
  * @addtogroup lib
  * @{
@@ -30,8 +33,19 @@
  * @{
  */
 
+/** Maximum number of free pages kept zeroed in lower memory. */
+#define ZEROPOOL_SIZE 256
+
+/** Maximum number of pages inspected per call to SplitAllocator::fillZeroPool(). */
+#define ZEROPOOL_SCAN 1024
+
 /**
  * Allocator which separates kernel mapped low-memory and higher memory.
+ *
+ * Free pages in lower memory can be cleared ahead of time with
+ * fillZeroPool(), normally while the system is idle. Those pages
+ * form a pool of pre-zeroed pages which allocateZero() does not
+ * need to clear again. All other allocation functions do not clear memory.
  */
 class SplitAllocator : public Allocator
 {
@@ -110,6 +124,36 @@ class SplitAllocator : public Allocator
      */
     virtual Result allocateHigh(Size size, Address *addr, Size align = ZERO);
 
+    /**
+     * Allocate cleared lower memory.
+     *
+     * @param size Amount of memory in bytes to allocate.
+     * @param addr Output parameter which contains the address
+     *             allocated on success.
+     * @param align Alignment of the required memory or use ZERO for default.
+     *
+     * @return Result code
+     */
+    Result allocateZero(Size size, Address *addr, Size align = ZERO);
+
+    /**
+     * Clear free lower memory pages ahead of time.
+     *
+     * Must not be interrupted by allocations or releases.
+     *
+     * @param count Maximum number of pages to clear.
+     *
+     * @return Number of pages cleared.
+     */
+    Size fillZeroPool(Size count);
+
+    /**
+     * Get the number of free pages which are already cleared.
+     *
+     * @return Number of pages in the zero pool.
+     */
+    Size getZeroPool() const;
+
     /**
      * Release memory.
      *
@@ -131,6 +175,18 @@ class SplitAllocator : public Allocator
      */
     void * toPhysical(Address virt) const;
 
+  private:
+
+    /**
+     * Remove pages from the zero pool, if present.
+     *
+     * @param addr Physical address of the first page.
+     * @param size Number of bytes.
+     *
+     * @return Number of pages which were in the zero pool.
+     */
+    Size takeZeroPool(Address addr, Size size);
+
   private:
 
     /** Physical memory allocator. */
@@ -141,6 +197,15 @@ class SplitAllocator : public Allocator
 
     /** High memory */
     Memory::Range m_high;
+
+    /** Marks free lower memory pages which are cleared. */
+    BitArray *m_zeroed;
+
+    /** Number of pages in the zero pool. */
+    Size m_zeroCount;
+
+    /** Next page to inspect in fillZeroPool(). */
+    Size m_zeroCursor;
 };
 
 /**
@@ -73,7 +73,8 @@ typedef enum BootSymbolType
 {
     BootProgram    = 0,    /**< Executable program */
     BootFilesystem = 1,    /**< Embedded filesystem */
-    BootData       = 2     /**< Binary data */
+    BootData       = 2,    /**< Binary data */
+    BootLibrary    = 3     /**< Shared library */
 }
 BootSymbolType;
 
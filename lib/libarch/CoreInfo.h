@@ -28,6 +28,9 @@
 
 #define KERNEL_PATHLEN 64
 
+/** Maximum number of cores which run a single kernel. */
+#define MAX_CORES 8
+
 /** Needed by IntelBoot16.S. Depends on sizeof(Memory::Access) which is an emum */
 #define COREINFO_SIZE  (KERNEL_PATHLEN + (8 * 4) + (4 * 4) + (4 * 4))
 
@@ -44,7 +44,8 @@ namespace Memory
         Uncached    = 1 << 4,
         InnerCached = 1 << 5,
         OuterCached = 1 << 6,
-        Device      = 1 << 7
+        Device      = 1 << 7,
+        CopyOnWrite = 1 << 8
     }
     Access;
 
@@ -19,21 +19,51 @@
 #include <SplitAllocator.h>
 #include "MemoryContext.h"
 
-MemoryContext * MemoryContext::m_current = 0;
+MemoryContext * MemoryContext::m_current[MAX_CORES];
+
+MemoryContext::ShootdownHandler * MemoryContext::m_shootdown = 0;
 
 MemoryContext::MemoryContext(MemoryMap *map, SplitAllocator *alloc)
     : m_alloc(alloc)
     , m_map(map)
+    , m_cores(0)
 {
 }
 
 MemoryContext::~MemoryContext()
 {
+    for (Size i = 0; i < MAX_CORES; i++)
+        if (m_current[i] == this)
+            m_current[i] = 0;
 }
 
 MemoryContext * MemoryContext::getCurrent()
 {
-    return m_current;
+    return m_current[core_index()];
+}
+
+void MemoryContext::setShootdownHandler(ShootdownHandler *handler)
+{
+    m_shootdown = handler;
+}
+
+void MemoryContext::setCurrent()
+{
+    Size core = core_index();
+
+    if (m_current[core])
+        m_current[core]->m_cores &= ~(1 << core);
+
+    m_current[core] = this;
+    m_cores |= (1 << core);
+}
+
+void MemoryContext::shootdown()
+{
+    u32 others = m_cores & ~(1 << core_index());
+
+    if (others && m_shootdown)
+        m_shootdown(others);
 }
 
 MemoryContext::Result MemoryContext::mapRange(Memory::Range *range)
@@ -23,6 +23,7 @@
 #include <BitOperations.h>
 #include "Memory.h"
 #include "MemoryMap.h"
+#include "CoreInfo.h"
 
 /** Forward declaration */
 class SplitAllocator;
@@ -55,6 +56,13 @@ class MemoryContext
     }
     Result;
 
+    /**
+     * Invalidates the TLBs of other cores.
+     *
+     * @param cores Bitmask of core indexes which must invalidate their TLBs.
+     */
+    typedef void ShootdownHandler(u32 cores);
+
     /**
      * Constructor.
      *
@@ -74,6 +82,15 @@ class MemoryContext
      */
     static MemoryContext * getCurrent();
 
+    /**
+     * Set the handler which invalidates the TLBs of other cores.
+     *
+     * Only needed if a single kernel runs on multiple cores.
+     *
+     * @param handler Handler function.
+     */
+    static void setShootdownHandler(ShootdownHandler *handler);
+
     /**
      * Activate the MemoryContext.
      *
@@ -188,6 +205,22 @@ class MemoryContext
      */
     virtual Result findFree(Size size, MemoryMap::Region region, Address *virt) const;
 
+  protected:
+
+    /**
+     * Make this the current MemoryContext of the executing core.
+     *
+     * Must be called by activate().
+     */
+    void setCurrent();
+
+    /**
+     * Invalidate the TLBs of other cores which have this MemoryContext active.
+     *
+     * Must be called after changing or removing a mapping.
+     */
+    void shootdown();
+
   protected:
 
     /** Physical memory allocator */
@@ -196,8 +229,14 @@ class MemoryContext
     /** Virtual memory layout */
     MemoryMap *m_map;
 
-    /** The currently active MemoryContext */
-    static MemoryContext *m_current;
+    /** Cores which have this MemoryContext active, one bit per core index. */
+    u32 m_cores;
+
+    /** The currently active MemoryContext of each core */
+    static MemoryContext *m_current[MAX_CORES];
+
+    /** Invalidates the TLBs of other cores, if any. */
+    static ShootdownHandler *m_shootdown;
 };
 
 /**
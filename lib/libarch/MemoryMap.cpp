@@ -31,6 +31,8 @@ MemoryMap::MemoryMap(const MemoryMap &map)
     setRange(UserPrivate,   map.m_regions[UserPrivate]);
     setRange(UserShare,     map.m_regions[UserShare]);
     setRange(UserArgs,      map.m_regions[UserArgs]);
+    setRange(UserClock,     map.m_regions[UserClock]);
+    setRange(UserMounts,    map.m_regions[UserMounts]);
 }
 
 Memory::Range MemoryMap::range(MemoryMap::Region region) const
@@ -28,7 +28,7 @@
  * @{
  */
 
-#define MEMORYMAP_MAX_REGIONS 8
+#define MEMORYMAP_MAX_REGIONS 11
 
 /**
  * Describes virtual memory map layout
@@ -56,7 +56,10 @@ class MemoryMap
         UserStack,     /**<< User stack */
         UserPrivate,   /**<< User private dynamic memory mappings */
         UserShare,     /**<< User shared dynamic memory mappings */
-        UserArgs       /**<< Used for copying program arguments and file descriptors */
+        UserArgs,      /**<< Used for copying program arguments and file descriptors */
+        UserClock,     /**<< Read-only kernel clock page, shared by all processes */
+        UserMounts,    /**<< Read-only filesystem mounts page, published by sysfs */
+        UserLibrary    /**<< Shared runtime library of dynamically linked programs */
     }
     Region;
 
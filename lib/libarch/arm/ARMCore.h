@@ -98,12 +98,23 @@
     asm volatile("mcrr " QUOTE(coproc) ", " QUOTE(opcode1) ", %Q0, %R0, " QUOTE(CRm) "\n" : : "r"(val) : "memory"); \
 })
 
+#ifdef ARMV7
+/**
+ * Reads the CPU's timestamp counter.
+ *
+ * Uses the virtual count register of the ARM Generic Timer.
+ *
+ * @return 64-bit integer.
+ */
+#define timestamp() mrrc(p15, 1, c14)
+#else
 /**
  * Reads the CPU's timestamp counter.
  *
  * @return 64-bit integer.
  */
 #define timestamp() 0
+#endif /* ARMV7 */
 
 /**
  * Reboot the system
@@ -124,6 +135,35 @@
 #define idle() \
     asm volatile ("wfi")
 
+/**
+ * Get the index of the executing core.
+ *
+ * The ARM kernel only runs on the boot core.
+ *
+ * @return Core index, always zero.
+ */
+#define core_index() ((Size) 0)
+
+/**
+ * Clear a page of memory with multiple register stores.
+ *
+ * @param addr Page aligned virtual address.
+ */
+#define zero_page(addr) \
+({ \
+    Address _dst = (Address) (addr); \
+    Address _end = _dst + PAGESIZE; \
+    asm volatile ("mov r4, #0\n" \
+                  "mov r5, #0\n" \
+                  "mov r6, #0\n" \
+                  "mov r7, #0\n" \
+                  "1: stmia %0!, {r4-r7}\n" \
+                  "stmia %0!, {r4-r7}\n" \
+                  "cmp %0, %1\n" \
+                  "bne 1b\n" \
+                  : "+r" (_dst) : "r" (_end) : "r4", "r5", "r6", "r7", "cc", "memory"); \
+})
+
 #ifdef ARMV6
 /**
  * Flush the entire Translation Lookaside Buffer.
@@ -209,6 +249,88 @@ inline void isb()
 #endif
 }
 
+/**
+ * @name ARM VFP/NEON registers
+ * @{
+ */
+
+/** Full access to coprocessors 10 and 11 (VFP/NEON) in the CPACR */
+#define CPACR_VFP_ACCESS (0xf << 20)
+
+/** Enables the VFP/NEON unit in FPEXC */
+#define FPEXC_EN         (1 << 30)
+
+/**
+ * @}
+ */
+
+/**
+ * VFP/NEON registers.
+ *
+ * ARMv6 only uses the first 16 double registers.
+ */
+typedef struct FPUState
+{
+    u64 d[32];
+    u32 fpscr;
+}
+ALIGN(8) FPUState;
+
+/**
+ * Read the VFP exception register (FPEXC).
+ */
+inline u32 readFPEXC()
+{
+    u32 val;
+    asm volatile (".fpu vfp\n"
+                  "vmrs %0, fpexc\n" : "=r"(val) :: "memory");
+    return val;
+}
+
+/**
+ * Write the VFP exception register (FPEXC).
+ */
+inline void writeFPEXC(u32 val)
+{
+    asm volatile (".fpu vfp\n"
+                  "vmsr fpexc, %0\n" :: "r"(val) : "memory");
+}
+
+/**
+ * Save the VFP/NEON registers.
+ *
+ * @param state Destination of the registers.
+ */
+inline void saveFPU(FPUState *state)
+{
+    u32 fpscr;
+
+    asm volatile (".fpu vfp\n"
+                  "vstmia %1, {d0-d15}\n"
+                  "vmrs %0, fpscr\n" : "=r"(fpscr) : "r"(state->d) : "memory");
+    state->fpscr = fpscr;
+#ifdef ARMV7
+    asm volatile (".fpu neon\n"
+                  "vstmia %0, {d16-d31}\n" :: "r"(state->d + 16) : "memory");
+#endif
+}
+
+/**
+ * Load the VFP/NEON registers.
+ *
+ * @param state Source of the registers.
+ */
+inline void restoreFPU(const FPUState *state)
+{
+    asm volatile (".fpu vfp\n"
+                  "vldmia %0, {d0-d15}\n"
+                  "vmsr fpscr, %1\n" :: "r"(state->d), "r"(state->fpscr) : "memory");
+#ifdef ARMV7
+    asm volatile (".fpu neon\n"
+                  "vldmia %0, {d16-d31}\n" :: "r"(state->d + 16) : "memory");
+#endif
+}
+
 /** 
  * Contains all the CPU registers.
  */
@@ -136,11 +136,9 @@ MemoryContext::Result ARMFirstTable::map(Address virt,
             return MemoryContext::AlreadyExists;
 
         // Allocate a new page table
-        if (alloc->allocateLow(sizeof(ARMSecondTable), &addr) != Allocator::Success)
+        if (alloc->allocateZero(PAGESIZE, &addr) != Allocator::Success)
             return MemoryContext::OutOfMemory;
 
-        MemoryBlock::set(alloc->toVirtual(addr), 0, PAGESIZE);
-
         // Assign to the page directory. Do not assign permission flags (only for direct sections).
         m_tables[ DIRENTRY(virt) ] = addr | PAGE1_TABLE;
         cache.cleanData(&m_tables[DIRENTRY(virt)]);
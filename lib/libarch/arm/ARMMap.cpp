@@ -17,6 +17,7 @@
 
 #include <MemoryBlock.h>
 #include <Memory.h>
+#include "ARMConstant.h"
 #include "ARMMap.h"
 
 ARMMap::ARMMap()
@@ -40,7 +41,7 @@ ARMMap::ARMMap()
     m_regions[UserHeap].size      = MegaByte(256);
 
     m_regions[UserStack].virt     = 0xc0000000;
-    m_regions[UserStack].size     = KiloByte(16);
+    m_regions[UserStack].size     = MegaByte(1);
 
     m_regions[UserPrivate].virt   = 0xa0000000;
     m_regions[UserPrivate].size   = MegaByte(256);
@@ -50,4 +51,13 @@ ARMMap::ARMMap()
 
     m_regions[UserArgs].virt      = 0xe0000000;
     m_regions[UserArgs].size      = KiloByte(128);
+
+    m_regions[UserClock].virt     = 0xe0400000;
+    m_regions[UserClock].size     = PAGESIZE;
+
+    m_regions[UserMounts].virt    = 0xe0401000;
+    m_regions[UserMounts].size    = PAGESIZE;
+
+    m_regions[UserLibrary].virt   = 0x90000000;
+    m_regions[UserLibrary].size   = MegaByte(256);
 }
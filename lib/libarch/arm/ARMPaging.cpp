@@ -28,15 +28,12 @@ ARMPaging::ARMPaging(MemoryMap *map, SplitAllocator *alloc)
     : MemoryContext(map, alloc)
 {
     // Allocate page directory from low physical memory.
-    if (alloc->allocateLow(sizeof(ARMFirstTable),
-                          &m_firstTableAddr,
-                           sizeof(ARMFirstTable)) == Allocator::Success)
+    if (alloc->allocateZero(sizeof(ARMFirstTable),
+                            &m_firstTableAddr,
+                            sizeof(ARMFirstTable)) == Allocator::Success)
     {
         m_firstTable = (ARMFirstTable *) alloc->toVirtual(m_firstTableAddr);
 
-        // Initialize the page directory
-        MemoryBlock::set(m_firstTable, 0, sizeof(ARMFirstTable));
-
         // Map the kernel. The kernel has permanently mapped 1GB of
         // physical memory (i.e. the "low memory" in SplitAllocator). The low
         // memory starts at its physical base address offset (varies per core).
@@ -185,7 +182,7 @@ MemoryContext::Result ARMPaging::activate()
         isb();
     }
     // Done. Update currently active context pointer
-    m_current = this;
+    setCurrent();
     return Success;
 }
 
@@ -195,7 +192,7 @@ MemoryContext::Result ARMPaging::map(Address virt, Address phys, Memory::Access
     Result r = m_firstTable->map(virt, phys, acc, m_alloc);
 
     // Flush the TLB to refresh the mapping
-    if (m_current == this)
+    if (getCurrent() == this)
         tlb_invalidate(virt);
 
     // Synchronize execution stream.
@@ -206,14 +203,14 @@ MemoryContext::Result ARMPaging::map(Address virt, Address phys, Memory::Access
 MemoryContext::Result ARMPaging::unmap(Address virt)
 {
     // Clean the given data page in cache
-    if (m_current == this)
+    if (getCurrent() == this)
         m_cache.cleanInvalidateAddress(Cache::Data, virt);
 
     // Modify page tables
     Result r = m_firstTable->unmap(virt, m_alloc);
 
     // Flush TLB to refresh the mapping
-    if (m_current == this)
+    if (getCurrent() == this)
         tlb_invalidate(virt);
 
     // Synchronize execution stream
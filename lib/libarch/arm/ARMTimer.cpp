@@ -23,7 +23,7 @@
 #define CNTP_CTL_ENABLE  (1 << 0)
 
 ARMTimer::ARMTimer()
-    : m_frequency(0)
+    : Timer()
 {
 }
 
@@ -45,12 +45,14 @@ void ARMTimer::setPL1Control(u32 value)
 ARMTimer::Result ARMTimer::setFrequency(Size hertz)
 {
     m_frequency = hertz;
-    tick();
+    setPL1TimerValue(getSystemFrequency() / m_frequency);
+    setPL1Control(CNTP_CTL_ENABLE);
     return Success;
 }
 
 ARMTimer::Result ARMTimer::tick()
 {
+    m_info.ticks++;
     setPL1TimerValue(getSystemFrequency() / m_frequency);
     setPL1Control(CNTP_CTL_ENABLE);
     return Success;
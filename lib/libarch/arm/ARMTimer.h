@@ -36,6 +36,9 @@
 /** PhysicalTimer1, IRQ number. */
 #define GTIMER_PHYS_1_IRQ 3
 
+/** Timer PL1 Control register: allow PL0 access to the virtual counter. */
+#define CNTKCTL_PL0VCTEN (1 << 1)
+
 /**
  * ARM Generic Timer.
  *
@@ -89,10 +92,6 @@ class ARMTimer : public Timer
      * @param value New timer control value
      */
     void setPL1Control(u32 value);
-
-  private:
-
-    Size m_frequency;
 };
 
 /**
@@ -32,6 +32,8 @@
 #define APIC_DEST_ASSERT        0x04000
 #define APIC_DEST_DM_INIT       0x00500
 #define APIC_DEST_DM_STARTUP    0x00600
+#define APIC_DEST_DM_FIXED      0x00000
+#define APIC_DEST_PENDING       0x01000
 
 IntelAPIC::IntelAPIC()
     : IntController()
@@ -51,6 +53,11 @@ uint IntelAPIC::getCounter() const
     return m_io.read(InitialCount);
 }
 
+uint IntelAPIC::getIdentifier() const
+{
+    return m_io.read(Identifier) >> 24;
+}
+
 Timer::Result IntelAPIC::start(IntelPIT *pit)
 {
     u32 t1, t2, ic, loops = 20;
@@ -114,19 +121,23 @@ Timer::Result IntelAPIC::wait(u32 microseconds) const
     }
     else
     {
-        Size usecPerInt = 1000000 / m_frequency;
-        Size usecPerTick = usecPerInt / m_io.read(InitialCount);
+        // The counter decrements initial count times per interrupt
+        u32 initial = m_io.read(InitialCount);
+        u32 ticksPerUsec = (initial * m_frequency) / 1000000;
+        u32 ticks = (ticksPerUsec ? ticksPerUsec : 1) * microseconds;
         u32 t1 = m_io.read(CurrentCount), t2;
         u32 waited = 0;
 
-        while (waited < microseconds)
+        while (waited < ticks)
         {
             t2 = m_io.read(CurrentCount);
-            if (t2 < t1)
-            {
-                waited += (t1 - t2) * usecPerTick;
-                t1 = t2;
-            }
+
+            // The counter restarts at the initial count when it reaches zero
+            if (t2 <= t1)
+                waited += t1 - t2;
+            else
+                waited += t1 + (initial - t2);
+
             t1 = t2;
         }
     }
@@ -151,6 +162,11 @@ Timer::Result IntelAPIC::initialize()
     if (m_io.map(IOBase) != IntelIO::Success)
         return Timer::IOError;
 
+    return initializeCore();
+}
+
+Timer::Result IntelAPIC::initializeCore()
+{
     // Initialize and disable the timer
     m_io.write(DivideConfig, Divide16);
     m_io.write(InitialCount, 0);
@@ -219,3 +235,24 @@ IntController::Result IntelAPIC::sendStartupIPI(uint cpuId, Address addr)
     // Startup interrupt delivered.
     return IntController::Success;
 }
+
+IntController::Result IntelAPIC::sendIPI(uint cpuId, uint vector)
+{
+    ulong cfg;
+
+    // Wait until the previous IPI is delivered
+    while (m_io.read(IntCommand1) & APIC_DEST_PENDING)
+        ;
+
+    // Write APIC Destination
+    cfg  = m_io.read(IntCommand2);
+    cfg &= 0x00ffffff;
+    m_io.write(IntCommand2, cfg | APIC_DEST(cpuId));
+
+    // Raise the vector on the destination
+    cfg  = m_io.read(IntCommand1);
+    cfg &= ~0xcdfff;
+    cfg |= (APIC_DEST_FIELD | APIC_DEST_ASSERT | APIC_DEST_DM_FIXED | vector);
+    m_io.write(IntCommand1, cfg);
+    return IntController::Success;
+}
@@ -54,6 +54,12 @@ class IntelAPIC : public IntController, public Timer
     /** APIC timer interrupt vector is fixed at 48 */
     static const uint TimerVector = 48;
 
+    /** Inter-processor interrupt vector to invalidate TLBs */
+    static const uint ShootdownVector = 49;
+
+    /** Inter-processor interrupt vector to reschedule */
+    static const uint RescheduleVector = 50;
+
   private:
 
     /**
@@ -130,6 +136,13 @@ class IntelAPIC : public IntController, public Timer
      */
     uint getCounter() const;
 
+    /**
+     * Get the identifier of the APIC of the executing core.
+     *
+     * @return APIC identifier.
+     */
+    uint getIdentifier() const;
+
     /**
      * Initialize the APIC.
      *
@@ -137,6 +150,15 @@ class IntelAPIC : public IntController, public Timer
      */
     virtual Timer::Result initialize();
 
+    /**
+     * Initialize the APIC of the executing core.
+     *
+     * The registers must already be mapped by initialize().
+     *
+     * @return Result code.
+     */
+    Timer::Result initializeCore();
+
     /**
      * Busy wait a number of microseconds.
      *
@@ -199,6 +221,15 @@ class IntelAPIC : public IntController, public Timer
      */
     IntController::Result sendStartupIPI(uint cpuId, Address addr);
 
+    /**
+     * Send an Inter-Processor-Interrupt.
+     *
+     * @param cpuId CPU identifier to interrupt.
+     * @param vector Interrupt vector to raise on the CPU.
+     * @return Result code.
+     */
+    IntController::Result sendIPI(uint cpuId, uint vector);
+
   private:
 
     /** I/O object */
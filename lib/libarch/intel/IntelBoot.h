@@ -151,6 +151,16 @@ extern C void bootEntry16();
  */
 extern C void bootEntry32();
 
+/**
+ * Entry point in 32-bit protected mode for cores which run the kernel of core0.
+ *
+ * The core continues with kernel_smp_main() on the stack at bootStackSMP.
+ */
+extern C void bootEntrySMP();
+
+/** Top of the boot stack for the next core entering bootEntrySMP. */
+extern C Address bootStackSMP;
+
 /**
  * Entry point from GRUB multiboot.
  *
@@ -139,6 +139,20 @@ void IntelCore::logRegister(const char *name, u32 reg) const
     ERROR(*s);
 }
 
+volatile u32 IntelCore::readCR0() const
+{
+    volatile u32 cr0;
+    asm volatile("mov %%cr0, %%eax\n"
+                 "mov %%eax, %0\n" : "=r" (cr0) :: "eax");
+    return cr0;
+}
+
+void IntelCore::writeCR0(u32 cr0) const
+{
+    asm volatile("mov %0, %%eax\n"
+                 "mov %%eax, %%cr0" :: "r" (cr0) : "eax");
+}
+
 volatile u32 IntelCore::readCR2() const
 {
     volatile u32 cr2;
@@ -160,3 +174,17 @@ void IntelCore::writeCR3(u32 cr3) const
     asm volatile("mov %0, %%eax\n"
                  "mov %%eax, %%cr3" :: "r" (cr3));
 }
+
+volatile u32 IntelCore::readCR4() const
+{
+    volatile u32 cr4;
+    asm volatile("mov %%cr4, %%eax\n"
+                 "mov %%eax, %0\n" : "=r" (cr4) :: "eax");
+    return cr4;
+}
+
+void IntelCore::writeCR4(u32 cr4) const
+{
+    asm volatile("mov %0, %%eax\n"
+                 "mov %%eax, %%cr4" :: "r" (cr4) : "eax");
+}
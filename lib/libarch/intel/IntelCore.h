@@ -22,6 +22,7 @@
 #include <Macros.h>
 #include <Core.h>
 #include "IntelIO.h"
+#include "IntelConstant.h"
 
 /**
  * @addtogroup lib
@@ -81,6 +82,18 @@ inline u64 timestamp()
 #define idle() \
     asm volatile ("hlt");
 
+/**
+ * Clear a page of memory with a string store.
+ *
+ * @param addr Page aligned virtual address.
+ */
+#define zero_page(addr) \
+({ \
+    Address _dst = (Address) (addr); \
+    Size _count = PAGESIZE / sizeof(u32); \
+    asm volatile ("rep stosl" : "+D" (_dst), "+c" (_count) : "a" (0) : "memory"); \
+})
+
 /**
  * Loads the Task State Register (LTR) with the given segment.
  *
@@ -92,6 +105,21 @@ inline u64 timestamp()
     asm volatile ("ltr %0\n" :: "r"(tr)); \
 })
 
+/**
+ * Get the index of the executing core.
+ *
+ * Each core loads its own TSS segment, which follows
+ * the TSS segment of core0 in the GDT.
+ *
+ * @return Core index, zero for the bootstrap core.
+ */
+#define core_index() \
+({ \
+    u16 tr; \
+    asm volatile ("str %0\n" : "=r"(tr)); \
+    tr > KERNEL_TSS_SEL ? (Size) ((tr - KERNEL_TSS_SEL) / 8) : 0; \
+})
+
 /**
  * Flushes the Translation Lookaside Buffers (TLB) for a single page.
  *
@@ -150,6 +178,36 @@ inline u64 timestamp()
     asm volatile ("push %0\n"                   \
                   "popfl\n" :: "g" (saved))
 
+/**
+ * Clear the Task-Switched flag in CR0.
+ *
+ * Allows FPU/SSE instructions to execute without raising INTEL_DEVERR.
+ */
+#define clts() \
+    asm volatile ("clts")
+
+/**
+ * Reset the FPU to its default state.
+ */
+#define fninit() \
+    asm volatile ("fninit")
+
+/**
+ * Save the FPU, MMX and SSE registers.
+ *
+ * @param state Pointer to a 16-byte aligned FPUState.
+ */
+#define fxsave(state) \
+    asm volatile ("fxsave (%0)" :: "r" (state) : "memory")
+
+/**
+ * Restore the FPU, MMX and SSE registers.
+ *
+ * @param state Pointer to a 16-byte aligned FPUState.
+ */
+#define fxrstor(state) \
+    asm volatile ("fxrstor (%0)" :: "r" (state) : "memory")
+
 /**
  * @group Intel CPU Exceptions
  * @{
@@ -176,6 +234,10 @@ inline u64 timestamp()
 #define INTEL_SIMD      19
 #define INTEL_VIRTERR   20
 
+/** Page fault error code bits. */
+#define INTEL_PAGEFAULT_PRESENT (1 << 0)
+#define INTEL_PAGEFAULT_WRITE   (1 << 1)
+
 /**
  * @}
  */
@@ -188,6 +250,23 @@ inline u64 timestamp()
 #define INTEL_EFLAGS_DEFAULT    (1 << 1)
 #define INTEL_EFLAGS_IRQ        (1 << 9)
 
+/**
+ * @}
+ */
+
+/**
+ * @group Intel Control Registers
+ * @{
+ */
+
+#define INTEL_CR0_MP            (1 << 1)
+#define INTEL_CR0_EM            (1 << 2)
+#define INTEL_CR0_TS            (1 << 3)
+#define INTEL_CR0_NE            (1 << 5)
+#define INTEL_CR0_WP            (1 << 16)
+#define INTEL_CR4_OSFXSR        (1 << 9)
+#define INTEL_CR4_OSXMMEXCPT    (1 << 10)
+
 /**
  * @}
  */
@@ -302,6 +381,15 @@ typedef struct CPUState
 }
 CPUState;
 
+/**
+ * FPU, MMX and SSE registers in the fxsave/fxrstor format.
+ */
+typedef struct FPUState
+{
+    u8 data[512];
+}
+ALIGN(16) FPUState;
+
 /**
  * Intel CPU Core.
  */
@@ -331,6 +419,16 @@ class IntelCore : public Core
      */
     void logRegister(const char *name, u32 reg) const;
 
+    /**
+     * Read the CR0 register.
+     */
+    volatile u32 readCR0() const;
+
+    /**
+     * Write the CR0 register.
+     */
+    void writeCR0(u32 cr0) const;
+
     /**
      * Read the CR2 register.
      */
@@ -345,6 +443,16 @@ class IntelCore : public Core
      * Write the CR3 register
      */
     void writeCR3(u32 cr3) const;
+
+    /**
+     * Read the CR4 register.
+     */
+    volatile u32 readCR4() const;
+
+    /**
+     * Write the CR4 register.
+     */
+    void writeCR4(u32 cr4) const;
 };
 
 #ifdef __KERNEL__
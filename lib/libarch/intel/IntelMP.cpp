@@ -24,12 +24,16 @@
 IntelMP::IntelMP()
     : CoreManager()
 {
-    SystemInformation info;
-
     m_bios.map(MPAreaAddr, MPAreaSize);
-    m_lastMemory.map(info.memorySize - MegaByte(1), MegaByte(1));
 
-    m_apic.getIO().map(IntelAPIC::IOBase, PAGESIZE);
+    // The kernel only discovers cores in the BIOS memory and boots them itself
+    if (!isKernel)
+    {
+        SystemInformation info;
+
+        m_lastMemory.map(info.memorySize - MegaByte(1), MegaByte(1));
+        m_apic.getIO().map(IntelAPIC::IOBase, PAGESIZE);
+    }
 }
 
 IntelMP::MPConfig * IntelMP::scanMemory(Address addr)
@@ -61,7 +65,8 @@ IntelMP::Result IntelMP::discover()
     // Retry in the last 1MB of physical memory if not found.
     if (!mpc)
     {
-        mpc = scanMemory(m_lastMemory.getBase());
+        if (!isKernel)
+            mpc = scanMemory(m_lastMemory.getBase());
         if (!mpc)
         {
             ERROR("MP header not found");
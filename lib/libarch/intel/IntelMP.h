@@ -32,6 +32,9 @@
 /** Physical memory address for the CoreInfo structure. */
 #define MPINFOADDR 0x10000
 
+/** Physical memory address at which cores start (bootEntry16). */
+#define MPENTRYADDR 0xf000
+
 /**
  * @}
  * @}
@@ -78,7 +81,7 @@ class IntelMP : public CoreManager
     static const uint MPEntryProc = 0;
 
     /** Physical memory address at which cores start (bootEntry16). */
-    static const Address MPEntryAddr = 0xf000;
+    static const Address MPEntryAddr = MPENTRYADDR;
 
     /** Physical memory address for the CoreInfo structure. */
     static const Address MPInfoAddr = MPINFOADDR;
@@ -73,11 +73,9 @@ MemoryContext::Result IntelPageDirectory::map(Address virt,
     if (!table)
     {
         // Allocate a new page table
-        if (alloc->allocateLow(sizeof(IntelPageTable), &addr) != Allocator::Success)
+        if (alloc->allocateZero(sizeof(IntelPageTable), &addr) != Allocator::Success)
             return MemoryContext::OutOfMemory;
 
-        MemoryBlock::set(alloc->toVirtual(addr), 0, sizeof(IntelPageTable));
-
         // Assign to the page directory
         m_tables[ DIRENTRY(virt) ] = addr | PAGE_PRESENT | PAGE_WRITE | flags(access);
         table = getPageTable(virt, alloc);
@@ -138,6 +136,7 @@ MemoryContext::Result IntelPageDirectory::releaseRange(Memory::Range range,
                                                        bool tablesOnly)
 {
     Address phys;
+    Memory::Access access;
 
     // Walk the page directory within the specified range
     for (Size i = 0; i < range.size; i += MegaByte(4))
@@ -150,7 +149,10 @@ MemoryContext::Result IntelPageDirectory::releaseRange(Memory::Range range,
             {
                 for (Size j = 0; j < MegaByte(4); j += PAGESIZE)
                 {
-                    if (table->translate(range.virt + i + j, &phys) == MemoryContext::Success)
+                    // Copy-on-write pages are owned by their source
+                    if (table->translate(range.virt + i + j, &phys) == MemoryContext::Success &&
+                        table->access(range.virt + i + j, &access) == MemoryContext::Success &&
+                        !(access & Memory::CopyOnWrite))
                     {
                         alloc->release(phys);
                     }
@@ -24,6 +24,7 @@
 #define PAGE_EXEC       0
 #define PAGE_WRITE      2
 #define PAGE_USER       4
+#define PAGE_COW        (1 << 9)
 
 /**
  * Entry inside the page table of a given virtual address.
@@ -74,6 +75,7 @@ MemoryContext::Result IntelPageTable::access(Address virt, Memory::Access *acces
 
     if (entry & PAGE_WRITE) *access |= Memory::Writable;
     if (entry & PAGE_USER)  *access |= Memory::User;
+    if (entry & PAGE_COW)   *access |= Memory::CopyOnWrite;
 
     return MemoryContext::Success;
 }
@@ -85,5 +87,9 @@ u32 IntelPageTable::flags(Memory::Access access) const
     if (access & Memory::Writable) f |= PAGE_WRITE;
     if (access & Memory::User)     f |= PAGE_USER;
 
+    // Copy-on-write pages are read-only until the first write fault
+    if (access & Memory::CopyOnWrite)
+        f = (f & ~PAGE_WRITE) | PAGE_COW;
+
     return f;
 }
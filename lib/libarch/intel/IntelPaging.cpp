@@ -29,15 +29,12 @@ IntelPaging::IntelPaging(MemoryMap *map, SplitAllocator *alloc)
     IntelCore core;
 
     // Allocate page directory from low physical memory.
-    if (alloc->allocateLow(sizeof(IntelPageDirectory),
-                          &m_pageDirectoryAddr) == Allocator::Success)
+    if (alloc->allocateZero(sizeof(IntelPageDirectory),
+                            &m_pageDirectoryAddr) == Allocator::Success)
     {
         m_pageDirectoryAllocated = true;
         m_pageDirectory = (IntelPageDirectory *) alloc->toVirtual(m_pageDirectoryAddr);
 
-        // Initialize the page directory
-        MemoryBlock::set(m_pageDirectory, 0, sizeof(IntelPageDirectory));
-
         // Lookup the currently active page directory
         IntelPageDirectory *currentDirectory =
             (IntelPageDirectory *) alloc->toVirtual(core.readCR3());
@@ -78,7 +75,7 @@ MemoryContext::Result IntelPaging::activate()
 {
     IntelCore core;
     core.writeCR3(m_pageDirectoryAddr);
-    m_current = this;
+    setCurrent();
     return Success;
 }
 
@@ -87,7 +84,7 @@ MemoryContext::Result IntelPaging::map(Address virt, Address phys, Memory::Acces
     MemoryContext::Result r = m_pageDirectory->map(virt, phys, acc, m_alloc);
 
     // Flush TLB entry
-    if (r == Success && m_current == this)
+    if (r == Success && getCurrent() == this)
         tlb_flush(virt);
 
     return r;
@@ -97,10 +94,14 @@ MemoryContext::Result IntelPaging::unmap(Address virt)
 {
     MemoryContext::Result r = m_pageDirectory->unmap(virt, m_alloc);
 
-    // Flush TLB entry
-    if (r == Success && m_current == this)
-        tlb_flush(virt);
+    // Flush TLB entry, also on other cores running this context
+    if (r == Success)
+    {
+        if (getCurrent() == this)
+            tlb_flush(virt);
 
+        shootdown();
+    }
     return r;
 }
 
@@ -116,10 +117,16 @@ MemoryContext::Result IntelPaging::access(Address virt, Memory::Access *access)
 
 MemoryContext::Result IntelPaging::releaseRegion(MemoryMap::Region region, bool tablesOnly)
 {
-    return m_pageDirectory->releaseRange(m_map->range(region), m_alloc, tablesOnly);
+    MemoryContext::Result r = m_pageDirectory->releaseRange(m_map->range(region), m_alloc, tablesOnly);
+
+    shootdown();
+    return r;
 }
 
 MemoryContext::Result IntelPaging::releaseRange(Memory::Range *range, bool tablesOnly)
 {
-    return m_pageDirectory->releaseRange(*range, m_alloc, tablesOnly);
+    MemoryContext::Result r = m_pageDirectory->releaseRange(*range, m_alloc, tablesOnly);
+
+    shootdown();
+    return r;
 }
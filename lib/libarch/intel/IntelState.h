@@ -75,6 +75,16 @@ extern C void interruptHandler();
  */
 extern C void (*interruptRun)(CPUState state);
 
+/**
+ * Leave the kernel.
+ *
+ * Optional callback function which is called before restoring
+ * the state of an interrupted or newly started Process.
+ *
+ * @see loadCoreState
+ */
+extern C void (*interruptLeave)(CPUState state);
+
 /**
  * @}
  * @}
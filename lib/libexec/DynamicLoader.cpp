@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <Macros.h>
+#include <MemoryBlock.h>
+#include "DynamicLoader.h"
+
+#ifdef ARM
+#define RELOC_NONE     ELF_RELOC_ARM_NONE
+#define RELOC_ABSOLUTE ELF_RELOC_ARM_ABS32
+#define RELOC_PCREL    ELF_RELOC_ARM_REL32
+#define RELOC_COPY     ELF_RELOC_ARM_COPY
+#define RELOC_GLOBDAT  ELF_RELOC_ARM_GLOB_DAT
+#define RELOC_JMPSLOT  ELF_RELOC_ARM_JUMP_SLOT
+#define RELOC_RELATIVE ELF_RELOC_ARM_RELATIVE
+#else
+#define RELOC_NONE     ELF_RELOC_386_NONE
+#define RELOC_ABSOLUTE ELF_RELOC_386_32
+#define RELOC_PCREL    ELF_RELOC_386_PC32
+#define RELOC_COPY     ELF_RELOC_386_COPY
+#define RELOC_GLOBDAT  ELF_RELOC_386_GLOB_DAT
+#define RELOC_JMPSLOT  ELF_RELOC_386_JMP_SLOT
+#define RELOC_RELATIVE ELF_RELOC_386_RELATIVE
+#endif
+
+DynamicLoader::DynamicLoader(Address base, const ELFDynamic *dynamic)
+    : m_base(base)
+    , m_dynamic(dynamic)
+    , m_hash(ZERO)
+    , m_symbols(ZERO)
+    , m_strings(ZERO)
+    , m_relocations(ZERO)
+    , m_relocationsSize(0)
+    , m_pltRelocations(ZERO)
+    , m_pltRelocationsSize(0)
+    , m_init(ZERO)
+    , m_initCount(0)
+{
+}
+
+DynamicLoader::Result DynamicLoader::parse()
+{
+    if (!m_dynamic)
+        return NotFound;
+
+    for (const ELFDynamic *d = m_dynamic; d->tag != ELF_DYNAMIC_NULL; d++)
+    {
+        switch (d->tag)
+        {
+            case ELF_DYNAMIC_HASH:
+                m_hash = (const u32 *) (m_base + d->value);
+                break;
+
+            case ELF_DYNAMIC_SYMTAB:
+                m_symbols = (const ELFSymbol *) (m_base + d->value);
+                break;
+
+            case ELF_DYNAMIC_STRTAB:
+                m_strings = (const char *) (m_base + d->value);
+                break;
+
+            case ELF_DYNAMIC_SYMENT:
+                if (d->value != sizeof(ELFSymbol))
+                    return InvalidFormat;
+                break;
+
+            case ELF_DYNAMIC_REL:
+                m_relocations = (const ELFRelocation *) (m_base + d->value);
+                break;
+
+            case ELF_DYNAMIC_RELSZ:
+                m_relocationsSize = d->value;
+                break;
+
+            case ELF_DYNAMIC_RELENT:
+                if (d->value != sizeof(ELFRelocation))
+                    return InvalidFormat;
+                break;
+
+            case ELF_DYNAMIC_PLTREL:
+                if (d->value != ELF_DYNAMIC_REL)
+                    return InvalidFormat;
+                break;
+
+            case ELF_DYNAMIC_JMPREL:
+                m_pltRelocations = (const ELFRelocation *) (m_base + d->value);
+                break;
+
+            case ELF_DYNAMIC_PLTRELSZ:
+                m_pltRelocationsSize = d->value;
+                break;
+
+            case ELF_DYNAMIC_INIT_ARRAY:
+                m_init = (void (**)()) (m_base + d->value);
+                break;
+
+            case ELF_DYNAMIC_INIT_ARRAYSZ:
+                m_initCount = d->value / sizeof(u32);
+                break;
+
+            default:
+                break;
+        }
+    }
+    // Symbol lookups need the hash, symbol and string tables
+    if (!m_hash || !m_symbols || !m_strings)
+        return InvalidFormat;
+
+    return Success;
+}
+
+DynamicLoader::Result DynamicLoader::lookup(const char *name,
+                                            const ELFSymbol **symbol) const
+{
+    const u32 buckets = m_hash[0];
+    const u32 *bucket = m_hash + 2;
+    const u32 *chain  = bucket + buckets;
+
+    if (!buckets)
+        return NotFound;
+
+    for (u32 i = bucket[hash(name) % buckets]; i != 0; i = chain[i])
+    {
+        const ELFSymbol *sym = &m_symbols[i];
+        const char *a = m_strings + sym->name, *b = name;
+
+        // Only defined global and weak symbols are visible
+        if (sym->section == ELF_SECTION_UNDEF ||
+            ELF_SYMBOL_BIND(sym->info) == ELF_SYMBOL_LOCAL)
+            continue;
+
+        while (*a && *a == *b)
+            a++, b++;
+
+        if (*a == *b)
+        {
+            *symbol = sym;
+            return Success;
+        }
+    }
+    return NotFound;
+}
+
+DynamicLoader::Result DynamicLoader::relocate(const DynamicLoader **scope, Size count) const
+{
+    Result r;
+
+    if ((r = relocateTable(m_relocations, m_relocationsSize, scope, count)) != Success)
+        return r;
+
+    return relocateTable(m_pltRelocations, m_pltRelocationsSize, scope, count);
+}
+
+DynamicLoader::Result DynamicLoader::relocateTable(const ELFRelocation *table, Size size,
+                                                   const DynamicLoader **scope, Size count) const
+{
+    for (Size i = 0; i < size / sizeof(ELFRelocation); i++)
+    {
+        const ELFRelocation *rel = &table[i];
+        u32 *place = (u32 *) (m_base + rel->offset);
+        u32 type = ELF_RELOC_TYPE(rel->info);
+        u32 index = ELF_RELOC_SYMBOL(rel->info);
+        const ELFSymbol *def = ZERO;
+        Address value = 0;
+
+        // Resolve the symbol in the given scope
+        if (index)
+        {
+            const ELFSymbol *sym = &m_symbols[index];
+
+            for (Size j = 0; j < count && !def; j++)
+            {
+                // Copy relocations refer to the definition in another object
+                if (type == RELOC_COPY && scope[j] == this)
+                    continue;
+
+                if (scope[j]->lookup(m_strings + sym->name, &def) == Success)
+                    value = scope[j]->m_base + def->value;
+            }
+
+            if (!def)
+            {
+                // Unresolved function calls only fail when used
+                if (type == RELOC_JMPSLOT)
+                {
+                    *place += m_base;
+                    continue;
+                }
+                else if (ELF_SYMBOL_BIND(sym->info) != ELF_SYMBOL_WEAK)
+                    return NotFound;
+            }
+        }
+
+        switch (type)
+        {
+            case RELOC_ABSOLUTE:
+                *place += value;
+                break;
+
+            case RELOC_PCREL:
+                *place += value - (Address) place;
+                break;
+
+            case RELOC_GLOBDAT:
+            case RELOC_JMPSLOT:
+                *place = value;
+                break;
+
+            case RELOC_RELATIVE:
+                *place += m_base;
+                break;
+
+            case RELOC_COPY:
+                if (def)
+                    MemoryBlock::copy(place, (void *) value, def->size);
+                break;
+
+            case RELOC_NONE:
+                break;
+
+            default:
+                return InvalidFormat;
+        }
+    }
+    return Success;
+}
+
+void DynamicLoader::initialize() const
+{
+    for (Size i = 0; i < m_initCount; i++)
+        if (m_init[i] && m_init[i] != (void (*)()) ~0UL)
+            m_init[i]();
+}
+
+Address DynamicLoader::getBase() const
+{
+    return m_base;
+}
+
+u32 DynamicLoader::hash(const char *name)
+{
+    u32 h = 0, g;
+
+    while (*name)
+    {
+        h = (h << 4) + (u8) *name++;
+
+        if ((g = h & 0xf0000000))
+            h ^= g >> 24;
+
+        h &= ~g;
+    }
+    return h;
+}
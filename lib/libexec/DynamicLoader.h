@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBEXEC_DYNAMICLOADER_H
+#define __LIBEXEC_DYNAMICLOADER_H
+
+#include <Types.h>
+#include "ELFHeader.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libexec
+ * @{
+ */
+
+/**
+ * Minimal runtime loader for dynamically linked ELF objects.
+ *
+ * Operates on an ELF object which is already mapped in the current
+ * address space, such as the program itself or the shared libfreenos.
+ * It resolves symbols through the SysV hash table and processes the
+ * relocations of the object against a scope of loaded objects.
+ *
+ * The loader does not allocate memory and does not use global data,
+ * such that a shared library can relocate itself with it before
+ * any of its own relocations are applied.
+ */
+class DynamicLoader
+{
+  public:
+
+    /**
+     * Result codes.
+     */
+    enum Result
+    {
+        Success,
+        NotFound,
+        InvalidFormat
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param base Load bias of the object. Added to all virtual addresses in the object.
+     * @param dynamic Pointer to the dynamic section of the object in memory.
+     */
+    DynamicLoader(Address base, const ELFDynamic *dynamic);
+
+    /**
+     * Read the tables from the dynamic section.
+     *
+     * @return Result code.
+     */
+    Result parse();
+
+    /**
+     * Lookup a symbol defined by this object.
+     *
+     * @param name Name of the symbol.
+     * @param symbol Outputs a pointer to the symbol table entry.
+     *
+     * @return Result code.
+     */
+    Result lookup(const char *name, const ELFSymbol **symbol) const;
+
+    /**
+     * Apply all relocations of this object.
+     *
+     * Symbols are resolved in the order of the given scope,
+     * which normally is the program followed by the shared library.
+     *
+     * @param scope Array of loaded objects to resolve symbols against.
+     * @param count Number of objects in the scope.
+     *
+     * @return Result code.
+     */
+    Result relocate(const DynamicLoader **scope, Size count) const;
+
+    /**
+     * Run the initialization functions of this object.
+     */
+    void initialize() const;
+
+    /**
+     * Get the load bias.
+     *
+     * @return Load bias of the object.
+     */
+    Address getBase() const;
+
+  private:
+
+    /**
+     * Apply a table of relocations.
+     *
+     * @param table Relocations to apply.
+     * @param size Size of the table in bytes.
+     * @param scope Array of loaded objects to resolve symbols against.
+     * @param count Number of objects in the scope.
+     *
+     * @return Result code.
+     */
+    Result relocateTable(const ELFRelocation *table, Size size,
+                         const DynamicLoader **scope, Size count) const;
+
+    /**
+     * Compute the SysV ELF hash of a symbol name.
+     *
+     * @param name Symbol name.
+     *
+     * @return Hash value.
+     */
+    static u32 hash(const char *name);
+
+  private:
+
+    /** Load bias. */
+    Address m_base;
+
+    /** Dynamic section. */
+    const ELFDynamic *m_dynamic;
+
+    /** SysV hash table: bucket count, chain count, buckets and chains. */
+    const u32 *m_hash;
+
+    /** Dynamic symbol table. */
+    const ELFSymbol *m_symbols;
+
+    /** Dynamic string table. */
+    const char *m_strings;
+
+    /** Relocations. */
+    const ELFRelocation *m_relocations;
+
+    /** Size of the relocations in bytes. */
+    Size m_relocationsSize;
+
+    /** PLT relocations. */
+    const ELFRelocation *m_pltRelocations;
+
+    /** Size of the PLT relocations in bytes. */
+    Size m_pltRelocationsSize;
+
+    /** Initialization functions. */
+    void (**m_init)();
+
+    /** Number of initialization functions. */
+    Size m_initCount;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBEXEC_DYNAMICLOADER_H */
@@ -22,6 +22,7 @@
 #include <errno.h>
 #include <unistd.h>
 #include <sys/types.h>
+#include <Macros.h>
 #include <MemoryBlock.h>
 #include "ELF.h"
 
@@ -45,9 +46,10 @@ ELF::Result ELF::detect(const u8 *image, Size size, ExecutableFormat **fmt)
         header->ident[ELF_INDEX_MAGIC3] == ELF_MAGIC3)
     {
         // Only accept current version, 32-bit ELF executable programs
+        // and position independent programs or shared libraries
         if (header->ident[ELF_INDEX_CLASS] == ELF_CLASS_32 &&
             header->version == ELF_VERSION_CURRENT &&
-            header->type    == ELF_TYPE_EXEC)
+           (header->type    == ELF_TYPE_EXEC || header->type == ELF_TYPE_DYN))
         {
             (*fmt) = new ELF(image, size);
             return Success;
@@ -57,6 +59,36 @@ ELF::Result ELF::detect(const u8 *image, Size size, ExecutableFormat **fmt)
 }
 
 ELF::Result ELF::regions(ELF::Region *regions, Size *count) const
+{
+    Result r;
+
+    // Find the loadable segments
+    if ((r = layout(regions, count)) != Success)
+        return r;
+
+    // Fill in the contents
+    for (Size i = 0; i < *count; i++)
+    {
+        if (regions[i].dataOffset + regions[i].dataSize > m_size)
+            return InvalidFormat;
+
+        regions[i].data = new u8[regions[i].size];
+
+        // Read segment contents from file
+        MemoryBlock::copy(regions[i].data, m_image + regions[i].dataOffset,
+                          regions[i].dataSize);
+
+        // Nulify remaining space
+        if (regions[i].size > regions[i].dataSize)
+        {
+            memset(regions[i].data + regions[i].dataSize, 0,
+                   regions[i].size - regions[i].dataSize);
+        }
+    }
+    return Success;
+}
+
+ELF::Result ELF::layout(ELF::Region *regions, Size *count) const
 {
     ELFSegment *segments;
     ELFHeader *header = (ELFHeader *) m_image;
@@ -69,6 +101,10 @@ ELF::Result ELF::regions(ELF::Region *regions, Size *count) const
         return InvalidFormat;
     }
 
+    // The program table must be inside the image
+    if (header->programHeaderOffset + (num * sizeof(ELFSegment)) > m_size)
+        return InvalidFormat;
+
     // Point to the program segments
     segments = (ELFSegment *) (m_image + header->programHeaderOffset);
     (*count) = 0;
@@ -80,21 +116,18 @@ ELF::Result ELF::regions(ELF::Region *regions, Size *count) const
         if (segments[i].type != ELF_SEGMENT_LOAD)
             continue;
 
-        regions[c].virt   = segments[i].virtualAddress;
-        regions[c].size   = segments[i].memorySize;
-        regions[c].access = Memory::User | Memory::Readable | Memory::Writable;
-        regions[c].data   = new u8[segments[i].memorySize];
+        regions[c].virt       = segments[i].virtualAddress;
+        regions[c].size       = segments[i].memorySize;
+        regions[c].access     = Memory::User | Memory::Readable;
+        regions[c].data       = ZERO;
+        regions[c].dataOffset = segments[i].offset;
+        regions[c].dataSize   = segments[i].fileSize;
 
-        // Read segment contents from file
-        MemoryBlock::copy(regions[c].data, m_image + segments[i].offset,
-                          segments[i].fileSize);
+        if (segments[i].flags & ELF_SEGMENT_FLAG_WRITE)
+            regions[c].access |= Memory::Writable;
 
-        // Nulify remaining space
-        if (segments[i].memorySize > segments[i].fileSize)
-        {
-            memset(regions[c].data + segments[i].fileSize, 0,
-                   segments[i].memorySize - segments[i].fileSize);
-        }
+        if (segments[i].flags & ELF_SEGMENT_FLAG_EXEC)
+            regions[c].access |= Memory::Executable;
         c++;
     }
 
@@ -109,3 +142,23 @@ ELF::Result ELF::entry(Address *entry) const
     *entry = header->entry;
     return Success;
 }
+
+ELF::Result ELF::dynamic(Address *virt) const
+{
+    ELFHeader *header = (ELFHeader *) m_image;
+    ELFSegment *segments = (ELFSegment *) (m_image + header->programHeaderOffset);
+
+    if (header->programHeaderOffset +
+       (header->programHeaderEntryCount * sizeof(ELFSegment)) > m_size)
+        return InvalidFormat;
+
+    for (Size i = 0; i < header->programHeaderEntryCount; i++)
+    {
+        if (segments[i].type == ELF_SEGMENT_DYNAMIC)
+        {
+            *virt = segments[i].virtualAddress;
+            return Success;
+        }
+    }
+    return NotFound;
+}
@@ -62,6 +62,17 @@ class ELF : public ExecutableFormat
      */
     virtual Result regions(Region *regions, Size *count) const;
 
+    /**
+     * Reads out segments from the ELF program table without their contents.
+     *
+     * @param regions Memory regions to fill.
+     * @param count Maximum number of memory regions on input.
+     *              Actual number of memory regions on output.
+     *
+     * @return Result code.
+     */
+    virtual Result layout(Region *regions, Size *count) const;
+
     /**
      * Lookup the program entry point.
      *
@@ -71,6 +82,15 @@ class ELF : public ExecutableFormat
      */
     virtual Result entry(Address *entry) const;
 
+    /**
+     * Lookup the dynamic segment.
+     *
+     * @param virt Virtual address of the dynamic section on output.
+     *
+     * @return Result code.
+     */
+    virtual Result dynamic(Address *virt) const;
+
     /**
      * Read ELF header from memory.
      *
@@ -321,6 +321,213 @@ typedef struct ELFSegment
 }
 ELFSegment;
 
+/**
+ * @name Segment flags
+ * @{
+ */
+
+/** Segment is executable. */
+#define ELF_SEGMENT_FLAG_EXEC   (1 << 0)
+
+/** Segment is writable. */
+#define ELF_SEGMENT_FLAG_WRITE  (1 << 1)
+
+/** Segment is readable. */
+#define ELF_SEGMENT_FLAG_READ   (1 << 2)
+
+/**
+ * @}
+ */
+
+/**
+ * @name Dynamic section tags
+ * @{
+ */
+
+/** Marks the end of the dynamic section. */
+#define ELF_DYNAMIC_NULL        0
+
+/** String table offset of a needed library name. */
+#define ELF_DYNAMIC_NEEDED      1
+
+/** Total size of the PLT relocations. */
+#define ELF_DYNAMIC_PLTRELSZ    2
+
+/** Address of the symbol hash table. */
+#define ELF_DYNAMIC_HASH        4
+
+/** Address of the string table. */
+#define ELF_DYNAMIC_STRTAB      5
+
+/** Address of the symbol table. */
+#define ELF_DYNAMIC_SYMTAB      6
+
+/** Size of the string table. */
+#define ELF_DYNAMIC_STRSZ       10
+
+/** Size of one symbol table entry. */
+#define ELF_DYNAMIC_SYMENT      11
+
+/** String table offset of the shared object name. */
+#define ELF_DYNAMIC_SONAME      14
+
+/** Address of the relocations without addend. */
+#define ELF_DYNAMIC_REL         17
+
+/** Total size of the relocations without addend. */
+#define ELF_DYNAMIC_RELSZ       18
+
+/** Size of one relocation entry without addend. */
+#define ELF_DYNAMIC_RELENT      19
+
+/** Type of the PLT relocations. */
+#define ELF_DYNAMIC_PLTREL      20
+
+/** Address of the PLT relocations. */
+#define ELF_DYNAMIC_JMPREL      23
+
+/** Address of the array of initialization functions. */
+#define ELF_DYNAMIC_INIT_ARRAY  25
+
+/** Size of the array of initialization functions. */
+#define ELF_DYNAMIC_INIT_ARRAYSZ 27
+
+/**
+ * @}
+ */
+
+/**
+ * Entry in the dynamic section.
+ */
+typedef struct ELFDynamic
+{
+    /** Type of the entry. */
+    s32 tag;
+
+    /** Integer value or virtual address. */
+    u32 value;
+}
+ELFDynamic;
+
+/**
+ * @name Symbol bindings and sections
+ * @{
+ */
+
+/** Extract the binding from the symbol info field. */
+#define ELF_SYMBOL_BIND(info)   ((info) >> 4)
+
+/** Symbol is local to the object. */
+#define ELF_SYMBOL_LOCAL        0
+
+/** Symbol is visible to all objects. */
+#define ELF_SYMBOL_GLOBAL       1
+
+/** Symbol is global, but may be undefined. */
+#define ELF_SYMBOL_WEAK         2
+
+/** Section index of an undefined symbol. */
+#define ELF_SECTION_UNDEF       0
+
+/**
+ * @}
+ */
+
+/**
+ * Entry in the dynamic symbol table.
+ */
+typedef struct ELFSymbol
+{
+    /** String table offset of the symbol name. */
+    u32 name;
+
+    /** Value or virtual address of the symbol. */
+    u32 value;
+
+    /** Size of the symbol in bytes. */
+    u32 size;
+
+    /** Type and binding. */
+    u8  info;
+
+    /** Visibility. */
+    u8  other;
+
+    /** Section index. */
+    u16 section;
+}
+ELFSymbol;
+
+/**
+ * @name Relocation types
+ * @{
+ */
+
+/** Extract the symbol index from the relocation info field. */
+#define ELF_RELOC_SYMBOL(info)  ((info) >> 8)
+
+/** Extract the relocation type from the relocation info field. */
+#define ELF_RELOC_TYPE(info)    ((info) & 0xff)
+
+/** Intel: no relocation. */
+#define ELF_RELOC_386_NONE      0
+
+/** Intel: symbol plus addend. */
+#define ELF_RELOC_386_32        1
+
+/** Intel: symbol plus addend minus the place. */
+#define ELF_RELOC_386_PC32      2
+
+/** Intel: copy the symbol contents into the executable. */
+#define ELF_RELOC_386_COPY      5
+
+/** Intel: global offset table entry. */
+#define ELF_RELOC_386_GLOB_DAT  6
+
+/** Intel: procedure linkage table entry. */
+#define ELF_RELOC_386_JMP_SLOT  7
+
+/** Intel: load base plus addend. */
+#define ELF_RELOC_386_RELATIVE  8
+
+/** ARM: no relocation. */
+#define ELF_RELOC_ARM_NONE      0
+
+/** ARM: symbol plus addend. */
+#define ELF_RELOC_ARM_ABS32     2
+
+/** ARM: symbol plus addend minus the place. */
+#define ELF_RELOC_ARM_REL32     3
+
+/** ARM: copy the symbol contents into the executable. */
+#define ELF_RELOC_ARM_COPY      20
+
+/** ARM: global offset table entry. */
+#define ELF_RELOC_ARM_GLOB_DAT  21
+
+/** ARM: procedure linkage table entry. */
+#define ELF_RELOC_ARM_JUMP_SLOT 22
+
+/** ARM: load base plus addend. */
+#define ELF_RELOC_ARM_RELATIVE  23
+
+/**
+ * @}
+ */
+
+/**
+ * Relocation entry without addend.
+ */
+typedef struct ELFRelocation
+{
+    /** Virtual address of the place to relocate. */
+    u32 offset;
+
+    /** Symbol index and relocation type. */
+    u32 info;
+}
+ELFRelocation;
+
 /**
  * @}
  * @}
@@ -29,6 +29,11 @@ ExecutableFormat::~ExecutableFormat()
 {
 }
 
+ExecutableFormat::Result ExecutableFormat::dynamic(Address *virt) const
+{
+    return NotFound;
+}
+
 ExecutableFormat::Result ExecutableFormat::find(const u8 *image,
                                                 Size size,
                                                 ExecutableFormat **fmt)
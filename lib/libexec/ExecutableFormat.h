@@ -58,6 +58,12 @@ class ExecutableFormat
         Size size;
         Memory::Access access;
         u8 *data;
+
+        /** Offset of the region contents in the program image. */
+        Size dataOffset;
+
+        /** Number of bytes to load from the image. The rest is zero. */
+        Size dataSize;
     }
     Region;
 
@@ -98,6 +104,21 @@ class ExecutableFormat
      */
     virtual Result regions(Region *regions, Size *count) const = 0;
 
+    /**
+     * Memory regions a program needs at runtime, without their contents.
+     *
+     * Only requires the headers of the program image. The data field
+     * of each region is ZERO and its contents should be loaded from
+     * dataOffset and dataSize in the program file instead.
+     *
+     * @param regions Memory regions to fill.
+     * @param count On input, the maximum number of regions to read.
+     *              On output, the actual number of regions read.
+     *
+     * @return Result code.
+     */
+    virtual Result layout(Region *regions, Size *count) const = 0;
+
     /**
      * Lookup the program entry point.
      *
@@ -106,6 +127,16 @@ class ExecutableFormat
      */
     virtual Result entry(Address *entry) const = 0;
 
+    /**
+     * Lookup the dynamic section of a dynamically linked program.
+     *
+     * @param virt Virtual address of the dynamic section on output.
+     *
+     * @return Success if the program is dynamically linked
+     *         and NotFound if the program is static.
+     */
+    virtual Result dynamic(Address *virt) const;
+
     /**
      * Find a ExecutableFormat which can handle the given format.
      *
@@ -32,20 +32,33 @@ bool BootImageStorage::load()
     BootImage *image;
     BootSymbol *symbol;
     BootSegment *segment;
-    Memory::Range range;
+    Memory::Range header, range;
+    Size tables;
     u8 *base;
 
-    // Request boot image memory
-    range.size   = info.bootImageSize;
-    range.access = Memory::User |
-                   Memory::Readable;
-    range.virt   = ZERO;
-    range.phys   = info.bootImageAddress;
-    VMCtl(SELF, Map, &range);
+    // Map the boot image header
+    header.size   = PAGESIZE;
+    header.access = Memory::User |
+                    Memory::Readable;
+    header.virt   = ZERO;
+    header.phys   = info.bootImageAddress;
+    VMCtl(SELF, Map, &header);
+    image = (BootImage *) header.virt;
 
-    // Update our state
-    image = (BootImage *) range.virt;
-    base  = (u8 *) image;
+    // Extend the mapping to cover the symbol and segment tables
+    tables = image->segmentsTableOffset + (image->segmentsTableCount * sizeof(BootSegment));
+    if (image->symbolTableOffset + (image->symbolTableCount * sizeof(BootSymbol)) > tables)
+        tables = image->symbolTableOffset + (image->symbolTableCount * sizeof(BootSymbol));
+
+    if (tables > header.size)
+    {
+        VMCtl(SELF, UnMap, &header);
+        header.size = tables;
+        header.virt = ZERO;
+        VMCtl(SELF, Map, &header);
+        image = (BootImage *) header.virt;
+    }
+    base = (u8 *) image;
 
     // Search for the given BootSymbol
     for (uint i = 0; i < image->symbolTableCount; i++)
@@ -55,15 +68,27 @@ bool BootImageStorage::load()
 
         if (strcmp(symbol->name, m_name) == 0)
         {
-            m_size   = symbol->segmentsTotalSize;
             segment = (BootSegment *) (base + image->segmentsTableOffset +
                                       (symbol->segmentsOffset * sizeof(BootSegment)));
-            m_data   = base + segment->offset;
+
+            // Map only the segments of this symbol
+            range.phys   = (info.bootImageAddress + segment->offset) & PAGEMASK;
+            range.size   = ((info.bootImageAddress + segment->offset) & ~PAGEMASK) +
+                           symbol->segmentsTotalSize;
+            range.access = header.access;
+            range.virt   = ZERO;
+            VMCtl(SELF, Map, &range);
+
+            m_size = symbol->segmentsTotalSize;
+            m_data = (u8 *) range.virt + ((info.bootImageAddress + segment->offset) & ~PAGEMASK);
+            VMCtl(SELF, UnMap, &header);
+
             // Success
             return true;
         }
     }
     // BootSymbol not found
+    VMCtl(SELF, UnMap, &header);
     return false;
 }
 
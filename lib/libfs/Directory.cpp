@@ -19,33 +19,54 @@
 
 Directory::Directory() : File(DirectoryFile)
 {
+    m_cursor       = ZERO;
+    m_cursorCookie = 0;
+    m_cursorValid  = false;
+
     insert(DirectoryFile, ".");
     insert(DirectoryFile, "..");
 }
 
 Directory::~Directory()
 {
-    for (ListIterator<Dirent *> i(entries); i.hasCurrent(); i++)
-        delete i.current();
-
-    entries.clear();
+    clear();
 }
 
 Error Directory::read(IOBuffer & buffer, Size size, Size offset)
 {
+    Size cookie = offset / sizeof(Dirent);
+    return readEntries(buffer, size, &cookie);
+}
+
+Error Directory::readEntries(IOBuffer & buffer, Size size, Size *cookie)
+{
+    List<Dirent *>::Node *node;
     Size bytes = 0;
 
-    // Loop our list of Dirents
-    for (ListIterator<Dirent *> i(&entries); i.hasCurrent(); i++)
+    // Resume from the cursor, or walk to the requested entry
+    if (m_cursorValid && m_cursorCookie == *cookie)
+        node = m_cursor;
+    else
+    {
+        node = entries.head();
+
+        for (Size i = 0; i < *cookie && node; i++)
+            node = node->next;
+    }
+
+    // Copy as many entries as fit
+    for (; node && bytes + sizeof(Dirent) <= size; node = node->next)
     {
-        // Can we read another entry?
-        if (bytes + sizeof(Dirent) <= size)
-        {
-            buffer.write(i.current(), sizeof(Dirent), bytes);
-            bytes += sizeof(Dirent);
-        }
-        else break;
+        buffer.write(node->data, sizeof(Dirent), bytes);
+        bytes += sizeof(Dirent);
+        (*cookie)++;
     }
+
+    // Remember where to continue
+    m_cursor       = node;
+    m_cursorCookie = *cookie;
+    m_cursorValid  = true;
+
     // Report results
     return bytes;
 }
@@ -61,53 +82,53 @@ void Directory::insert(FileType type, const char *name, ...)
     va_list args;
     Dirent *d;
 
+    // Format the path variable
+    va_start(args, name);
+    vsnprintf(path, sizeof(path), name, args);
+    va_end(args);
+
     // Only insert if not already in
-    if (!get(name))
+    if (!get(path))
     {
-        // Format the path variable
-        va_start(args, name);
-        vsnprintf(path, sizeof(path), name, args);
-        va_end(args);
-
         // Create an fill entry object
         d = new Dirent;
         strlcpy(d->name, path, DIRENT_LEN);
         d->type = type;
         entries.append(d);
+        m_index.insert(String((const char *) d->name), entries.tail());
         m_size += sizeof(*d);
+        m_cursorValid = false;
     }
 }
 
 void Directory::remove(const char *name)
 {
-    for (ListIterator<Dirent *> i(&entries); i.hasCurrent(); i++)
+    List<Dirent *>::Node *node = m_index.value(String(name), ZERO);
+
+    if (node)
     {
-        if (strcmp(i.current()->name, name) == 0)
-        {
-            delete i.current();
-            i.remove();
-            m_size -= sizeof(Dirent);
-            return;
-        }
+        m_index.remove(String(name));
+        delete node->data;
+        entries.remove(node);
+        m_size -= sizeof(Dirent);
+        m_cursorValid = false;
     }
 }
 
 void Directory::clear()
 {
     for (ListIterator<Dirent *> i(entries); i.hasCurrent(); i++)
+    {
+        m_index.remove(String((const char *) i.current()->name));
         delete i.current();
-
+    }
     entries.clear();
+    m_cursorValid = false;
 }
 
 Dirent * Directory::get(const char *name)
 {
-    for (ListIterator<Dirent *> i(&entries); i.hasCurrent(); i++)
-    {
-        if (strcmp(i.current()->name, name) == 0)
-        {
-            return i.current();
-        }
-    }
-    return (Dirent *) ZERO;
+    List<Dirent *>::Node *node = m_index.value(String(name), ZERO);
+
+    return node ? node->data : (Dirent *) ZERO;
 }
@@ -20,6 +20,8 @@
 
 #include <FreeNOS/System.h>
 #include <List.h>
+#include <HashTable.h>
+#include <String.h>
 #include "File.h"
 #include "FileSystemPath.h"
 #include <stdio.h>
@@ -86,11 +88,9 @@ class Directory : public File
     /**
      * Read directory entries.
      *
-     * This default read implementation reads the private
-     * List of Dirent entries from memory. It can be usefull
-     * for pseudo filesystems which don't have any real data
-     * on Storage. Filesystem that do have date on Storage should
-     * implement their version of read().
+     * Reads the entries starting at the given byte offset, which
+     * is interpreted as a multiple of sizeof(Dirent). It is implemented
+     * using readEntries().
      *
      * @param buffer Input/Output buffer to output bytes to.
      * @param size Number of bytes to read, at maximum.
@@ -98,11 +98,37 @@ class Directory : public File
      *
      * @return Number of bytes read on success, Error on failure.
      *
+     * @see readEntries
+     */
+    virtual Error read(IOBuffer & buffer, Size size, Size offset);
+
+    /**
+     * Read a batch of directory entries.
+     *
+     * Copies as many whole Dirent structures as fit in size bytes,
+     * starting at the position described by the cookie. On return the
+     * cookie is updated to resume right after the last entry copied.
+     * A cookie of zero starts at the first entry. Other cookie values
+     * are opaque to the caller and only valid when returned by a
+     * previous call.
+     *
+     * This default implementation reads the private List of Dirent
+     * entries from memory. It can be usefull for pseudo filesystems which
+     * don't have any real data on Storage. Filesystems that do have data
+     * on Storage should implement their own version.
+     *
+     * @param buffer Input/Output buffer to output bytes to.
+     * @param size Number of bytes to read, at maximum.
+     * @param cookie Resume position on input, next position on output.
+     *
+     * @return Number of bytes read on success, zero at the end of the
+     *         Directory and Error on failure.
+     *
      * @see FileSystem
      * @see Storage
      * @see Dirent
      */
-    virtual Error read(IOBuffer & buffer, Size size, Size offset);
+    virtual Error readEntries(IOBuffer & buffer, Size size, Size *cookie);
 
     /**
      * Retrieve a File from storage.
@@ -183,6 +209,18 @@ class Directory : public File
      * @see Directory::remove
      */
     List<Dirent *> entries;
+
+    /** Maps entry names to their Node in the entries List. */
+    HashTable<String, List<Dirent *>::Node *> m_index;
+
+    /** Node at which the last readEntries() stopped, or ZERO at the end. */
+    List<Dirent *>::Node *m_cursor;
+
+    /** Cookie which resumes at m_cursor. */
+    Size m_cursorCookie;
+
+    /** True if m_cursor may be used to resume. */
+    bool m_cursorValid;
 };
 
 /**
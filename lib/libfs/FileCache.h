@@ -42,7 +42,7 @@ typedef struct FileCache
      * @param p Our parent. ZERO if we have no parent.
      */
     FileCache(File *f, const char *n, FileCache *p)
-            : file(f), valid(true), parent(p)
+            : file(f), valid(true), busy(0), parent(p)
     {
         name = n;
 
@@ -76,6 +76,9 @@ typedef struct FileCache
     /** Is this entry still valid?. */
     bool valid;
 
+    /** Number of requests which read the file in a worker thread. */
+    Size busy;
+
     /** Parent */
     FileCache *parent;
 }
@@ -19,6 +19,7 @@
 #include <Vector.h>
 #include <HashTable.h>
 #include <HashIterator.h>
+#include <Move.h>
 #include <Runtime.h>
 #include <fcntl.h>
 #include <unistd.h>
@@ -32,6 +33,13 @@ FileSystem::FileSystem(const char *path)
     m_root      = 0;
     m_mountPath = path;
     m_requests  = new List<FileSystemRequest *>();
+    m_batch     = new SystemCallBatch;
+    m_workers   = 0;
+    m_server    = ProcessCtl(SELF, GetPID, 0);
+    m_pending   = new List<FileSystemRequest *>();
+    m_completed = new List<FileSystemRequest *>();
+    pthread_mutex_init(&m_workLock, ZERO);
+    pthread_cond_init(&m_workCond, ZERO);
         
     // Register message handlers
     addIPCHandler(CreateFile, &FileSystem::pathHandler, false);
@@ -39,12 +47,18 @@ FileSystem::FileSystem(const char *path)
     addIPCHandler(DeleteFile, &FileSystem::pathHandler, false);
     addIPCHandler(ReadFile,   &FileSystem::pathHandler, false);
     addIPCHandler(WriteFile,  &FileSystem::pathHandler, false);
+    addIPCHandler(ReadDirectory, &FileSystem::pathHandler, false);
+    addIPCHandler(LoadFile,   &FileSystem::pathHandler, false);
 }
 
 FileSystem::~FileSystem()
 {
     if (m_requests)
         delete m_requests;
+
+    delete m_batch;
+    delete m_pending;
+    delete m_completed;
 }
 
 const char * FileSystem::getMountPath() const
@@ -94,6 +108,21 @@ Error FileSystem::mount()
     return ESUCCESS;
 }
 
+Error FileSystem::startWorkers(Size count)
+{
+    pthread_t thread;
+
+    for (; m_workers < count; m_workers++)
+    {
+        if (pthread_create(&thread, ZERO, worker, this) != 0)
+        {
+            ERROR("failed to start worker thread " << m_workers);
+            return EAGAIN;
+        }
+    }
+    return ESUCCESS;
+}
+
 File * FileSystem::createFile(FileType type, DeviceID deviceID)
 {
     return (File *) ZERO;
@@ -120,15 +149,16 @@ Error FileSystem::registerFile(File *file, const char *path, va_list args)
     insertFileCache(file, path, args);
 
     // Also add to the parent directory
-    FileSystemPath p((char *)buf);
+    FileSystemPath p(buf);
+    char name[PATHLEN];
     Directory *parent;
 
-    if (p.parent())
-        parent = (Directory *) findFileCache(**p.parent())->file;
-    else
-        parent = (Directory *) m_root->file;
+    if (!p.count())
+        return EINVAL;
 
-    parent->insert(file->getType(), **p.base());
+    parent = (Directory *) findParentCache(&p)->file;
+    p.copy(p.count() - 1, name, sizeof(name));
+    parent->insert(file->getType(), name);
     return ESUCCESS;
 }
 
@@ -137,16 +167,24 @@ void FileSystem::pathHandler(FileSystemMessage *msg)
     // Copy the request
     FileSystemRequest *req = new FileSystemRequest(msg);
 
-    // Process the request.
-    if (processRequest(req) == EAGAIN)
-        m_requests->append(req);
-    else
-        delete req;
+    // Process the request. Workers own the request until it completes.
+    switch (processRequest(req))
+    {
+        case EAGAIN:
+            m_requests->append(req);
+            break;
+
+        case EINPROGRESS:
+            break;
+
+        default:
+            delete req;
+    }
 }
 
 Error FileSystem::processRequest(FileSystemRequest *req)
 {
-    char buf[PATHLEN];
+    char buf[PATHLEN], name[PATHLEN];
     FileSystemPath path;
     FileCache *cache = ZERO; 
     File *file = ZERO;
@@ -154,9 +192,19 @@ Error FileSystem::processRequest(FileSystemRequest *req)
     FileSystemMessage *msg = req->getMessage();
     Error ret;
     
-    // Copy the file path
-    if ((msg->result = VMCopy(msg->from, API::Read, (Address) buf,
-                    (Address) msg->path, PATHLEN)) <= 0)
+    // Copy the file path. Writes also copy the data with the same kernel entry.
+    m_batch->clear();
+    m_batch->vmCopy(msg->from, API::Read, (Address) buf, (Address) msg->path, PATHLEN);
+
+    if (msg->action == WriteFile && !req->getBuffer().getCount())
+        req->getBuffer().bufferedRead(m_batch);
+
+    m_batch->execute();
+
+    if (m_batch->count() > 1 && m_batch->getResult(1) > 0)
+        req->getBuffer().setCount(m_batch->getResult(1));
+
+    if ((msg->result = m_batch->getResult(0)) <= 0)
     {
         ERROR("path missing: result = " << (int)msg->result << " from = " << msg->from <<
               " addr = " << (void *) msg->path << " action = " << (int) msg->action << " stat = " << (void *) msg->stat);
@@ -197,18 +245,12 @@ Error FileSystem::processRequest(FileSystemRequest *req)
                 /* Attempt to create the new file. */
                 if ((file = createFile(msg->filetype, msg->deviceID)))
                 {
-                    const char *p = **path.full();
-                    insertFileCache(file, "%s", p);
-            
+                    insertFileCache(file, "%s", path.full());
+
                     /* Add directory entry to our parent. */
-                    if (path.parent())
-                    {
-                        parent = (Directory *) findFileCache(**path.parent())->file;
-                    }
-                    else
-                        parent = (Directory *) m_root->file;
-
-                    parent->insert(file->getType(), **path.full());
+                    parent = (Directory *) findParentCache(&path)->file;
+                    path.copy(path.count() - 1, name, sizeof(name));
+                    parent->insert(file->getType(), name);
                     msg->result = ESUCCESS;
                 }
                 else
@@ -218,7 +260,9 @@ Error FileSystem::processRequest(FileSystemRequest *req)
             break;
 
         case DeleteFile:
-            if (cache->entries.count() == 0)
+            if (cache->busy)
+                msg->result = EAGAIN;
+            else if (cache->entries.count() == 0)
             {
                 clearFileCache(cache);
                 msg->result = ESUCCESS;
@@ -234,6 +278,9 @@ Error FileSystem::processRequest(FileSystemRequest *req)
             break;
 
         case ReadFile:
+            if (m_workers && file->getType() == RegularFile)
+                return dispatchRequest(req, cache);
+            else
             {
                 msg->result = file->read(req->getBuffer(), msg->size, msg->offset);
                 if (req->getBuffer().getCount())
@@ -243,6 +290,9 @@ Error FileSystem::processRequest(FileSystemRequest *req)
             break;
         
         case WriteFile:
+            if (cache->busy)
+                msg->result = EAGAIN;
+            else
             {
                 if (!req->getBuffer().getCount())
                     req->getBuffer().bufferedRead();
@@ -251,6 +301,31 @@ Error FileSystem::processRequest(FileSystemRequest *req)
             }
             DEBUG(m_self << ": write = " << (int)msg->result);
             break;
+
+        case ReadDirectory:
+            if (file->getType() != DirectoryFile)
+                msg->result = ENOTDIR;
+            else
+            {
+                msg->result = ((Directory *) file)->readEntries(req->getBuffer(), msg->size, &msg->offset);
+                if (req->getBuffer().getCount())
+                    req->getBuffer().flush();
+            }
+            DEBUG(m_self << ": readdir = " << (int)msg->result);
+            break;
+
+        case LoadFile:
+            // Read directly into the memory of the target process
+            if (m_workers && file->getType() == RegularFile)
+                return dispatchRequest(req, cache);
+            else
+            {
+                msg->result = file->read(req->getBuffer(), msg->size, msg->offset);
+                if (req->getBuffer().getCount())
+                    req->getBuffer().flush();
+            }
+            DEBUG(m_self << ": load = " << (int)msg->result);
+            break;
     }
     ret = msg->result;
 
@@ -262,6 +337,77 @@ Error FileSystem::processRequest(FileSystemRequest *req)
     return ret;
 }
 
+Error FileSystem::dispatchRequest(FileSystemRequest *req, FileCache *cache)
+{
+    cache->busy++;
+    req->setCache(cache);
+
+    pthread_mutex_lock(&m_workLock);
+    m_pending->append(req);
+    pthread_cond_signal(&m_workCond);
+    pthread_mutex_unlock(&m_workLock);
+
+    return EINPROGRESS;
+}
+
+bool FileSystem::completeRequests()
+{
+    List<FileSystemRequest *> completed;
+
+    pthread_mutex_lock(&m_workLock);
+    completed = move(*m_completed);
+    pthread_mutex_unlock(&m_workLock);
+
+    for (ListIterator<FileSystemRequest *> i(completed); i.hasCurrent(); i++)
+    {
+        FileSystemRequest *req = i.current();
+        req->getCache()->busy--;
+
+        // Retry from the start, the file may be gone by then
+        if (req->getMessage()->result == EAGAIN)
+            m_requests->append(req);
+        else
+        {
+            sendResponse(req->getMessage());
+            delete req;
+        }
+    }
+    return completed.count() > 0;
+}
+
+void * FileSystem::worker(void *fs)
+{
+    FileSystem *self = (FileSystem *) fs;
+    FileSystemRequest *req;
+    FileSystemMessage *msg;
+
+    while (true)
+    {
+        pthread_mutex_lock(&self->m_workLock);
+
+        while (self->m_pending->isEmpty())
+            pthread_cond_wait(&self->m_workCond, &self->m_workLock);
+
+        req = self->m_pending->first();
+        self->m_pending->remove(self->m_pending->head());
+        pthread_mutex_unlock(&self->m_workLock);
+
+        // Read and copy the data to the client
+        msg = req->getMessage();
+        msg->result = req->getCache()->file->read(req->getBuffer(), msg->size, msg->offset);
+        if (req->getBuffer().getCount())
+            req->getBuffer().flush();
+
+        pthread_mutex_lock(&self->m_workLock);
+        self->m_completed->append(req);
+        pthread_mutex_unlock(&self->m_workLock);
+
+        // The main thread sends the response
+        ProcessCtl(self->m_server, Resume, 0);
+    }
+    return ZERO;
+}
+
 void FileSystem::sendResponse(FileSystemMessage *msg)
 {
     msg->type = ChannelMessage::Response;
@@ -279,14 +425,15 @@ void FileSystem::timeout()
 bool FileSystem::retryRequests()
 {
     DEBUG("");
-    bool restartNeeded = false;
+    bool restartNeeded = m_workers && completeRequests();
 
     for (ListIterator<FileSystemRequest *> i(m_requests); i.hasCurrent(); i++)
     {
         Error ret = processRequest(i.current());
         if (ret != EAGAIN)
         {
-            delete i.current();
+            if (ret != EINPROGRESS)
+                delete i.current();
             i.remove();
             restartNeeded = true;
         }
@@ -311,13 +458,13 @@ void FileSystem::setRoot(Directory *newRoot)
 
 FileCache * FileSystem::lookupFile(FileSystemPath *path)
 {
-    List<String *> *entries = path->split();
-    FileCache *c = ZERO;
+    FileCache *c = ZERO, *entry;
     File *file = ZERO;
     Directory *dir;
+    char name[PATHLEN];
 
     /* Loop the entire path. */
-    for (ListIterator<String *> i(entries); i.hasCurrent(); i++)
+    for (Size i = 0; i < path->count(); i++)
     {
         /* Start at root? */
         if (!c)
@@ -325,7 +472,7 @@ FileCache * FileSystem::lookupFile(FileSystemPath *path)
             c = m_root;
         }
         /* Do we have this entry cached already? */
-        if (!c->entries.contains(*i.current()))
+        if (!(entry = findEntry(c, path, i)))
         {
             /* If this isn't a directory, we cannot perform a lookup. */
             if (c->file->getType() != DirectoryFile)
@@ -333,18 +480,19 @@ FileCache * FileSystem::lookupFile(FileSystemPath *path)
                 return ZERO;
             }
             dir = (Directory *) c->file;
-            
+            path->copy(i, name, sizeof(name));
+
             /* Fetch the file, if possible. */
-            if (!(file = dir->lookup(**i.current())))
+            if (!(file = dir->lookup(name)))
             {
                 return ZERO;
             }
             /* Insert into the FileCache. */
-            c = new FileCache(file, **i.current(), c);
+            c = new FileCache(file, name, c);
         }
         /* Move to the next entry. */
         else
-            c = (FileCache *) c->entries.value(*i.current());
+            c = entry;
     }
     /* All done. */
     return c;
@@ -363,27 +511,24 @@ FileCache * FileSystem::insertFileCache(File *file, const char *pathFormat, ...)
 
 FileCache * FileSystem::insertFileCache(File *file, const char *pathFormat, va_list args)
 {
-    char pathStr[PATHLEN];
+    char pathStr[PATHLEN], name[PATHLEN];
     FileSystemPath path;
     FileCache *parent = ZERO;
-        
+
     // Format the path first
     vsnprintf(pathStr, sizeof(pathStr), pathFormat, args);
 
     /* Interpret the given path. */
     path.parse(pathStr);
-        
+
     /* Lookup our parent. */
-    if (!(path.parent()))
-    {
-        parent = m_root;
-    }
-    else if (!(parent = findFileCache(path.parent())))
+    if (!path.count() || !(parent = findParentCache(&path)))
     {
         return ZERO;
     }
     /* Create new cache. */
-    return new FileCache(file, **path.base(), parent);
+    path.copy(path.count() - 1, name, sizeof(name));
+    return new FileCache(file, name, parent);
 }
 
 FileCache * FileSystem::findFileCache(char *path)
@@ -399,21 +544,18 @@ FileCache * FileSystem::findFileCache(String *path)
 
 FileCache * FileSystem::findFileCache(FileSystemPath *p)
 {
-    List<String *> *entries = p->split();
     FileCache *c = m_root;
 
     /* Root is treated special. */
-    if (!p->parent() && p->length() == 0)
+    if (p->count() == 0)
     {
         return m_root;
     }
     /* Loop the entire path. */
-    for (ListIterator<String *> i(entries); i.hasCurrent(); i++)
+    for (Size i = 0; i < p->count(); i++)
     {
-        if (!c->entries.contains(*i.current()))
+        if (!(c = findEntry(c, p, i)))
             return ZERO;
-
-        c = (FileCache *) c->entries.value(*i.current());
     }
     /* Perform cachehit? */
     if (c)
@@ -424,6 +566,26 @@ FileCache * FileSystem::findFileCache(FileSystemPath *p)
     return c && c->valid ? c : ZERO;
 }
 
+FileCache * FileSystem::findParentCache(FileSystemPath *path)
+{
+    FileSystemPath parent = path->parent();
+
+    return parent.count() ? findFileCache(&parent) : m_root;
+}
+
+FileCache * FileSystem::findEntry(FileCache *cache, FileSystemPath *path, Size index)
+{
+    List<HashTable<String, FileCache *>::Bucket> & bucket =
+        cache->entries.table()[path->hash(index, cache->entries.size())];
+
+    // Compare the component with the keys in its bucket
+    for (ListIterator<HashTable<String, FileCache *>::Bucket> i(bucket); i.hasCurrent(); i++)
+        if (path->equals(index, i.current().key))
+            return i.current().value;
+
+    return ZERO;
+}
+
 FileCache * FileSystem::cacheHit(FileCache *cache)
 {
     return cache;
@@ -20,7 +20,9 @@
 
 #include <FreeNOS/System.h>
 #include <ChannelServer.h>
+#include <SystemCallBatch.h>
 #include <Vector.h>
+#include <pthread.h>
 #include "Directory.h"
 #include "Device.h"
 #include "File.h"
@@ -80,6 +82,20 @@ class FileSystem : public ChannelServer<FileSystem, FileSystemMessage>
      */
     Error mount();
 
+    /**
+     * Start worker threads which read files concurrently.
+     *
+     * Only the main thread receives requests and sends replies. It
+     * passes reads of regular files to the workers, which copy the
+     * data to the client in parallel. The File and Storage
+     * implementations must allow concurrent reads without IPC.
+     *
+     * @param count Number of worker threads to start.
+     *
+     * @return Error code.
+     */
+    Error startWorkers(Size count);
+
     /**
      * Register a new File.
      *
@@ -170,6 +186,24 @@ class FileSystem : public ChannelServer<FileSystem, FileSystemMessage>
      */
     Error processRequest(FileSystemRequest *req);
 
+    /**
+     * Pass a read request to the worker threads.
+     *
+     * @param req Request to pass.
+     * @param cache FileCache of the file to read. It cannot be
+     *              written or deleted until the request completes.
+     *
+     * @return EINPROGRESS.
+     */
+    Error dispatchRequest(FileSystemRequest *req, FileCache *cache);
+
+    /**
+     * Send the responses of requests completed by the worker threads.
+     *
+     * @return True if any request was completed, false otherwise.
+     */
+    bool completeRequests();
+
     /**
      * Send response for a FileSystemMessage
      *
@@ -232,6 +266,27 @@ class FileSystem : public ChannelServer<FileSystem, FileSystemMessage>
      */
     FileCache * findFileCache(FileSystemPath *p);
 
+    /**
+     * Search the cache for the parent of an entry.
+     *
+     * @param path Full path of the entry.
+     *
+     * @return Pointer to the FileCache of the parent or the root
+     *         if the entry has no parent. NULL if not cached.
+     */
+    FileCache * findParentCache(FileSystemPath *path);
+
+    /**
+     * Search the entries of a FileCache for a path component.
+     *
+     * @param cache FileCache to search.
+     * @param path Path containing the component.
+     * @param index Index of the component.
+     *
+     * @return Pointer to the FileCache of the entry or NULL if not cached.
+     */
+    FileCache * findEntry(FileCache *cache, FileSystemPath *path, Size index);
+
     /**
      * Process a cache hit.
      *
@@ -248,6 +303,17 @@ class FileSystem : public ChannelServer<FileSystem, FileSystemMessage>
      */
     void clearFileCache(FileCache *cache = ZERO);
 
+  private:
+
+    /**
+     * Entry point of the worker threads.
+     *
+     * @param fs FileSystem instance.
+     *
+     * @return Never.
+     */
+    static void * worker(void *fs);
+
   protected:
 
     /** Root entry of the filesystem tree. */
@@ -258,6 +324,27 @@ class FileSystem : public ChannelServer<FileSystem, FileSystemMessage>
 
     /** Contains ongoing requests */
     List<FileSystemRequest *> *m_requests;
+
+    /** Copies request arguments with a single kernel entry */
+    SystemCallBatch *m_batch;
+
+    /** Number of worker threads started. */
+    Size m_workers;
+
+    /** ProcessID of the main thread. */
+    ProcessID m_server;
+
+    /** Read requests waiting for a worker thread. */
+    List<FileSystemRequest *> *m_pending;
+
+    /** Read requests completed by the worker threads. */
+    List<FileSystemRequest *> *m_completed;
+
+    /** Protects the pending and completed requests. */
+    pthread_mutex_t m_workLock;
+
+    /** Signals the worker threads that a request is pending. */
+    pthread_cond_t m_workCond;
 };
 
 /**
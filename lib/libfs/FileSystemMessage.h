@@ -42,7 +42,9 @@ typedef enum FileSystemAction
     ReadFile,
     WriteFile,
     StatFile,
-    DeleteFile
+    DeleteFile,
+    ReadDirectory,
+    LoadFile
 }
 FileSystemAction;
 
@@ -72,6 +74,7 @@ typedef struct FileSystemMessage : public ChannelMessage
         stat        = m->stat;
         path        = m->path;
         filetype    = m->filetype;
+        target      = m->target;
     }
 
     /**
@@ -102,7 +105,7 @@ typedef struct FileSystemMessage : public ChannelMessage
     /** Size of the buffer. */
     Size size;
 
-    /** Offset in the file for I/O. */
+    /** Offset in the file for I/O, or the resume cookie for ReadDirectory. */
     Size offset;
 
     /** Path name of the file. */
@@ -122,6 +125,9 @@ typedef struct FileSystemMessage : public ChannelMessage
 
     /** Device major/minor numbers. */
     DeviceID deviceID;
+
+    /** Process which receives the data for LoadFile. */
+    ProcessID target;
 }
 FileSystemMessage;
 
@@ -15,113 +15,148 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <string.h>
+#include <MemoryBlock.h>
+#include <HashFunction.h>
 #include "FileSystemPath.h"
 
-/** Shortcut to the separator field. */
-#define SEPARATOR(x) \
-    (this->separator == (x))
-
-/** Test for an End of Line. */
-#define EOL(s,x) \
-    ((x) == (s) + length - 1)
-
 FileSystemPath::FileSystemPath()
-    : m_fullPath(ZERO)
-    , m_fullLength(0)
-    , m_parentPath(ZERO)
-    , m_separator(DEFAULT_SEPARATOR)
+    : m_path("")
+    , m_length(0)
+    , m_count(0)
 {
 }
 
-FileSystemPath::FileSystemPath(char *path, char separator)
-    : m_fullPath(ZERO)
-    , m_fullLength(ZERO)
-    , m_parentPath(ZERO)
+FileSystemPath::FileSystemPath(const char *path, char separator)
 {
     parse(path, separator);
 }
 
-FileSystemPath::FileSystemPath(String *s, char separator)
-    : m_fullPath(ZERO)
-    , m_fullLength(ZERO)
-    , m_parentPath(ZERO)
+FileSystemPath::FileSystemPath(const String *s, char separator)
 {
-    parse((char *) **s, separator);
+    parse(**s, separator);
 }
 
-FileSystemPath::~FileSystemPath()
+bool FileSystemPath::parse(const char *p, char separator)
 {
-    for (ListIterator<String *> i(m_path); i.hasCurrent(); i++)
-        delete i.current();
+    const char *cur;
+
+    // Skip heading separators
+    while (*p && *p == separator)
+        p++;
+
+    m_path   = p;
+    m_length = 0;
+    m_count  = 0;
+
+    // Record a view for each component
+    for (cur = p; *cur; )
+    {
+        const char *start = cur;
+
+        while (*cur && *cur != separator)
+            cur++;
+
+        if (m_count == PATH_COMPONENTS_MAX)
+            return false;
 
-    m_path.clear();
+        m_components[m_count].offset = start - p;
+        m_components[m_count].length = cur - start;
+        m_count++;
+        m_length = cur - p;
 
-    if (m_parentPath) delete m_parentPath;
-    if (m_fullPath) delete m_fullPath;
+        while (*cur && *cur == separator)
+            cur++;
+    }
+    return true;
 }
 
-void FileSystemPath::parse(const char *p, char sep)
+Size FileSystemPath::count() const
 {
-    const char *cur   = p;
-    char *parentStr   = ZERO;
+    return m_count;
+}
 
-    // Skip heading separators
-    while (*cur && *cur == sep) cur++;
-
-    // Save parameters
-    p            = (char *) cur;
-    m_separator  = sep;
-    m_fullLength = strlen((char *)cur);
-    m_fullPath   = new String(cur);
-    String str(p);
-
-    // Split the path into parts
-    List<String> parts = str.split(sep);
-    for (ListIterator<String> i(parts); i.hasCurrent(); i++)
-        m_path.append(new String(i.current()));
-
-    // Create parent, if any
-    if (m_path.head() && m_path.head()->next)
+const char * FileSystemPath::component(Size index) const
+{
+    return m_path + m_components[index].offset;
+}
+
+Size FileSystemPath::componentLength(Size index) const
+{
+    return m_components[index].length;
+}
+
+FileSystemPath FileSystemPath::parent() const
+{
+    FileSystemPath p(*this);
+
+    if (m_count > 1)
     {
-        // Allocate buffer
-        parentStr  = new char[strlen(p)];
-        memset(parentStr, 0, strlen(p));
-
-        // Construct parent path
-        for (List<String *>::Node *l = m_path.head(); l && l->next; l = l->next)
-        {
-            strcat(parentStr, **l->data);
-            if (l->next && l->next->next)
-                strncat(parentStr, &m_separator, 1);
-        }
-        // Save the path, then release buffer
-        m_parentPath = new String(parentStr);
-        delete parentStr;
+        p.m_count  = m_count - 1;
+        p.m_length = m_components[p.m_count - 1].offset + m_components[p.m_count - 1].length;
     }
+    else
+    {
+        p.m_count  = 0;
+        p.m_length = 0;
+    }
+    return p;
 }
 
-String * FileSystemPath::parent() const
+const char * FileSystemPath::base() const
 {
-    return m_parentPath;
+    return m_count ? component(m_count - 1) : ZERO;
 }
 
-String * FileSystemPath::base() const
+const char * FileSystemPath::full() const
 {
-    return m_path.last();
+    return m_path;
 }
 
-String * FileSystemPath::full() const
+Size FileSystemPath::length() const
 {
-    return m_fullPath;
+    return m_length;
 }
 
-List<String *> * FileSystemPath::split()
+Size FileSystemPath::hash(Size index, Size mod) const
 {
-    return &m_path;
+    const char *str = component(index);
+    Size ret = FNV_INIT;
+
+    // Same as hash() of a String
+    for (Size i = 0; i < m_components[index].length; i++)
+    {
+        ret *= FNV_PRIME;
+        ret ^= str[i];
+    }
+    return (ret % mod);
 }
 
-Size FileSystemPath::length() const
+bool FileSystemPath::equals(Size index, const String & str) const
 {
-    return m_fullLength;
+    const char *name = component(index), *other = *str;
+    Size len = m_components[index].length;
+
+    if (str.length() != len)
+        return false;
+
+    for (Size i = 0; i < len; i++)
+        if (name[i] != other[i])
+            return false;
+
+    return true;
+}
+
+Size FileSystemPath::copy(Size index, char *buffer, Size size) const
+{
+    Size len = m_components[index].length;
+
+    if (!size)
+        return 0;
+
+    if (len > size - 1)
+        len = size - 1;
+
+    MemoryBlock::copy(buffer, component(index), len);
+    buffer[len] = ZERO;
+    return len;
 }
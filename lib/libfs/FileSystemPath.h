@@ -18,8 +18,6 @@
 #ifndef __FILESYSTEM_FILESYSTEMPATH_H
 #define __FILESYSTEM_FILESYSTEMPATH_H
 
-#include <List.h>
-#include <ListIterator.h>
 #include <Types.h>
 #include <String.h>
 
@@ -37,8 +35,16 @@
 /** The default FileSystemPath separator. */
 #define DEFAULT_SEPARATOR '/'
 
+/** Maximum number of components in a FileSystemPath. Enough for any path of PATHLEN. */
+#define PATH_COMPONENTS_MAX (PATHLEN / 2)
+
 /**
  * Simple filesystem path parser.
+ *
+ * Splits a path into components without allocating memory. Each component
+ * is a view of an offset and length into the caller's buffer, which must remain
+ * valid and unmodified while the FileSystemPath is used. Leading, trailing
+ * and repeated separators are skipped.
  */
 class FileSystemPath
 {
@@ -55,7 +61,7 @@ class FileSystemPath
      * @param path The input path to parse.
      * @param separator Pathname separator.
      */
-    FileSystemPath(char *path, char separator = DEFAULT_SEPARATOR);
+    FileSystemPath(const char *path, char separator = DEFAULT_SEPARATOR);
 
     /**
      * Constructor using a String.
@@ -63,72 +69,131 @@ class FileSystemPath
      * @param s String containing the path to parse.
      * @param separator Pathname separator.
      */
-    FileSystemPath(String *s, char separator = DEFAULT_SEPARATOR);
-
-    /**
-     * Destructor.
-     */
-    virtual ~FileSystemPath();
+    FileSystemPath(const String *s, char separator = DEFAULT_SEPARATOR);
 
     /**
      * Parses a given character string as the path.
      *
      * @param p Path to parse.
      * @param separator Pathname separator.
+     *
+     * @return True on success, false if the path has more than PATH_COMPONENTS_MAX components.
      */
-    void parse(const char *p, char sep = DEFAULT_SEPARATOR);
+    bool parse(const char *p, char separator = DEFAULT_SEPARATOR);
 
     /**
-     * Retrieve the full path of our parent.
+     * Get the number of components.
      *
-     * @return Path of our parent.
+     * @return Number of components.
      */
-    String * parent() const;
+    Size count() const;
 
     /**
-     * The name of the last element in the path.
+     * Get a component.
+     *
+     * @param index Index of the component.
      *
-     * @return Name of the base.
+     * @return Pointer to the first character of the component. Not terminated.
      */
-    String * base() const;
+    const char * component(Size index) const;
 
     /**
-     * Get the full path as a String instance.
+     * Get the length of a component.
      *
-     * @return String instance.
+     * @param index Index of the component.
+     *
+     * @return Length in bytes.
      */
-    String * full() const;
+    Size componentLength(Size index) const;
 
     /**
-     * Returns a List of separate path elements.
+     * Get the path of our parent.
      *
-     * @return Pointer to a List.
+     * @return View with all but the last component. Empty if there is no parent.
      */
-    List<String *> * split();
+    FileSystemPath parent() const;
+
+    /**
+     * The name of the last element in the path.
+     *
+     * @return Pointer to the last component or ZERO if the path is empty.
+     */
+    const char * base() const;
+
+    /**
+     * Get the full path.
+     *
+     * @return Pointer to the path without leading separators.
+     */
+    const char * full() const;
 
     /**
      * Get Length of our full path.
      *
-     * @return Length.
+     * @return Length without leading and trailing separators.
      */
     Size length() const;
 
+    /**
+     * Compute the hash of a component.
+     *
+     * Equals the hash of a String with the same contents,
+     * such that a component can be looked up in a HashTable directly.
+     *
+     * @param index Index of the component.
+     * @param mod Modulo value.
+     *
+     * @return Computed hash.
+     */
+    Size hash(Size index, Size mod) const;
+
+    /**
+     * Compare a component with a String.
+     *
+     * @param index Index of the component.
+     * @param str String to compare with.
+     *
+     * @return True if equal, false otherwise.
+     */
+    bool equals(Size index, const String & str) const;
+
+    /**
+     * Copy a component to a terminated character string.
+     *
+     * @param index Index of the component.
+     * @param buffer Output buffer.
+     * @param size Size of the output buffer in bytes.
+     *
+     * @return Number of characters copied, excluding the terminator.
+     */
+    Size copy(Size index, char *buffer, Size size) const;
+
   private:
 
-    /** The path split in pieces. */
-    List<String *> m_path;
+    /**
+     * Component view.
+     */
+    typedef struct Component
+    {
+        /** Offset from the start of the path. */
+        u16 offset;
+
+        /** Length in bytes. */
+        u16 length;
+    }
+    Component;
 
-    /** Full input path. */
-    String *m_fullPath;
+    /** Path without leading separators. */
+    const char *m_path;
 
-    /** Full length of the given path. */
-    Size m_fullLength;
+    /** Length of the path without leading and trailing separators. */
+    Size m_length;
 
-    /** Full path to our parent. */
-    String * m_parentPath;
+    /** Number of components. */
+    Size m_count;
 
-    /** Separator character. */
-    char m_separator;
+    /** Component views. */
+    Component m_components[PATH_COMPONENTS_MAX];
 };
 
 /**
@@ -21,6 +21,7 @@ FileSystemRequest::FileSystemRequest(FileSystemMessage *msg)
 {
     m_msg = msg;
     m_ioBuffer = new IOBuffer(&m_msg);
+    m_cache = ZERO;
 }
 
 FileSystemRequest::~FileSystemRequest()
@@ -37,3 +38,13 @@ IOBuffer & FileSystemRequest::getBuffer()
 {
     return *m_ioBuffer;
 }
+
+FileCache * FileSystemRequest::getCache()
+{
+    return m_cache;
+}
+
+void FileSystemRequest::setCache(FileCache *cache)
+{
+    m_cache = cache;
+}
@@ -19,6 +19,7 @@
 #define __FILESYSTEM_FILE_SYSTEM_REQUEST_H
 
 #include "FileSystemMessage.h"
+#include "FileCache.h"
 #include "IOBuffer.h"
 
 /**
@@ -60,6 +61,20 @@ class FileSystemRequest
      */
     IOBuffer & getBuffer();
 
+    /**
+     * Get the FileCache which the request operates on.
+     *
+     * @return FileCache pointer or ZERO if not set.
+     */
+    FileCache * getCache();
+
+    /**
+     * Set the FileCache which the request operates on.
+     *
+     * @param cache FileCache pointer.
+     */
+    void setCache(FileCache *cache);
+
   private:
 
     /** Message that was received */
@@ -67,6 +82,9 @@ class FileSystemRequest
 
     /** Wrapper for doing I/O on the FileSystemMessage buffer. */
     IOBuffer *m_ioBuffer;
+
+    /** File which is read while the request is served by a worker thread. */
+    FileCache *m_cache;
 };
 
 /**
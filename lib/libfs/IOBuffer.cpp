@@ -20,13 +20,15 @@
 IOBuffer::IOBuffer(const FileSystemMessage *msg)
     : m_message(msg)
 {
-    if (msg->action == ReadFile || msg->action == WriteFile)
+    if (msg->action == ReadFile || msg->action == WriteFile ||
+        msg->action == ReadDirectory)
         m_buffer = new u8[msg->size];
     else
         m_buffer = 0;
 
     m_size   = msg->size;
     m_count  = 0;
+    m_target = msg->action == LoadFile ? msg->target : msg->from;
 }
 
 IOBuffer::~IOBuffer()
@@ -56,6 +58,17 @@ Error IOBuffer::bufferedRead()
     return m_count;
 }
 
+SystemCallBatch::Result IOBuffer::bufferedRead(SystemCallBatch *batch)
+{
+    return batch->vmCopy(m_message->from, API::Read, (Address) m_buffer,
+                         (Address) m_message->buffer, m_message->size);
+}
+
+void IOBuffer::setCount(Size count)
+{
+    m_count = count;
+}
+
 Error IOBuffer::bufferedWrite(void *buffer, Size size)
 {
     Size i = 0;
@@ -79,7 +92,7 @@ Error IOBuffer::read(void *buffer, Size size, Size offset) const
 
 Error IOBuffer::write(void *buffer, Size size, Size offset) const
 {
-    return VMCopy(m_message->from, API::Write,
+    return VMCopy(m_target, API::Write,
                  (Address) buffer,
                  (Address) m_message->buffer + offset, size);
 }
@@ -20,6 +20,7 @@
 
 #include <FreeNOS/System.h>
 #include <Types.h>
+#include <SystemCallBatch.h>
 #include "FileSystemMessage.h"
 
 /**
@@ -99,6 +100,24 @@ class IOBuffer
      */
     Error bufferedRead();
 
+    /**
+     * Buffered read bytes from message to the I/O buffer, as part of a batch.
+     *
+     * After executing the batch, pass its result to setCount().
+     *
+     * @param batch Batch to add the VMCopy() to.
+     *
+     * @return Result code of the batch.
+     */
+    SystemCallBatch::Result bufferedRead(SystemCallBatch *batch);
+
+    /**
+     * Set byte count.
+     *
+     * @param count Number of valid bytes in the internal buffer.
+     */
+    void setCount(Size count);
+
     /**
      * Buffered write bytes to the I/O buffer.
      *
@@ -140,6 +159,9 @@ class IOBuffer
      */
     const FileSystemMessage *m_message;
 
+    /** Process which receives output from write(). */
+    ProcessID m_target;
+
     /** Buffer for storing temporary data. */
     u8 *m_buffer;
 
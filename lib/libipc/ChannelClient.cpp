@@ -16,10 +16,10 @@
  */
 
 #include <FreeNOS/System.h>
-#include <HashIterator.h>
+#include <FastHashIterator.h>
 #include <FileSystemMessage.h>
 #include "ChannelClient.h"
-#include "MemoryChannel.h"
+#include "FixedMemoryChannel.h"
 
 ChannelClient::ChannelClient()
     : Singleton<ChannelClient>(this)
@@ -49,34 +49,14 @@ ChannelClient::Result ChannelClient::initialize()
 
 ChannelClient::Result ChannelClient::connect(ProcessID pid, Size messageSize)
 {
-    Address prodAddr, consAddr;
     SystemInformation info;
 
-    // Allocate consumer
-    MemoryChannel *cons = new MemoryChannel;
-    if (!cons)
-    {
-        return OutOfMemory;
-    }
-    cons->setMessageSize(messageSize);
-    cons->setMode(Channel::Consumer);
-
-    // Allocate producer
-    MemoryChannel *prod = new MemoryChannel;
-    if (!prod)
-    {
-        delete cons;
-        return OutOfMemory;
-    }
-    prod->setMessageSize(messageSize);
-    prod->setMode(Channel::Producer);
-
     // Call VMShare to create shared memory mapping for MemoryChannel.
     ProcessShares::MemoryShare share;
     share.pid    = pid;
     share.coreId = info.coreId;
     share.tagId  = 0;
-    share.range.size = PAGESIZE * 4;
+    share.range.size = CHANNEL_SHARE_SIZE;
     share.range.virt = 0;
     share.range.phys = 0;
     share.range.access = Memory::User | Memory::Readable | Memory::Writable;
@@ -86,22 +66,42 @@ ChannelClient::Result ChannelClient::connect(ProcessID pid, Size messageSize)
     switch (r)
     {
         case API::Success:
-        {
-            prodAddr = share.range.virt;
-            consAddr = share.range.virt + (PAGESIZE * 2);
-            break;
-        }
+            return attach(pid, share.range.virt, messageSize);
+
         case API::AlreadyExists:
-        {
-            prodAddr = share.range.virt + (PAGESIZE * 2);
-            consAddr = share.range.virt;
-            break;
-        }
+            return setup(pid, share.range.virt + (PAGESIZE * 2), share.range.virt, messageSize);
+
         default:
-        {
             return IOError;
-        }
     }
+}
+
+ChannelClient::Result ChannelClient::attach(ProcessID pid, Address virt, Size messageSize)
+{
+    return setup(pid, virt, virt + (PAGESIZE * 2), messageSize);
+}
+
+ChannelClient::Result ChannelClient::setup(ProcessID pid,
+                                           Address prodAddr,
+                                           Address consAddr,
+                                           Size messageSize)
+{
+    // Allocate consumer
+    MemoryChannel *cons = createChannel(messageSize);
+    if (!cons)
+    {
+        return OutOfMemory;
+    }
+    cons->setMode(Channel::Consumer);
+
+    // Allocate producer
+    MemoryChannel *prod = createChannel(messageSize);
+    if (!prod)
+    {
+        delete cons;
+        return OutOfMemory;
+    }
+    prod->setMode(Channel::Producer);
 
     // Setup producer memory address
     if (prod->setVirtual(prodAddr, prodAddr + PAGESIZE) != MemoryChannel::Success)
@@ -125,9 +125,23 @@ ChannelClient::Result ChannelClient::connect(ProcessID pid, Size messageSize)
     return Success;
 }
 
+MemoryChannel * ChannelClient::createChannel(Size messageSize)
+{
+    MemoryChannel *ch;
+
+    // Most connections carry FileSystemMessages
+    if (messageSize == sizeof(FileSystemMessage))
+        return new FixedMemoryChannel<FileSystemMessage>;
+
+    if ((ch = new MemoryChannel) != ZERO)
+        ch->setMessageSize(messageSize);
+
+    return ch;
+}
+
 ChannelClient::Result ChannelClient::receiveAny(void *buffer, ProcessID *pid)
 {
-    for (HashIterator<ProcessID, Channel *> i(m_registry->getConsumers()); i.hasCurrent(); i++)
+    for (FastHashIterator<ProcessID, Channel *> i(m_registry->getConsumers()); i.hasCurrent(); i++)
     {
         if (i.current()->read(buffer) == Channel::Success)
         {
@@ -276,9 +290,31 @@ ChannelClient::Result ChannelClient::syncSendTo(void *buffer, ProcessID pid)
 
 ChannelClient::Result ChannelClient::syncSendReceive(void *buffer, ProcessID pid)
 {
-    Result r = syncSendTo(buffer, pid);
-    if (r != Success)
-        return r;
+    Channel *prod = findProducer(pid);
+    Channel *cons = findConsumer(pid);
+    if (!prod || !cons)
+        return NotFound;
 
-    return syncReceiveFrom(buffer, pid);
+    while (true)
+    {
+        switch (prod->write(buffer))
+        {
+            case Channel::Success:
+                // Wakeup the receiver and switch to it directly
+                ProcessCtl(pid, ResumeSleep, 0);
+
+                while (cons->read(buffer) != Channel::Success)
+                    ProcessCtl(SELF, EnterSleep, 0);
+                return Success;
+
+            case Channel::ChannelFull:
+                ProcessCtl(pid, Resume, 0);
+                break;
+
+            default:
+                return IOError;
+        }
+        ProcessCtl(SELF, Schedule, 0);
+    }
+    return IOError;
 }
@@ -26,6 +26,9 @@
 #include "ChannelMessage.h"
 #include <FileSystemMessage.h>
 
+/** Forward declarations */
+class MemoryChannel;
+
 /**
  * @addtogroup lib
  * @{
@@ -34,6 +37,9 @@
  * @{
  */
 
+/** Size of the memory share which holds the two MemoryChannels of a connection. */
+#define CHANNEL_SHARE_SIZE (PAGESIZE * 4)
+
 /**
  * Client for using Channels.
  */
@@ -126,6 +132,21 @@ class ChannelClient : public Singleton<ChannelClient>
      */
     virtual Result connect(ProcessID pid, Size msgSize = sizeof(FileSystemMessage));
 
+    /**
+     * Attach to a memory share which was already created.
+     *
+     * Registers the producer and consumer Channel inside a share
+     * of CHANNEL_SHARE_SIZE bytes which was created for us, for example
+     * by our parent using VMShare() with API::Connect.
+     *
+     * @param pid ProcessID of the other side of the share.
+     * @param virt Virtual address of the share in our address space.
+     * @param msgSize Default message size to use.
+     *
+     * @return Result code
+     */
+    virtual Result attach(ProcessID pid, Address virt, Size msgSize = sizeof(FileSystemMessage));
+
     /**
      * Try to receive message from any channel.
      *
@@ -187,6 +208,9 @@ class ChannelClient : public Singleton<ChannelClient>
     /**
      * Synchronous send and receive to/from one process.
      *
+     * After sending, the kernel switches directly to the receiving
+     * process instead of letting the scheduler select the next process.
+     *
      * @param buffer Message buffer to send/receive
      * @param pid ProcessID for the channel
      *
@@ -214,6 +238,27 @@ class ChannelClient : public Singleton<ChannelClient>
      */
     Channel * findProducer(ProcessID pid);
 
+    /**
+     * Create and register the producer and consumer Channel.
+     *
+     * @param pid ProcessID of the other side.
+     * @param prodAddr Virtual address of the producer Channel pages.
+     * @param consAddr Virtual address of the consumer Channel pages.
+     * @param msgSize Message size to use.
+     *
+     * @return Result code
+     */
+    Result setup(ProcessID pid, Address prodAddr, Address consAddr, Size msgSize);
+
+    /**
+     * Create a MemoryChannel for the given message size.
+     *
+     * @param messageSize Message size to use.
+     *
+     * @return MemoryChannel object or ZERO if out of memory.
+     */
+    MemoryChannel * createChannel(Size messageSize);
+
   private:
 
     /** Contains registered channels */
@@ -21,11 +21,12 @@
 #include <FreeNOS/System.h>
 #include <FreeNOS/ProcessEvent.h>
 #include <FreeNOS/ProcessShares.h>
-#include <HashIterator.h>
+#include <FastHashIterator.h>
 #include <Timer.h>
-#include "MemoryChannel.h"
+#include "FixedMemoryChannel.h"
 #include "ChannelClient.h"
 #include "ChannelRegistry.h"
+#include "TimerQueue.h"
 
 /**
  * @addtogroup lib
@@ -91,8 +92,9 @@ template <class Base, class MsgType> class ChannelServer
      * @param num Number of message handlers to support.
      */
     ChannelServer(Base *inst, Size num = 32)
-        : m_sendReply(true), m_instance(inst)
+        : m_sendReply(true), m_irqWatched(false), m_instance(inst)
     {
+        m_lastReply = ANY;
         m_self = ProcessCtl(SELF, GetPID, 0);
 
         m_client   = ChannelClient::instance;
@@ -117,7 +119,6 @@ template <class Base, class MsgType> class ChannelServer
         else
         {
             m_kernelEvent.setMode(Channel::Consumer);
-            m_kernelEvent.setMessageSize(sizeof(ProcessEvent));
             m_kernelEvent.setVirtual(share.range.virt,
                                      share.range.virt + PAGESIZE);
         }
@@ -150,6 +151,14 @@ template <class Base, class MsgType> class ChannelServer
             // Process kernel events
             readKernelEvents();
 
+            // Process pending interrupts
+            if (m_irqWatched)
+                readInterrupts();
+
+            // Process expired timers
+            if (m_timers.isActive())
+                readTimers();
+
             // Process user messages
             readChannels();
 
@@ -164,7 +173,16 @@ template <class Base, class MsgType> class ChannelServer
             if (m_expiry.frequency)
                 expiry = (Address) &m_expiry;
 
-            Error r = ProcessCtl(SELF, EnterSleep, expiry, (Address) &m_time);
+            Error r;
+
+            // Prefer to continue with the client which received the last reply
+            if (m_lastReply != ANY)
+            {
+                r = ProcessCtl(m_lastReply, SwitchSleep, expiry, (Address) &m_time);
+                m_lastReply = ANY;
+            }
+            else
+                r = ProcessCtl(SELF, EnterSleep, expiry, (Address) &m_time);
             DEBUG("EnterSleep returned: " << (int)r);
 
             // Check for sleep timeout
@@ -207,6 +225,7 @@ template <class Base, class MsgType> class ChannelServer
     void addIRQHandler(Size slot, IRQHandlerFunction h)
     {
         m_irqHandlers->insert(slot, new MessageHandler<IRQHandlerFunction>(h, false));
+        m_irqWatched = true;
     }
 
     /**
@@ -217,6 +236,29 @@ template <class Base, class MsgType> class ChannelServer
         DEBUG("");
     }
 
+    /**
+     * Called when a timer armed on the TimerQueue expired.
+     *
+     * @param id Timer identifier.
+     * @param count Number of expirations since the last call.
+     */
+    virtual void timerExpired(u32 id, Size count)
+    {
+        DEBUG("id = " << id << " count = " << count);
+    }
+
+    /**
+     * Get the TimerQueue.
+     *
+     * Unlike setTimeout(), any number of timers can be armed at the same time.
+     *
+     * @return TimerQueue reference.
+     */
+    TimerQueue & timers()
+    {
+        return m_timers;
+    }
+
     /**
      * Retry any pending requests
      *
@@ -262,18 +304,16 @@ template <class Base, class MsgType> class ChannelServer
         // Create consumer
         if (!m_registry->getConsumer(pid))
         {
-            MemoryChannel *consumer = new MemoryChannel;
+            FixedMemoryChannel<MsgType> *consumer = new FixedMemoryChannel<MsgType>;
             consumer->setMode(Channel::Consumer);
-            consumer->setMessageSize(sizeof(MsgType));
             consumer->setVirtual(range.virt, range.virt + PAGESIZE);
             m_registry->registerConsumer(pid, consumer);
         }
         // Create producer
         if (!m_registry->getProducer(pid))
         {
-            MemoryChannel *producer = new MemoryChannel;
+            FixedMemoryChannel<MsgType> *producer = new FixedMemoryChannel<MsgType>;
             producer->setMode(Channel::Producer);
-            producer->setMessageSize(sizeof(MsgType));
             producer->setVirtual(range.virt + (PAGESIZE*2),
                                  range.virt + (PAGESIZE*3));
             m_registry->registerProducer(pid, producer);
@@ -304,16 +344,6 @@ template <class Base, class MsgType> class ChannelServer
                     accept(event.share.pid, event.share.range);
                     break;
                 }
-                case InterruptEvent:
-                {
-                    DEBUG(m_self << ": interrupt: " << event.number);
-
-                    if (m_irqHandlers->at(event.number))
-                    {
-                        (m_instance->*(m_irqHandlers->at(event.number))->exec) (event.number);
-                    }
-                    break;
-                }
                 case ProcessTerminated:
                 {
                     DEBUG(m_self << ": process terminated: PID " << event.number);
@@ -332,6 +362,53 @@ template <class Base, class MsgType> class ChannelServer
         return Success;
     }
 
+    /**
+     * Read and process pending interrupts.
+     *
+     * The kernel wakes us up directly on a watched interrupt and
+     * counts any further interrupts until they are read here.
+     *
+     * @return Result code.
+     */
+    Result readInterrupts()
+    {
+        InterruptInfo info;
+
+        while (ProcessCtl(SELF, ReadIRQ, (Address) &info) == API::Success)
+        {
+            DEBUG(m_self << ": interrupt: " << info.irq << " count: " << info.count <<
+                  " latency: " << (u32) (timestamp() - info.timestamp));
+
+            if (info.irq < m_irqHandlers->size() && m_irqHandlers->at(info.irq))
+            {
+                (m_instance->*(m_irqHandlers->at(info.irq))->exec) (info.irq);
+            }
+        }
+        return Success;
+    }
+
+    /**
+     * Read expired timers and invoke timerExpired() for each.
+     *
+     * @return Result code.
+     */
+    Result readTimers()
+    {
+        TimerEvent events[TIMERQUEUE_READ_MAX];
+        Size count;
+
+        do
+        {
+            count = m_timers.read(events, TIMERQUEUE_READ_MAX);
+
+            for (Size i = 0; i < count; i++)
+                timerExpired(events[i].id, events[i].count);
+        }
+        while (count == TIMERQUEUE_READ_MAX);
+
+        return Success;
+    }
+
     /**
      * Read each Channel for messages.
      *
@@ -339,10 +416,11 @@ template <class Base, class MsgType> class ChannelServer
      */
     Result readChannels()
     {
+        MessageHandler<IPCHandlerFunction> *handler;
         MsgType msg;
 
         // Try to receive message on each consumer channel
-        for (HashIterator<ProcessID, Channel *> i(m_registry->getConsumers()); i.hasCurrent(); i++)
+        for (FastHashIterator<ProcessID, Channel *> i(m_registry->getConsumers()); i.hasCurrent(); i++)
         {
             Channel *ch = i.current();
             DEBUG(m_self << ": trying to receive from PID " << i.key());
@@ -363,10 +441,10 @@ template <class Base, class MsgType> class ChannelServer
                     }
                 }
                 // Message is a request to us
-                else if (m_ipcHandlers->at(msg.action))
+                else if ((handler = (*m_ipcHandlers)[msg.action]) != ZERO)
                 {
-                    m_sendReply = m_ipcHandlers->at(msg.action)->sendReply;
-                    (m_instance->*(m_ipcHandlers->at(msg.action))->exec) (&msg);
+                    m_sendReply = handler->sendReply;
+                    (m_instance->*handler->exec) (&msg);
 
                     // Send reply
                     if (m_sendReply)
@@ -381,7 +459,10 @@ template <class Base, class MsgType> class ChannelServer
                             ERROR(m_self << ": failed to send reply message to PID: " << i.key());
                         }
                         else
+                        {
                             ProcessCtl(i.key(), Resume, 0);
+                            m_lastReply = i.key();
+                        }
                     }
                 }
             }
@@ -407,11 +488,17 @@ template <class Base, class MsgType> class ChannelServer
     ChannelClient *m_client;
 
     /** Kernel event channel */
-    MemoryChannel m_kernelEvent;
+    FixedMemoryChannel<ProcessEvent> m_kernelEvent;
 
     /** Should we send a reply message? */
     bool m_sendReply;
 
+    /** True if at least one IRQ handler is registered. */
+    bool m_irqWatched;
+
+    /** Client which received the last reply or ANY if none. */
+    ProcessID m_lastReply;
+
     /** IPC handler functions. */
     Vector<MessageHandler<IPCHandlerFunction> *> *m_ipcHandlers;
 
@@ -427,6 +514,9 @@ template <class Base, class MsgType> class ChannelServer
     /** System timer value */
     Timer::Info m_time;
 
+    /** Timers armed by the server */
+    TimerQueue m_timers;
+
   private:
 
     /** System timer expiration value */
@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBIPC_FIXEDMEMORYCHANNEL_H
+#define __LIBIPC_FIXEDMEMORYCHANNEL_H
+
+#include <FreeNOS/System.h>
+#include <Types.h>
+#include <Atomic.h>
+#include "MemoryChannel.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libipc
+ * @{
+ */
+
+/**
+ * MemoryChannel for one message type, configured at compile time.
+ *
+ * Uses the same memory layout as a MemoryChannel with a message size
+ * of sizeof(MsgType), so either end of a connection may use it. The
+ * message slots are accessed directly in the shared pages: reserve()
+ * and peek() give a pointer to the slot, such that a message can be
+ * filled in or handled in place without copying it.
+ *
+ * @param MsgType Type of message transferred.
+ * @param Depth Number of message slots. Must be a power of two.
+ */
+template <class MsgType, Size Depth = memoryChannelDepth(sizeof(MsgType))>
+class FixedMemoryChannel : public MemoryChannel
+{
+  private:
+
+    static_assert(Depth >= 2 && !(Depth & (Depth - 1)),
+                  "Depth must be a power of two of at least two");
+    static_assert(sizeof(MsgType) >= sizeof(RingHead),
+                  "Message must be at least as large as the ring head");
+    static_assert(sizeof(MsgType) % sizeof(u32) == 0,
+                  "Message size must be a multiple of 32-bit words");
+    static_assert((Depth + 1) * sizeof(MsgType) <= PAGESIZE,
+                  "Ring head and messages must fit in the data page");
+
+    /** Mask to wrap indices around. */
+    static const Size Mask = Depth - 1;
+
+  public:
+
+    /**
+     * Constructor
+     */
+    FixedMemoryChannel()
+        : MemoryChannel()
+    {
+        m_messageSize = sizeof(MsgType);
+        m_maximumMessages = Depth;
+    }
+
+    /**
+     * Set message size.
+     *
+     * @param size Must be sizeof(MsgType).
+     *
+     * @return Result code.
+     */
+    virtual Result setMessageSize(Size size)
+    {
+        return size == sizeof(MsgType) ? Success : InvalidSize;
+    }
+
+    /**
+     * Get the next free message slot.
+     *
+     * The message becomes visible to the consumer on commit().
+     *
+     * @return Pointer to the message slot or ZERO if the channel is full.
+     */
+    inline MsgType * reserve()
+    {
+        if (((m_head.index + 1) & Mask) == feedbackHead()->index)
+            return ZERO;
+
+        Atomic<Size>::acquire();
+        return slot(m_head.index);
+    }
+
+    /**
+     * Publish the message filled in after reserve().
+     */
+    inline void commit()
+    {
+        Atomic<Size>::release();
+        m_head.index = (m_head.index + 1) & Mask;
+        dataHead()->index = m_head.index;
+    }
+
+    /**
+     * Get the next incoming message.
+     *
+     * The message slot is released on consume().
+     *
+     * @return Pointer to the message or ZERO if none is present.
+     */
+    inline const MsgType * peek()
+    {
+        if (dataHead()->index == m_head.index)
+            return ZERO;
+
+        Atomic<Size>::acquire();
+        return slot(m_head.index);
+    }
+
+    /**
+     * Release the message returned by peek().
+     */
+    inline void consume()
+    {
+        Atomic<Size>::release();
+        m_head.index = (m_head.index + 1) & Mask;
+        feedbackHead()->index = m_head.index;
+    }
+
+    /**
+     * Read a message.
+     *
+     * @param msg Output message.
+     *
+     * @return Result code.
+     */
+    inline Result read(MsgType *msg)
+    {
+        const MsgType *m = peek();
+
+        if (!m)
+            return NotFound;
+
+        *msg = *m;
+        consume();
+        return Success;
+    }
+
+    /**
+     * Write a message.
+     *
+     * @param msg Input message.
+     *
+     * @return Result code.
+     */
+    inline Result write(const MsgType & msg)
+    {
+        MsgType *m = reserve();
+
+        if (!m)
+            return ChannelFull;
+
+        *m = msg;
+        commit();
+        return Success;
+    }
+
+    /**
+     * Read a message.
+     *
+     * @param buffer Output buffer for the message.
+     *
+     * @return Result code.
+     */
+    virtual Result read(void *buffer)
+    {
+        return read((MsgType *) buffer);
+    }
+
+    /**
+     * Write a message.
+     *
+     * @param buffer Input buffer for the message.
+     *
+     * @return Result code.
+     */
+    virtual Result write(void *buffer)
+    {
+        return write(*(const MsgType *) buffer);
+    }
+
+  private:
+
+    /**
+     * Get a message slot in the data page.
+     *
+     * @param index Ring index of the slot.
+     *
+     * @return Message pointer.
+     */
+    inline MsgType * slot(Size index) const
+    {
+        return (MsgType *) (m_data.getBase() + ((index + 1) * sizeof(MsgType)));
+    }
+
+    /**
+     * Get the ring head written by the producer.
+     *
+     * @return RingHead pointer in the data page.
+     */
+    inline volatile RingHead * dataHead() const
+    {
+        return (volatile RingHead *) m_data.getBase();
+    }
+
+    /**
+     * Get the ring head written by the consumer.
+     *
+     * @return RingHead pointer in the feedback page.
+     */
+    inline volatile RingHead * feedbackHead() const
+    {
+        return (volatile RingHead *) m_feedback.getBase();
+    }
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBIPC_FIXEDMEMORYCHANNEL_H */
@@ -35,7 +35,7 @@ MemoryChannel::Result MemoryChannel::setMessageSize(Size size)
         return InvalidArgument;
 
     m_messageSize = size;
-    m_maximumMessages = (PAGESIZE / m_messageSize) - 1;
+    m_maximumMessages = memoryChannelDepth(m_messageSize);
 
     return Success;
 }
@@ -73,7 +73,7 @@ MemoryChannel::Result MemoryChannel::read(void *buffer)
     m_data.read((m_head.index+1) * m_messageSize, m_messageSize, buffer);
 
     // Increment head index
-    m_head.index = (m_head.index + 1) % m_maximumMessages;
+    m_head.index = (m_head.index + 1) & (m_maximumMessages - 1);
 
     // Update read index
     m_feedback.write(0, sizeof(m_head), &m_head);
@@ -88,14 +88,14 @@ MemoryChannel::Result MemoryChannel::write(void *buffer)
     m_feedback.read(0, sizeof(RingHead), &reader);
 
     // Check if buffer space is available for the message
-    if (((m_head.index + 1) % m_maximumMessages) == reader.index)
+    if (((m_head.index + 1) & (m_maximumMessages - 1)) == reader.index)
         return ChannelFull;
 
     // write the message
     m_data.write((m_head.index+1) * m_messageSize, m_messageSize, buffer);
 
     // Increment write index
-    m_head.index = (m_head.index + 1) % m_maximumMessages;
+    m_head.index = (m_head.index + 1) & (m_maximumMessages - 1);
     m_data.write(0, sizeof(m_head), &m_head);
     return Success;
 }
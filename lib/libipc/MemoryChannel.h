@@ -30,6 +30,24 @@
  * @{
  */
 
+/**
+ * Get the number of message slots in a MemoryChannel.
+ *
+ * The first slot of the data page holds the ring head, followed
+ * by the largest power of two number of messages which fit in the page.
+ * Both ends of a channel must agree on this layout.
+ *
+ * @param messageSize Size of each message in bytes.
+ * @param depth Candidate number of slots (used for recursion).
+ *
+ * @return Number of message slots.
+ */
+constexpr Size memoryChannelDepth(Size messageSize, Size depth = PAGESIZE)
+{
+    return (depth <= 1 || (depth + 1) * messageSize <= PAGESIZE)
+           ? depth : memoryChannelDepth(messageSize, depth >> 1);
+}
+
 /**
  * Unidirectional point-to-point channel using shared memory.
  *
@@ -39,10 +57,15 @@
  * to the data page. The feedback page is written only by the
  * consumer, where it stores the feedback information from its
  * consumption, such as the total bytes read and status.
+ *
+ * The number of message slots is a power of two, such that indices
+ * wrap around with a mask.
+ *
+ * @see FixedMemoryChannel
  */
 class MemoryChannel : public Channel
 {
-  private:
+  protected:
 
     /**
      * Defines in-memory ring header
@@ -142,7 +165,7 @@ class MemoryChannel : public Channel
         return false;
     }
 
-  private:
+  protected:
 
     /** The data page */
     Arch::IO m_data;
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <MemoryBlock.h>
+#include "SystemCallBatch.h"
+
+SystemCallBatch::SystemCallBatch()
+{
+    MemoryBlock::set(&m_ring, 0, sizeof(m_ring));
+    m_count = 0;
+}
+
+Size SystemCallBatch::count() const
+{
+    return m_count;
+}
+
+SystemCallBatch::Result SystemCallBatch::add(API::Number number,
+                                             ulong arg1, ulong arg2, ulong arg3,
+                                             ulong arg4, ulong arg5, bool linked)
+{
+    if (m_count >= SYSTEMCALL_RING_SIZE)
+        return QueueFull;
+
+    SystemCallEntry *entry = &m_ring.submit[m_ring.submitTail % SYSTEMCALL_RING_SIZE];
+    entry->number   = number;
+    entry->flags    = linked ? (u32) SystemCallLinked : 0;
+    entry->args[0]  = arg1;
+    entry->args[1]  = arg2;
+    entry->args[2]  = arg3;
+    entry->args[3]  = arg4;
+    entry->args[4]  = arg5;
+    entry->userData = m_count;
+
+    m_results[m_count++] = API::Cancelled;
+    m_ring.submitTail++;
+    return Success;
+}
+
+SystemCallBatch::Result SystemCallBatch::processCtl(ProcessID proc, ProcessOperation op,
+                                                    Address addr, Address output, bool linked)
+{
+    return add(API::ProcessCtlNumber, proc, op, addr, output, 0, linked);
+}
+
+SystemCallBatch::Result SystemCallBatch::vmCopy(ProcessID proc, API::Operation how, Address ours,
+                                                Address theirs, Size sz, bool linked)
+{
+    return add(API::VMCopyNumber, proc, how, ours, theirs, sz, linked);
+}
+
+SystemCallBatch::Result SystemCallBatch::vmCtl(ProcessID proc, MemoryOperation op,
+                                               Memory::Range *range, bool linked)
+{
+    return add(API::VMCtlNumber, proc, op, (Address) range, 0, 0, linked);
+}
+
+SystemCallBatch::Result SystemCallBatch::vmShare(ProcessID proc, API::Operation op,
+                                                 ProcessShares::MemoryShare *share, bool linked)
+{
+    return add(API::VMShareNumber, proc, op, (Address) share, 0, 0, linked);
+}
+
+SystemCallBatch::Result SystemCallBatch::execute()
+{
+    // The completion queue is never fuller than one batch,
+    // so the kernel always executes all entries at once.
+    if (SystemCallEnter(&m_ring) < 0)
+        return IOError;
+
+    // Collect the results
+    while (m_ring.completeHead != m_ring.completeTail)
+    {
+        const SystemCallCompletion *done = &m_ring.complete[m_ring.completeHead % SYSTEMCALL_RING_SIZE];
+
+        if (done->userData < m_count)
+            m_results[done->userData] = done->result;
+
+        m_ring.completeHead++;
+    }
+    return m_ring.submitHead == m_ring.submitTail ? Success : IOError;
+}
+
+API::Result SystemCallBatch::getResult(Size index) const
+{
+    if (index >= m_count)
+        return API::InvalidArgument;
+
+    return m_results[index];
+}
+
+bool SystemCallBatch::succeeded() const
+{
+    for (Size i = 0; i < m_count; i++)
+        if (m_results[i] < 0)
+            return false;
+
+    return true;
+}
+
+void SystemCallBatch::clear()
+{
+    m_count = 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBIPC_SYSTEMCALLBATCH_H
+#define __LIBIPC_SYSTEMCALLBATCH_H
+
+#include <FreeNOS/System.h>
+#include <Types.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libipc
+ * @{
+ */
+
+/**
+ * Collects system calls and executes them with a single kernel entry.
+ *
+ * @see SystemCallEnter
+ */
+class SystemCallBatch
+{
+  public:
+
+    /**
+     * Result codes.
+     */
+    enum Result
+    {
+        Success,
+        QueueFull,
+        IOError
+    };
+
+  public:
+
+    /**
+     * Constructor.
+     */
+    SystemCallBatch();
+
+    /**
+     * Get the number of system calls in the batch.
+     *
+     * @return Number of system calls added since the last clear().
+     */
+    Size count() const;
+
+    /**
+     * Add a system call.
+     *
+     * @param number API number of the system call.
+     * @param arg1 First argument.
+     * @param arg2 Second argument.
+     * @param arg3 Third argument.
+     * @param arg4 Fourth argument.
+     * @param arg5 Fifth argument.
+     * @param linked If true, the next system call is cancelled if this one fails.
+     *
+     * @return Result code
+     */
+    Result add(API::Number number,
+               ulong arg1 = 0, ulong arg2 = 0, ulong arg3 = 0,
+               ulong arg4 = 0, ulong arg5 = 0, bool linked = false);
+
+    /**
+     * Add a ProcessCtl() call.
+     *
+     * @return Result code
+     */
+    Result processCtl(ProcessID proc, ProcessOperation op,
+                      Address addr = 0, Address output = 0, bool linked = false);
+
+    /**
+     * Add a VMCopy() call.
+     *
+     * @return Result code
+     */
+    Result vmCopy(ProcessID proc, API::Operation how, Address ours,
+                  Address theirs, Size sz, bool linked = false);
+
+    /**
+     * Add a VMCtl() call.
+     *
+     * @return Result code
+     */
+    Result vmCtl(ProcessID proc, MemoryOperation op,
+                 Memory::Range *range, bool linked = false);
+
+    /**
+     * Add a VMShare() call.
+     * @return Result code
+     */
+    Result vmShare(ProcessID proc, API::Operation op,
+                   ProcessShares::MemoryShare *share, bool linked = false);
+
+    /**
+     * Execute all system calls in the batch.
+     *
+     * @return Result code
+     */
+    Result execute();
+
+    /**
+     * Get the result of a system call.
+     *
+     * @param index Position of the system call in the batch.
+     *
+     * @return Return value of the system call, API::Cancelled if
+     *         a linked system call before it failed.
+     */
+    API::Result getResult(Size index) const;
+
+    /**
+     * Check if all system calls succeeded.
+     *
+     * @return True if no system call returned an error code.
+     */
+    bool succeeded() const;
+
+    /**
+     * Start a new batch.
+     */
+    void clear();
+
+  private:
+
+    /** Submission and completion queues shared with the kernel */
+    SystemCallRing m_ring;
+
+    /** Number of system calls in the batch */
+    Size m_count;
+
+    /** Results indexed by position in the batch */
+    API::Result m_results[SYSTEMCALL_RING_SIZE];
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBIPC_SYSTEMCALLBATCH_H */
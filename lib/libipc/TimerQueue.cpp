@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <MemoryBlock.h>
+#include "TimerQueue.h"
+
+TimerQueue::TimerQueue()
+{
+    MemoryBlock::set(&m_info, 0, sizeof(m_info));
+    m_active = false;
+}
+
+bool TimerQueue::isActive() const
+{
+    return m_active;
+}
+
+TimerQueue::Result TimerQueue::arm(u32 id, Size msec, bool periodic)
+{
+    TimerSpec spec;
+
+    // Retrieve the timer frequency once
+    if (!m_info.frequency && ProcessCtl(SELF, InfoTimer, (Address) &m_info) != API::Success)
+        return IOError;
+
+    if (!m_info.frequency)
+        return IOError;
+
+    spec.id       = id;
+    spec.ticks    = toTicks(msec);
+    spec.interval = periodic ? spec.ticks : 0;
+
+    switch (ProcessCtl(SELF, ArmTimer, (Address) &spec))
+    {
+        case API::Success:
+            m_active = true;
+            return Success;
+
+        case API::OutOfMemory:
+            return OutOfTimers;
+
+        default:
+            return IOError;
+    }
+}
+
+TimerQueue::Result TimerQueue::disarm(u32 id)
+{
+    switch (ProcessCtl(SELF, DisarmTimer, id))
+    {
+        case API::Success:
+            return Success;
+
+        case API::NotFound:
+            return NotFound;
+
+        default:
+            return IOError;
+    }
+}
+
+Size TimerQueue::read(TimerEvent *events, Size max)
+{
+    API::Result r = ProcessCtl(SELF, ReadTimers, (Address) events, max);
+
+    return r > 0 ? (Size) r : 0;
+}
+
+u32 TimerQueue::toTicks(Size msec)
+{
+    u32 ticks = ((u64) msec * m_info.frequency) / 1000;
+
+    return ticks ? ticks : 1;
+}
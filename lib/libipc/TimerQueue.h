@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBIPC_TIMERQUEUE_H
+#define __LIBIPC_TIMERQUEUE_H
+
+#include <FreeNOS/System.h>
+#include <Types.h>
+#include <Timer.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libipc
+ * @{
+ */
+
+/** Maximum number of timer events read with one system call. */
+#define TIMERQUEUE_READ_MAX 8
+
+/**
+ * Manages multiple one-shot and periodic timers of the current Process.
+ *
+ * Timers are kept by the kernel. Expired timers wake up the Process
+ * and are read in batches of TimerEvents.
+ *
+ * @see ProcessCtl
+ */
+class TimerQueue
+{
+  public:
+
+    /**
+     * Result codes.
+     */
+    enum Result
+    {
+        Success,
+        InvalidArgument,
+        OutOfTimers,
+        NotFound,
+        IOError
+    };
+
+    /**
+     * Constructor.
+     */
+    TimerQueue();
+
+    /**
+     * Check if any timer was armed.
+     *
+     * @return True if at least one timer was armed, false otherwise.
+     */
+    bool isActive() const;
+
+    /**
+     * Arm a timer.
+     *
+     * Re-arms the timer if it is already armed.
+     *
+     * @param id Timer identifier.
+     * @param msec Milliseconds until expiration (approximately).
+     * @param periodic True to re-arm the timer after each expiration.
+     *
+     * @return Result code.
+     */
+    Result arm(u32 id, Size msec, bool periodic = false);
+
+    /**
+     * Disarm a timer.
+     *
+     * @param id Timer identifier.
+     *
+     * @return Result code.
+     */
+    Result disarm(u32 id);
+
+    /**
+     * Read expired timers.
+     *
+     * @param events TimerEvent array for output.
+     * @param max Maximum number of TimerEvents to read.
+     *
+     * @return Number of TimerEvents read.
+     */
+    Size read(TimerEvent *events, Size max);
+
+  private:
+
+    /**
+     * Convert milliseconds to timer ticks.
+     *
+     * @param msec Milliseconds.
+     *
+     * @return Timer ticks, at least one.
+     */
+    u32 toTicks(Size msec);
+
+  private:
+
+    /** Kernel timer information. */
+    Timer::Info m_info;
+
+    /** True if at least one timer was armed. */
+    bool m_active;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBIPC_TIMERQUEUE_H */
@@ -22,25 +22,23 @@ NetworkQueue::NetworkQueue(Size packetSize, Size headerSize, Size queueSize)
     m_packetSize   = packetSize;
     m_packetHeader = headerSize;
 
-    for (Size i = 0; i < queueSize; i++)
+    for (Size i = 0; i < queueSize && i < NETWORKQUEUE_MAX; i++)
     {
         Packet *packet = new Packet;
         packet->size = m_packetHeader;
         packet->data = new u8[packetSize];
-        m_free.insert(*packet);
+        m_free.push(packet);
     }
 }
 
 NetworkQueue::~NetworkQueue()
 {
-    for (Size i = 0; i < m_free.size(); i++)
+    Packet *p;
+
+    while (m_free.pop(&p) || m_data.pop(&p))
     {
-        Packet *p = (Packet *) m_free.get(i);
-        if (p)
-        {
-            delete p->data;
-            delete p;
-        }
+        delete[] p->data;
+        delete p;
     }
 }
 
@@ -51,40 +49,29 @@ void NetworkQueue::setHeaderSize(Size size)
 
 NetworkQueue::Packet * NetworkQueue::get()
 {
-    for (Size i = 0; i < m_free.size(); i++)
-    {
-        Packet *p = (Packet *) m_free.get(i);
-        if (p)
-        {
-            p->size = m_packetHeader;
-            m_free.remove(i);
-            return p;
-        }
-    }
-    return ZERO;
+    Packet *p;
+
+    if (!m_free.pop(&p))
+        return ZERO;
+
+    p->size = m_packetHeader;
+    return p;
 }
 
 void NetworkQueue::release(NetworkQueue::Packet *packet)
 {
     packet->size = m_packetHeader;
-    m_free.insert(*packet);
+    m_free.push(packet);
 }
 
 void NetworkQueue::push(NetworkQueue::Packet *packet)
 {
-    m_data.insert(*packet);
+    m_data.push(packet);
 }
 
 NetworkQueue::Packet * NetworkQueue::pop()
 {
-    for (Size i = 0; i < m_data.size(); i++)
-    {
-        Packet *p = (Packet *) m_data.get(i);
-        if (p)
-        {
-            m_data.remove(i);
-            return p;
-        }
-    }
-    return ZERO;
+    Packet *p;
+
+    return m_data.pop(&p) ? p : ZERO;
 }
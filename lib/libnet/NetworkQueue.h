@@ -19,7 +19,7 @@
 #define __LIBNET_NETWORKQUEUE_H
 
 #include <Types.h>
-#include <Index.h>
+#include <RingBuffer.h>
 
 /**
  * @addtogroup lib
@@ -29,8 +29,13 @@
  * @{
  */
 
+/** Maximum number of packets in a NetworkQueue. Must be a power of two. */
+#define NETWORKQUEUE_MAX 16
+
 /**
  * Networking packet queue implementation.
+ *
+ * Packets with data are returned in the order they were pushed.
  */
 class NetworkQueue
 {
@@ -62,7 +67,8 @@ class NetworkQueue
      *
      * @param packetSize The size of each packet in bytes
      * @param headerSize Size of the physical header, if any
-     * @param queueSize The size of the queue in number of packets
+     * @param queueSize The size of the queue in number of packets,
+     *                  at most NETWORKQUEUE_MAX
      */
     NetworkQueue(Size packetSize, Size headerSize = 0, Size queueSize = 8);
 
@@ -99,10 +105,10 @@ class NetworkQueue
   private:
 
     /** Contains unused packets */
-    Index<Packet> m_free;
+    RingBuffer<Packet *, NETWORKQUEUE_MAX> m_free;
 
     /** Contains packets with data */
-    Index<Packet> m_data;
+    RingBuffer<Packet *, NETWORKQUEUE_MAX> m_data;
 
     /** Size of each packet */
     Size m_packetSize;
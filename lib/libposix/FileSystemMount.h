@@ -48,6 +48,22 @@ typedef struct FileSystemMount
 }
 FileSystemMount;
 
+/**
+ * Mount table, published by sysfs in the MemoryMap::UserMounts page.
+ *
+ * Readers retry while the generation is odd or changed during the read.
+ * A generation of zero means the table was not published yet.
+ */
+typedef struct FileSystemMountTable
+{
+    /** Incremented before and after each update. Odd while sysfs updates the table. */
+    volatile u32 generation;
+
+    /** Mounted filesystems. */
+    FileSystemMount mounts[FILESYSTEM_MAXMOUNTS];
+}
+FileSystemMountTable;
+
 /**
  * @}
  * @}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBPOSIX_FUTEX_H
+#define __LIBPOSIX_FUTEX_H
+
+#include <FreeNOS/System.h>
+#include <Types.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libposix
+ * @{
+ */
+
+/**
+ * Sleep while a word holds the given value.
+ *
+ * The kernel compares the word and puts the caller to sleep atomically,
+ * such that a futexWake() after changing the word cannot be missed.
+ * Returns immediately if the word differs. Callers must re-check their
+ * condition after returning, because other wakeups also end the sleep.
+ *
+ * @param addr Address of the word.
+ * @param value Expected value.
+ */
+inline void futexWait(volatile u32 *addr, u32 value)
+{
+    ProcessCtl(SELF, WaitAddress, (Address) addr, value);
+}
+
+/**
+ * Wakeup sleepers on a word.
+ *
+ * Also wakes up sleepers in other processes which map the same memory.
+ *
+ * @param addr Address of the word.
+ * @param count Maximum number of sleepers to wakeup.
+ *
+ * @return Number of sleepers woken up.
+ */
+inline Size futexWake(volatile u32 *addr, Size count)
+{
+    return ProcessCtl(SELF, WakeAddress, (Address) addr, count);
+}
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBPOSIX_FUTEX_H */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <MemoryBlock.h>
+#include "MountTree.h"
+
+MountTree::MountTree()
+{
+    build(ZERO);
+}
+
+void MountTree::build(const FileSystemMount *mounts)
+{
+    MemoryBlock::set(&m_nodes[0], 0, sizeof(Node));
+    m_count = 1;
+
+    for (Size i = 0; mounts && i < FILESYSTEM_MAXMOUNTS; i++)
+    {
+        const char *path = mounts[i].path;
+        Size node = 0;
+
+        if (!path[0])
+            continue;
+
+        // Add the missing nodes along the path
+        for (Size j = 0; j < PATH_MAX && path[j]; j++)
+        {
+            Size next = child(node, path[j]);
+
+            if (!next)
+            {
+                next = m_count++;
+                m_nodes[next].character = path[j];
+                m_nodes[next].mounted   = false;
+                m_nodes[next].child     = 0;
+                m_nodes[next].sibling   = m_nodes[node].child;
+                m_nodes[next].procID    = 0;
+                m_nodes[node].child     = next;
+            }
+            node = next;
+        }
+        m_nodes[node].mounted = true;
+        m_nodes[node].procID  = mounts[i].procID;
+    }
+}
+
+Size MountTree::child(Size node, char character) const
+{
+    for (Size i = m_nodes[node].child; i; i = m_nodes[i].sibling)
+        if (m_nodes[i].character == character)
+            return i;
+
+    return 0;
+}
+
+bool MountTree::walk(Size *node, const char *str, ProcessID *match) const
+{
+    for (; *str; str++)
+    {
+        if (!(*node = child(*node, *str)))
+            return false;
+
+        if (m_nodes[*node].mounted)
+            *match = m_nodes[*node].procID;
+    }
+    return true;
+}
+
+ProcessID MountTree::lookup(const char *directory, const char *path) const
+{
+    ProcessID match = ZERO;
+    Size node = 0;
+
+    // Walk along the directory and path, as if joined by a slash
+    if (directory)
+    {
+        if (walk(&node, directory, &match) && walk(&node, "/", &match))
+            walk(&node, path, &match);
+    }
+    else
+        walk(&node, path, &match);
+
+    return match;
+}
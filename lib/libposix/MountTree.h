@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBPOSIX_MOUNTTREE_H
+#define __LIBPOSIX_MOUNTTREE_H
+
+#include <Types.h>
+#include "FileSystemMount.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libposix
+ * @{
+ */
+
+/** Maximum number of nodes, enough for a full table of maximum length paths. */
+#define MOUNTTREE_NODES (FILESYSTEM_MAXMOUNTS * PATH_MAX)
+
+/**
+ * Prefix tree of mounted filesystem paths.
+ *
+ * Each node represents one character of a mount path. Looking up the
+ * longest mount which prefixes a path takes one step per character of the
+ * path, regardless of the number of mounts. Nodes are kept in a fixed
+ * array and the tree is rebuilt only when the mount table changes.
+ */
+class MountTree
+{
+  public:
+
+    /**
+     * Constructor.
+     */
+    MountTree();
+
+    /**
+     * Rebuild the tree.
+     *
+     * @param mounts Mount table with FILESYSTEM_MAXMOUNTS entries.
+     */
+    void build(const FileSystemMount *mounts);
+
+    /**
+     * Find the longest mount which prefixes a path.
+     *
+     * @param directory If not ZERO, the path is relative to this directory.
+     * @param path Path to lookup.
+     *
+     * @return ProcessID of the mount or ZERO if none matches.
+     */
+    ProcessID lookup(const char *directory, const char *path) const;
+
+  private:
+
+    /**
+     * Tree node.
+     */
+    struct Node
+    {
+        /** Character of the mount path. */
+        char character;
+
+        /** True if a mount path ends at this node. */
+        bool mounted;
+
+        /** Index of the first child or zero if none. The root is never a child. */
+        u16 child;
+
+        /** Index of the next sibling or zero if none. */
+        u16 sibling;
+
+        /** Mount ending at this node. */
+        ProcessID procID;
+    };
+
+    /**
+     * Find the child of a node.
+     *
+     * @param node Node index.
+     * @param character Character of the child.
+     *
+     * @return Child index or zero if not found.
+     */
+    Size child(Size node, char character) const;
+
+    /**
+     * Walk the tree along a string.
+     *
+     * @param node Start node index, updated to the last visited node.
+     * @param str String to walk along.
+     * @param match Updated with the ProcessID of each mount on the way.
+     *
+     * @return True if the whole string was walked, false if the tree ended before.
+     */
+    bool walk(Size *node, const char *str, ProcessID *match) const;
+
+    /** Nodes. The first node is the root. */
+    Node m_nodes[MOUNTTREE_NODES];
+
+    /** Number of nodes in use. */
+    Size m_count;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBPOSIX_MOUNTTREE_H */
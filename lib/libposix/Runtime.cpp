@@ -26,7 +26,10 @@
 #include <FileSystemMessage.h>
 #include <MemoryMap.h>
 #include <Core.h>
+#include <Atomic.h>
+#include <DynamicLoader.h>
 #include "FileDescriptor.h"
+#include "MountTree.h"
 #include "stdlib.h"
 #include "string.h"
 #include "Runtime.h"
@@ -35,6 +38,12 @@
 #include "fcntl.h"
 #include "dirent.h"
 
+/** Dynamic section, only defined when linked as the shared library. */
+extern C ELFDynamic _DYNAMIC[] WEAK_HIDDEN;
+
+/** Shared library loader, if the program is dynamically linked. */
+static const DynamicLoader *library = ZERO;
+
 /** List of constructors. */
 extern void (*CTOR_LIST)();
 
@@ -44,6 +53,12 @@ extern void (*DTOR_LIST)();
 /** FileSystem mounts table */
 static FileSystemMount mounts[FILESYSTEM_MAXMOUNTS];
 
+/** Prefix tree of the mounts table */
+static MountTree mountTree;
+
+/** Generation of the published mounts table which was last copied */
+static u32 mountsGeneration = 0;
+
 /** Table with FileDescriptors. */
 static FileDescriptor *files = (FileDescriptor *) NULL;
 
@@ -82,6 +97,9 @@ extern C int raise(int sig)
 
 void runConstructors()
 {
+    if (library)
+        library->initialize();
+
     for (void (**ctor)() = &CTOR_LIST; ctor && *ctor; ctor++)
     {
         (*ctor)();
@@ -132,9 +150,19 @@ void setupRandomizer()
 void setupChannels()
 {
     ChannelClient *client = new ChannelClient();
-    (void) client;
+    Arch::MemoryMap map;
+    ProcessShares::MemoryShare *presets = (ProcessShares::MemoryShare *)
+        (map.range(MemoryMap::UserArgs).virt + CHANNEL_PRESETS_OFFSET);
+
+    client->setRegistry(new ChannelRegistry());
 
-    ChannelClient::instance->setRegistry(new ChannelRegistry());
+    // Attach to the channels which our parent created for us
+    if (getppid() != 0)
+    {
+        for (Size i = 0; i < CHANNEL_PRESETS; i++)
+            if (presets[i].range.virt)
+                client->attach(presets[i].pid, presets[i].range.virt);
+    }
 }
 
 void setupMappings()
@@ -147,6 +175,7 @@ void setupMappings()
     mounts[0].options = ZERO;
     mounts[1].procID  = ROOTFS_PID;
     mounts[1].options = ZERO;
+    mountTree.build(mounts);
 
     // Map user program arguments
     Arch::MemoryMap map;
@@ -170,45 +199,40 @@ void setupMappings()
 
 ProcessID findMount(const char *path)
 {
-    FileSystemMount *m = ZERO;
-    Size length = 0, len;
-    char tmp[PATH_MAX];
-
-    // Is the path relative?
-    if (path[0] != '/')
-    {
-        getcwd(tmp, sizeof(tmp));
-        snprintf(tmp, sizeof(tmp), "%s/%s", tmp, path);
-    }
-    else
-        strlcpy(tmp, path, PATH_MAX);
-
-    // Find the longest match
-    for (Size i = 0; i < FILESYSTEM_MAXMOUNTS; i++)
-    {
-        if (mounts[i].path[0])
-        {
-            len = strlen(mounts[i].path);
-
-            // Only choose this mount, if it matches,
-            // and is longer than the last match.
-            if (strncmp(tmp, mounts[i].path, len) == 0 && len > length)
-            {
-                length = len;
-                m = &mounts[i];
-            }
-        }
-    }
-
-    // All done
-    return m ? m->procID : ZERO;
+    // Relative paths are looked up without joining them with the current directory
+    return mountTree.lookup(path[0] != '/' ? **currentDirectory : ZERO, path);
 }
 
 void refreshMounts(const char *path)
 {
     FileSystemMessage msg;
+    Arch::MemoryMap map;
+    const FileSystemMountTable *table =
+        (const FileSystemMountTable *) map.range(MemoryMap::UserMounts).virt;
+    u32 generation = table->generation;
     pid_t pid = getpid();
 
+    // Only copy the published table if it changed since the last copy
+    if (generation != 0)
+    {
+        if (generation == mountsGeneration)
+            return;
+
+        do
+        {
+            while ((generation = table->generation) & 1)
+                ;
+            Atomic<u32>::fence();
+            MemoryBlock::copy(mounts, (const void *) table->mounts, sizeof(mounts));
+            Atomic<u32>::fence();
+        }
+        while (table->generation != generation);
+
+        mountsGeneration = generation;
+        mountTree.build(mounts);
+        return;
+    }
+
     // Skip for rootfs and sysfs
     if (pid == ROOTFS_PID || pid == SYSFS_PID)
         return;
@@ -216,7 +240,7 @@ void refreshMounts(const char *path)
     // Clear mounts table
     MemoryBlock::set(&mounts[2], 0, sizeof(FileSystemMount) * (FILESYSTEM_MAXMOUNTS-2));
 
-    // Re-read the mounts table from SysFS.
+    // Not published on this core, re-read the mounts table from SysFS.
     msg.type   = ChannelMessage::Request;
     msg.action = ReadFile;
     msg.path   = "/sys/mounts";
@@ -225,6 +249,7 @@ void refreshMounts(const char *path)
     msg.offset = 0;
     msg.from   = SELF;
     ChannelClient::instance->syncSendReceive(&msg, SYSFS_PID);
+    mountTree.build(mounts);
 }
 
 ProcessID findMount(int fildes)
@@ -273,8 +298,9 @@ extern C void SECTION(".entry") _entry()
     SystemInformation info;
     Arch::MemoryMap map;
 
-    // Clear BSS
-    clearBSS();
+    // Clear BSS. Dynamically linked programs are mapped zeroed by the parent.
+    if (!library)
+        clearBSS();
 
     // Setup the heap, C++ constructors and default mounts
     setupHeap();
@@ -303,3 +329,27 @@ extern C void SECTION(".entry") _entry()
     runDestructors();
     exit(ret);
 }
+
+extern C void _dynamic_entry()
+{
+    Arch::MemoryMap map;
+    const DynamicInfo *info = (const DynamicInfo *)
+        (map.range(MemoryMap::UserArgs).virt + DYNAMIC_INFO_OFFSET);
+    DynamicLoader shared(info->library, _DYNAMIC);
+    DynamicLoader program(0, (const ELFDynamic *) info->program);
+    const DynamicLoader *scope[] = { &program, &shared };
+
+    // Relocate the shared library before using any of its global data,
+    // then the program. Symbols in the program take precedence.
+    if (shared.parse()  != DynamicLoader::Success ||
+        program.parse() != DynamicLoader::Success ||
+        shared.relocate(scope, 2)  != DynamicLoader::Success ||
+        program.relocate(scope, 2) != DynamicLoader::Success)
+    {
+        ProcessCtl(SELF, KillPID, EXIT_FAILURE);
+    }
+    library = &shared;
+
+    // Continue as a statically linked program
+    _entry();
+}
@@ -40,6 +40,42 @@
 /** Number of arguments at maximum. */
 #define ARGV_COUNT (PAGESIZE / ARGV_SIZE)
 
+/** Number of channels a parent may pre-establish for a child. */
+#define CHANNEL_PRESETS 4
+
+/**
+ * Offset of the pre-established channels inside the UserArgs region.
+ *
+ * The table follows the current working directory and contains
+ * CHANNEL_PRESETS ProcessShares::MemoryShare entries. Entries with
+ * a zero virtual address are unused.
+ */
+#define CHANNEL_PRESETS_OFFSET (PAGESIZE + PATH_MAX)
+
+/**
+ * Offset of the DynamicInfo inside the UserArgs region.
+ *
+ * Follows the table of pre-established channels.
+ */
+#define DYNAMIC_INFO_OFFSET \
+    (CHANNEL_PRESETS_OFFSET + (CHANNEL_PRESETS * sizeof(ProcessShares::MemoryShare)))
+
+/**
+ * Filled in by the parent of a dynamically linked program.
+ *
+ * The program starts at the entry point of the shared library,
+ * which relocates itself and the program before calling _entry().
+ */
+typedef struct DynamicInfo
+{
+    /** Virtual address of the dynamic section of the program. */
+    Address program;
+
+    /** Load bias of the shared library. */
+    Address library;
+}
+DynamicInfo;
+
 /**
  * Program entry point.
  *
@@ -58,6 +58,12 @@
 /** Maximum length of a directory entry name. */
 #define DIRLEN          64
 
+/** Number of directory entries read from the filesystem at once. */
+#define DIRBATCH        32
+
+/** Directory entry as read from the filesystem. */
+struct Dirent;
+
 /**
  * Represents a directory entry.
  */
@@ -96,15 +102,21 @@ typedef struct DIR
     /** File descriptor returned by opendir(). */
     int fd;
 
-    /** Input buffer. */
-    struct dirent *buffer;
+    /** Input buffer with DIRBATCH entries. */
+    struct Dirent *buffer;
 
-    /** Index of the current dirent. */
+    /** Entry returned by readdir(). */
+    struct dirent entry;
+
+    /** Index of the current entry in the buffer. */
     Size current;
 
-    /** Number of direct structures in the buffer. */
+    /** Number of entries in the buffer. */
     Size count;
 
+    /** Resume cookie for the next batch of entries. */
+    Size cookie;
+
     /** End-of-file reached? */
     bool eof;
 }
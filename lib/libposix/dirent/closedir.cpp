@@ -15,6 +15,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <Directory.h>
 #include "dirent.h"
 #include "fcntl.h"
 #include "unistd.h"
@@ -25,7 +26,7 @@ int closedir(DIR *dirp)
     close(dirp->fd);
 
     // Free buffers
-    delete dirp->buffer;
+    delete[] dirp->buffer;
     delete dirp;
 
     // Success
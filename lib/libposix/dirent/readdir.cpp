@@ -15,17 +15,80 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <Macros.h>
+#include <FreeNOS/System.h>
+#include <FileSystemMessage.h>
+#include <Directory.h>
+#include <errno.h>
+#include "Runtime.h"
 #include "dirent.h"
 
+/**
+ * Read the next batch of entries into the DIR buffer.
+ *
+ * @param dirp Directory stream.
+ *
+ * @return Number of entries read, or Error on failure.
+ */
+static Error readBatch(DIR *dirp)
+{
+    FileSystemMessage msg;
+    FileDescriptor *files = getFiles();
+
+    msg.type   = ChannelMessage::Request;
+    msg.action = ReadDirectory;
+    msg.path   = files[dirp->fd].path;
+    msg.buffer = (char *) dirp->buffer;
+    msg.size   = sizeof(Dirent) * DIRBATCH;
+    msg.offset = dirp->cookie;
+    msg.from   = SELF;
+    msg.deviceID.minor = files[dirp->fd].identifier;
+    ChannelClient::instance->syncSendReceive(&msg, files[dirp->fd].mount);
+
+    if (msg.result < 0)
+        return msg.result;
+
+    dirp->cookie = msg.offset;
+    return msg.result / sizeof(Dirent);
+}
+
 struct dirent * readdir(DIR *dirp)
 {
-    if (dirp->current < dirp->count)
+    static const u8 types[] =
     {
-        return &dirp->buffer[dirp->current++];
-    }
-    else
+        DT_REG,
+        DT_DIR,
+        DT_BLK,
+        DT_CHR,
+        DT_LNK,
+        DT_FIFO,
+        DT_SOCK,
+    };
+    Dirent *d;
+    Error e;
+
+    // Read the next batch if the buffer is consumed
+    if (dirp->current >= dirp->count)
     {
-        return (struct dirent *) ZERO;
+        if (dirp->eof)
+            return (struct dirent *) ZERO;
+
+        if ((e = readBatch(dirp)) < 0)
+        {
+            errno = e;
+            return (struct dirent *) ZERO;
+        }
+        dirp->current = 0;
+        dirp->count   = e;
+
+        if (dirp->count == 0)
+        {
+            dirp->eof = true;
+            return (struct dirent *) ZERO;
+        }
     }
+    // Fill in the dirent struct
+    d = &dirp->buffer[dirp->current++];
+    strlcpy(dirp->entry.d_name, d->name, DIRLEN);
+    dirp->entry.d_type = types[d->type];
+    return &dirp->entry;
 }
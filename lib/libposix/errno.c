@@ -18,8 +18,6 @@
 #include <Macros.h>
 #include "errno.h"
 
-int errno USED = 0;
-
 char * error_map[] USED =
 {
     [-ESUCCESS]         = "Success",
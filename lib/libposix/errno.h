@@ -295,10 +295,19 @@
  * @}
  */
 
+/**
+ * Get the errno value of the calling thread.
+ *
+ * @return Pointer to the errno value in the thread administration.
+ */
+extern C int * __errno_location();
+
 /**
  * The lvalue errno is used by many functions to return error values.
+ *
+ * Each thread has its own errno value.
  */
-extern C int errno;
+#define errno (*__errno_location())
 
 /**
  * Contains a array of character strings, representing errno values.
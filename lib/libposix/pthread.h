@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBPOSIX_PTHREAD_H
+#define __LIBPOSIX_PTHREAD_H
+
+#include <Macros.h>
+#include "sys/types.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libposix
+ * @{
+ */
+
+/** Size of the user stack of each thread, mapped by the kernel in the UserStack region. */
+#define PTHREAD_STACK_SIZE 16384
+
+/** Static initializer for a pthread_mutex_t. */
+#define PTHREAD_MUTEX_INITIALIZER { 0 }
+
+/** Static initializer for a pthread_cond_t. */
+#define PTHREAD_COND_INITIALIZER { 0 }
+
+/** Used to identify a thread. */
+typedef struct PThread * pthread_t;
+
+/** Used to identify a thread attribute object (unsupported). */
+typedef int pthread_attr_t;
+
+/** Used to identify a mutex attribute object (unsupported). */
+typedef int pthread_mutexattr_t;
+
+/** Used to identify a condition attribute object (unsupported). */
+typedef int pthread_condattr_t;
+
+/**
+ * Used for mutexes.
+ */
+typedef struct pthread_mutex_t
+{
+    /** Zero if unlocked, one if locked and two if locked with waiters. */
+    volatile u32 state;
+}
+pthread_mutex_t;
+
+/**
+ * Used for condition variables.
+ */
+typedef struct pthread_cond_t
+{
+    /** Incremented on every signal or broadcast. */
+    volatile u32 sequence;
+}
+pthread_cond_t;
+
+/**
+ * @brief Thread creation
+ *
+ * The pthread_create() function shall create a new thread, with attributes
+ * specified by attr, within a process. The thread shares the address space
+ * of the calling thread and runs on its own user stack of PTHREAD_STACK_SIZE bytes.
+ *
+ * @param thread Output thread identifier.
+ * @param attr Thread attributes. Ignored.
+ * @param start_routine Function executed by the thread.
+ * @param arg Argument for start_routine.
+ *
+ * @return Zero on success or an error number on failure.
+ */
+extern C int pthread_create(pthread_t *thread, const pthread_attr_t *attr,
+                            void *(*start_routine)(void *), void *arg);
+
+/**
+ * @brief Wait for thread termination
+ *
+ * The pthread_join() function shall suspend execution of the calling
+ * thread until the target thread terminates and release its resources.
+ *
+ * @param thread Thread to wait for.
+ * @param value_ptr If not NULL, receives the value passed to pthread_exit().
+ *
+ * @return Zero on success or an error number on failure.
+ */
+extern C int pthread_join(pthread_t thread, void **value_ptr);
+
+/**
+ * @brief Thread termination
+ *
+ * The pthread_exit() function shall terminate the calling thread. Calling
+ * pthread_exit() from the initial thread terminates the whole process.
+ *
+ * @param value_ptr Value made available to pthread_join().
+ */
+extern C void pthread_exit(void *value_ptr);
+
+/**
+ * @brief Get the calling thread ID
+ *
+ * @return Thread identifier of the calling thread.
+ */
+extern C pthread_t pthread_self();
+
+/**
+ * @brief Compare thread IDs
+ *
+ * @return Non-zero if both threads are equal, zero otherwise.
+ */
+extern C int pthread_equal(pthread_t t1, pthread_t t2);
+
+/**
+ * @brief Initialize a mutex
+ *
+ * @param mutex Mutex to initialize.
+ * @param attr Mutex attributes. Ignored.
+ *
+ * @return Zero on success.
+ */
+extern C int pthread_mutex_init(pthread_mutex_t *mutex, const pthread_mutexattr_t *attr);
+
+/**
+ * @brief Destroy a mutex
+ *
+ * @param mutex Mutex to destroy.
+ *
+ * @return Zero on success or EBUSY if the mutex is locked.
+ */
+extern C int pthread_mutex_destroy(pthread_mutex_t *mutex);
+
+/**
+ * @brief Lock a mutex
+ *
+ * Uncontended locking does not enter the kernel. Contended lockers
+ * sleep in the kernel on the address of the mutex.
+ *
+ * @param mutex Mutex to lock.
+ *
+ * @return Zero on success.
+ */
+extern C int pthread_mutex_lock(pthread_mutex_t *mutex);
+
+/**
+ * @brief Try to lock a mutex
+ *
+ * @param mutex Mutex to lock.
+ *
+ * @return Zero on success or EBUSY if the mutex is locked.
+ */
+extern C int pthread_mutex_trylock(pthread_mutex_t *mutex);
+
+/**
+ * @brief Unlock a mutex
+ *
+ * Only enters the kernel if another thread waits for the mutex.
+ *
+ * @param mutex Mutex to unlock.
+ *
+ * @return Zero on success.
+ */
+extern C int pthread_mutex_unlock(pthread_mutex_t *mutex);
+
+/**
+ * @brief Initialize a condition variable
+ *
+ * @param cond Condition variable to initialize.
+ * @param attr Condition attributes. Ignored.
+ *
+ * @return Zero on success.
+ */
+extern C int pthread_cond_init(pthread_cond_t *cond, const pthread_condattr_t *attr);
+
+/**
+ * @brief Destroy a condition variable
+ *
+ * @param cond Condition variable to destroy.
+ *
+ * @return Zero on success.
+ */
+extern C int pthread_cond_destroy(pthread_cond_t *cond);
+
+/**
+ * @brief Wait on a condition
+ *
+ * Atomically releases the mutex and waits for the condition to be signaled.
+ * The mutex is locked again before returning. Spurious wakeups may occur.
+ *
+ * @param cond Condition variable to wait on.
+ * @param mutex Mutex locked by the calling thread.
+ *
+ * @return Zero on success.
+ */
+extern C int pthread_cond_wait(pthread_cond_t *cond, pthread_mutex_t *mutex);
+
+/**
+ * @brief Signal a condition
+ *
+ * Unblocks at least one of the threads waiting on the condition.
+ *
+ * @param cond Condition variable to signal.
+ *
+ * @return Zero on success.
+ */
+extern C int pthread_cond_signal(pthread_cond_t *cond);
+
+/**
+ * @brief Broadcast a condition
+ *
+ * Unblocks all threads waiting on the condition.
+ *
+ * @param cond Condition variable to broadcast.
+ *
+ * @return Zero on success.
+ */
+extern C int pthread_cond_broadcast(pthread_cond_t *cond);
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBPOSIX_PTHREAD_H */
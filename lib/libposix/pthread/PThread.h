@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBPOSIX_PTHREAD_PTHREAD_H
+#define __LIBPOSIX_PTHREAD_PTHREAD_H
+
+#include <FreeNOS/System.h>
+#include <Types.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libposix
+ * @{
+ */
+
+/**
+ * Thread administration, pointed to by pthread_t.
+ */
+struct PThread
+{
+    /** Kernel ProcessID of the thread. */
+    ProcessID id;
+
+    /** Function executed by the thread. */
+    void * (*start)(void *);
+
+    /** Argument for the start function. */
+    void *argument;
+
+    /** Value passed to pthread_exit(). */
+    void *result;
+
+    /** True for the initial thread, which cannot be joined. */
+    bool initial;
+
+    /** Value of errno for this thread. */
+    int error;
+};
+
+/**
+ * True once the process created a thread with pthread_create().
+ *
+ * Until then, the initial thread is the only thread and its
+ * administration is found without a system call.
+ */
+extern bool pthread_threaded;
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBPOSIX_PTHREAD_PTHREAD_H */
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ThreadAllocator.h"
+
+ThreadAllocator::ThreadAllocator(Allocator *parent)
+{
+    setParent(parent);
+    pthread_mutex_init(&m_mutex, ZERO);
+}
+
+Size ThreadAllocator::size() const
+{
+    return m_parent->size();
+}
+
+Size ThreadAllocator::available() const
+{
+    return m_parent->available();
+}
+
+Allocator::Result ThreadAllocator::allocate(Size *size, Address *addr, Size align)
+{
+    Result result;
+
+    pthread_mutex_lock(&m_mutex);
+    result = m_parent->allocate(size, addr, align);
+    pthread_mutex_unlock(&m_mutex);
+    return result;
+}
+
+Allocator::Result ThreadAllocator::release(Address addr)
+{
+    Result result;
+
+    pthread_mutex_lock(&m_mutex);
+    result = m_parent->release(addr);
+    pthread_mutex_unlock(&m_mutex);
+    return result;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBPOSIX_PTHREAD_THREADALLOCATOR_H
+#define __LIBPOSIX_PTHREAD_THREADALLOCATOR_H
+
+#include <Allocator.h>
+#include "pthread.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libposix
+ * @{
+ */
+
+/**
+ * Serializes access to the default Allocator between threads.
+ *
+ * Installed as the default Allocator when the first thread is created,
+ * such that single-threaded programs do not pay for the locking.
+ */
+class ThreadAllocator : public Allocator
+{
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param parent Allocator to serialize.
+     */
+    ThreadAllocator(Allocator *parent);
+
+    /**
+     * Get memory size.
+     *
+     * @return Size of memory owned by the parent Allocator.
+     */
+    virtual Size size() const;
+
+    /**
+     * Get memory available.
+     *
+     * @return Size of memory available in the parent Allocator.
+     */
+    virtual Size available() const;
+
+    /**
+     * Allocate memory.
+     *
+     * @param size Amount of memory in bytes to allocate on input.
+     *             On output, the amount of memory in bytes actually allocated.
+     * @param addr Output parameter which contains the address
+     *             allocated on success.
+     * @param align Alignment of the required memory or use ZERO for default.
+     *
+     * @return Result value.
+     */
+    virtual Result allocate(Size *size, Address *addr, Size align = ZERO);
+
+    /**
+     * Release memory.
+     *
+     * @param addr Points to memory previously returned by allocate().
+     *
+     * @return Result value.
+     */
+    virtual Result release(Address addr);
+
+  private:
+
+    /** Held while calling the parent Allocator. */
+    pthread_mutex_t m_mutex;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBPOSIX_PTHREAD_THREADALLOCATOR_H */
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <FreeNOS/System.h>
+#include <errno.h>
+#include "pthread.h"
+#include "PThread.h"
+#include "ThreadAllocator.h"
+
+/**
+ * Entry point of new threads.
+ */
+static void threadStart()
+{
+    pthread_t self = pthread_self();
+
+    pthread_exit(self->start(self->argument));
+}
+
+int pthread_create(pthread_t *thread, const pthread_attr_t *attr,
+                   void *(*start_routine)(void *), void *arg)
+{
+    ThreadSpec spec;
+    API::Result result;
+
+    // From now on, the heap is shared between threads
+    if (!pthread_threaded)
+    {
+        Allocator::setDefault(new ThreadAllocator(Allocator::getDefault()));
+        pthread_threaded = true;
+    }
+
+    PThread *t = new PThread;
+    t->id       = 0;
+    t->start    = start_routine;
+    t->argument = arg;
+    t->result   = ZERO;
+    t->initial  = false;
+    t->error    = 0;
+
+    // The kernel maps the user stack of the thread in the UserStack region
+    spec.entry = (Address) threadStart;
+    spec.stack = 0;
+    spec.data  = (Address) t;
+
+    if ((result = ProcessCtl(SELF, SpawnThread, (Address) &spec)) < 0)
+    {
+        delete t;
+        return EAGAIN;
+    }
+    t->id = result;
+    *thread = t;
+    return 0;
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <FreeNOS/System.h>
+#include <errno.h>
+#include "pthread.h"
+#include "PThread.h"
+
+int pthread_join(pthread_t thread, void **value_ptr)
+{
+    if (thread->initial || thread == pthread_self())
+        return EDEADLK;
+
+    // Returns immediately if the thread already terminated
+    ProcessCtl(thread->id, WaitPID);
+
+    if (value_ptr)
+        *value_ptr = thread->result;
+
+    delete thread;
+    return 0;
+}
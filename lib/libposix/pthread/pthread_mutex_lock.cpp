@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "pthread.h"
+#include "Futex.h"
+
+int pthread_mutex_lock(pthread_mutex_t *mutex)
+{
+    u32 state = __sync_val_compare_and_swap(&mutex->state, 0, 1);
+
+    // Mark the mutex contended and sleep until it is unlocked
+    if (state != 0)
+    {
+        if (state != 2)
+            state = __sync_lock_test_and_set(&mutex->state, 2);
+
+        while (state != 0)
+        {
+            futexWait(&mutex->state, 2);
+            state = __sync_lock_test_and_set(&mutex->state, 2);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBPOSIX_SEMAPHORE_H
+#define __LIBPOSIX_SEMAPHORE_H
+
+#include <Macros.h>
+#include "sys/types.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libposix
+ * @{
+ */
+
+/**
+ * Used for semaphores.
+ *
+ * A semaphore in memory shared between processes also works across
+ * processes, because waiters sleep on the physical address of the value.
+ */
+typedef struct sem_t
+{
+    /** Current value. */
+    volatile u32 value;
+
+    /** Number of threads sleeping in sem_wait(). */
+    volatile u32 waiters;
+}
+sem_t;
+
+/**
+ * @brief Initialize an unnamed semaphore
+ *
+ * @param sem Semaphore to initialize.
+ * @param pshared Non-zero if shared between processes. Ignored.
+ * @param value Initial value.
+ *
+ * @return Zero on success or -1 on error.
+ */
+extern C int sem_init(sem_t *sem, int pshared, unsigned value);
+
+/**
+ * @brief Destroy an unnamed semaphore
+ *
+ * @param sem Semaphore to destroy.
+ *
+ * @return Zero on success or -1 if threads are waiting on the semaphore.
+ */
+extern C int sem_destroy(sem_t *sem);
+
+/**
+ * @brief Lock a semaphore
+ *
+ * Decrements the semaphore, sleeping while its value is zero.
+ *
+ * @param sem Semaphore to lock.
+ *
+ * @return Zero on success.
+ */
+extern C int sem_wait(sem_t *sem);
+
+/**
+ * @brief Try to lock a semaphore
+ *
+ * @param sem Semaphore to lock.
+ *
+ * @return Zero on success or -1 with errno set to EAGAIN if the value is zero.
+ */
+extern C int sem_trywait(sem_t *sem);
+
+/**
+ * @brief Unlock a semaphore
+ *
+ * Increments the semaphore. Only enters the kernel if a thread is waiting.
+ *
+ * @param sem Semaphore to unlock.
+ *
+ * @return Zero on success.
+ */
+extern C int sem_post(sem_t *sem);
+
+/**
+ * @brief Get the value of a semaphore
+ *
+ * @param sem Semaphore to read.
+ * @param sval Output value.
+ *
+ * @return Zero on success.
+ */
+extern C int sem_getvalue(sem_t *sem, int *sval);
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBPOSIX_SEMAPHORE_H */
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "semaphore.h"
+#include "Futex.h"
+
+int sem_wait(sem_t *sem)
+{
+    while (true)
+    {
+        u32 value = sem->value;
+
+        if (value > 0)
+        {
+            if (__sync_bool_compare_and_swap(&sem->value, value, value - 1))
+                return 0;
+        }
+        else
+        {
+            // Sleeps only while the value is still zero
+            __sync_add_and_fetch(&sem->waiters, 1);
+            futexWait(&sem->value, 0);
+            __sync_sub_and_fetch(&sem->waiters, 1);
+        }
+    }
+}
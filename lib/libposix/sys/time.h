@@ -15,8 +15,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef __LIBPOSIX_TIME_H
-#define __LIBPOSIX_TIME_H
+#ifndef __LIBPOSIX_SYS_TIME_H
+#define __LIBPOSIX_SYS_TIME_H
 
 #include <Macros.h>
 #include "types.h"
@@ -78,4 +78,4 @@ extern C int printtimediff(struct timeval *t1, struct timeval *t2);
  * @}
  */
 
-#endif /* __LIBPOSIX_TIME_H */
+#endif /* __LIBPOSIX_SYS_TIME_H */
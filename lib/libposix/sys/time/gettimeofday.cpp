@@ -15,26 +15,19 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <FreeNOS/System.h>
 #include <sys/time.h>
-#include <errno.h>
+#include <time.h>
 
 int gettimeofday(struct timeval *tv, struct timezone *tz)
 {
-    Timer::Info timer;
+    struct timespec ts;
 
-    // Get current system timer info
-    ProcessCtl(SELF, InfoTimer, (Address) &timer);
-
-    // Check for a valid frequency
-    if (timer.frequency == 0)
-    {
-        errno = ERANGE;
+    // Read the real time from the kernel clock page
+    if (clock_gettime(CLOCK_REALTIME, &ts) != 0)
         return -1;
-    }
 
     // Fill the output variables
-    tv->tv_sec  = timer.ticks / timer.frequency;
-    tv->tv_usec = (1000000 / timer.frequency) * (timer.ticks % timer.frequency);
+    tv->tv_sec  = ts.tv_sec;
+    tv->tv_usec = ts.tv_nsec / 1000;
     return 0;
 }
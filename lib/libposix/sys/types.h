@@ -67,6 +67,9 @@ typedef sint blksize_t;
 /** Used for time in seconds. */
 typedef u64 time_t;
 
+/** Used for clock ID type in the clock and timer functions. */
+typedef uint clockid_t;
+
 /**
  * @}
  * @}
@@ -41,6 +41,21 @@ struct timespec
     long tv_nsec;
 };
 
+/**
+ * @name Clock identifiers
+ * @{
+ */
+
+/** The identifier of the system-wide clock measuring real time. */
+#define CLOCK_REALTIME  0
+
+/** The identifier for the system-wide monotonic clock. */
+#define CLOCK_MONOTONIC 1
+
+/**
+ * @}
+ */
+
 /**
  * Convert given time values to UNIX timestamp (seconds since epoch)
  *
@@ -58,6 +73,20 @@ struct timespec
 extern C unsigned long mktime(const unsigned int year, const unsigned int month,
                               const unsigned int day, const unsigned int hour,
                               const unsigned int min, const unsigned int sec);
+
+/**
+ * Get the current time of a clock.
+ *
+ * The time is read from the kernel clock page without
+ * entering the kernel.
+ *
+ * @param clockId Identifier of the clock to read.
+ * @param tp Timespec struct object pointer for output.
+ *
+ * @return Zero on success and -1 on error.
+ */
+extern C int clock_gettime(clockid_t clockId, struct timespec *tp);
+
 /**
  * @}
  * @}
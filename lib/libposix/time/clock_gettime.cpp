@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <FreeNOS/SystemClock.h>
+#include <errno.h>
+#include <time.h>
+
+int clock_gettime(clockid_t clockId, struct timespec *tp)
+{
+    static const SystemClock *clock = ZERO;
+    u32 sequence, tickNanoseconds, multiplier, bootTime;
+    u64 nanoseconds, counter, elapsed;
+
+    // The kernel maps the clock page at a fixed address
+    if (!clock)
+    {
+        Arch::MemoryMap map;
+        clock = (const SystemClock *) map.range(MemoryMap::UserClock).virt;
+    }
+
+    // Take a consistent snapshot of the clock page
+    do
+    {
+        while ((sequence = clock->sequence) & 1)
+            ;
+        asm volatile ("" ::: "memory");
+
+        nanoseconds     = clock->nanoseconds;
+        counter         = clock->counter;
+        tickNanoseconds = clock->tickNanoseconds;
+        multiplier      = clock->counterMultiplier;
+        bootTime        = clock->bootTime;
+
+        asm volatile ("" ::: "memory");
+    }
+    while (sequence != clock->sequence);
+
+    // Check for a valid clock
+    if (!tickNanoseconds)
+    {
+        errno = ERANGE;
+        return -1;
+    }
+
+    // Interpolate within the current timer tick using the counter
+    if (multiplier)
+    {
+        elapsed = ((timestamp() - counter) * multiplier) >> SYSTEMCLOCK_SHIFT;
+        nanoseconds += elapsed < tickNanoseconds ? elapsed : tickNanoseconds;
+    }
+
+    switch (clockId)
+    {
+        case CLOCK_MONOTONIC:
+            break;
+
+        case CLOCK_REALTIME:
+            nanoseconds += (u64) bootTime * 1000000000;
+            break;
+
+        default:
+            errno = EINVAL;
+            return -1;
+    }
+
+    // Fill the output variables
+    tp->tv_sec  = nanoseconds / 1000000000;
+    tp->tv_nsec = nanoseconds % 1000000000;
+    return 0;
+}
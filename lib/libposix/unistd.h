@@ -139,6 +139,20 @@ extern C off_t lseek(int fildes, off_t offset, int whence);
  */
 extern C int forkexec(const char *path, const char *argv[]);
 
+/**
+ * @brief Create a new system process and execute program.
+ *
+ * Like forkexec(), but the new process may change system wide
+ * settings, such as the time. Only system processes can do this.
+ *
+ * @param path File to execute.
+ * @param argv Argument list pointer.
+ *
+ * @return New process ID on success and -1 on failure.
+ * @note  Errno is set with the appropriate error code on failure.
+ */
+extern C int forkexec_system(const char *path, const char *argv[]);
+
 /**
  * @brief Create a new process using in-memory image.
  *
@@ -16,7 +16,6 @@
  */
 
 #include <String.h>
-#include <List.h>
 #include <FileSystemPath.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -24,10 +23,9 @@
 
 int chdir(const char *filepath)
 {
-    String *last = ZERO;
-    List<String *> lst;
-    char cwd[PATH_MAX], buf[PATH_MAX], *path = ZERO;
+    char cwd[PATH_MAX], full[PATH_MAX], buf[PATH_MAX], *path = ZERO;
     FileSystemPath fspath;
+    Size keep[PATH_COMPONENTS_MAX], count = 0, len = 0;
     struct stat st;
 
     // What's the current working dir?
@@ -36,29 +34,32 @@ int chdir(const char *filepath)
     // Relative or absolute?
     if (filepath[0] != '/')
     {
-        snprintf(buf, sizeof(buf), "%s/%s", cwd, filepath);
-        fspath.parse(buf);
-        memset(buf, 0, sizeof(buf));
+        snprintf(full, sizeof(full), "%s/%s", cwd, filepath);
+        fspath.parse(full);
 
-        // Process '..'
-        for (ListIterator<String *> i(fspath.split()); i.hasCurrent(); i++)
+        // Process '.' and '..'
+        for (Size i = 0; i < fspath.count(); i++)
         {
-            if ((**i.current())[0] != '.')
-            {
-                lst.append(i.current());
-                last = i.current();
-            }
-            else if ((**i.current())[1] == '.' && last)
+            const char *name = fspath.component(i);
+            Size nameLength = fspath.componentLength(i);
+
+            if (nameLength == 1 && name[0] == '.')
+                continue;
+            else if (nameLength == 2 && name[0] == '.' && name[1] == '.')
             {
-                lst.remove(last);
+                if (count)
+                    count--;
             }
+            else
+                keep[count++] = i;
         }
 
         // Construct final path
-        for (ListIterator<String *> i(&lst); i.hasCurrent(); i++)
+        buf[0] = ZERO;
+        for (Size i = 0; i < count && len < sizeof(buf) - 1; i++)
         {
-            strcat(buf, "/");
-            strcat(buf, **i.current());
+            buf[len++] = '/';
+            len += fspath.copy(keep[i], buf + len, sizeof(buf) - len);
         }
         path = buf;
     }
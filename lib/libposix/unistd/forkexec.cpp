@@ -17,121 +17,367 @@
 
 #include <FreeNOS/System.h>
 #include <ExecutableFormat.h>
+#include <BootImage.h>
+#include <MemoryMap.h>
+#include <SystemCallBatch.h>
 #include <Types.h>
 #include <Runtime.h>
 #include <string.h>
-#include <sys/stat.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <FileSystemMessage.h>
 #include "unistd.h"
 
-int forkexec(const char *path, const char *argv[])
+/**
+ * Pre-establish channels between a new child and the core servers.
+ *
+ * The child is connected to the root and system filesystems and
+ * the filesystems of its inherited file descriptors, such that it does
+ * not have to connect on its first I/O. The ProcessShares::MemoryShare
+ * outputs are stored in the given table which is copied to the child.
+ * A failed share leaves its entry unused and the child connects itself.
+ *
+ * @param batch SystemCallBatch to add the VMShare() calls to.
+ * @param pid ProcessID of the child.
+ * @param presets Table with CHANNEL_PRESETS entries.
+ */
+static void presetChannels(SystemCallBatch *batch, ProcessID pid,
+                           ProcessShares::MemoryShare *presets)
+{
+    FileDescriptor *files = getFiles();
+    SystemInformation info;
+    ProcessID servers[CHANNEL_PRESETS];
+    Size count = 0;
+
+    servers[count++] = ROOTFS_PID;
+    servers[count++] = SYSFS_PID;
+
+    // Add the filesystems of the standard file descriptors
+    for (Size i = 0; i < 3 && count < CHANNEL_PRESETS; i++)
+    {
+        bool found = false;
+
+        if (!files[i].open)
+            continue;
+
+        for (Size j = 0; j < count; j++)
+            if (servers[j] == files[i].mount)
+                found = true;
+
+        if (!found)
+            servers[count++] = files[i].mount;
+    }
+
+    for (Size i = 0; i < count; i++)
+    {
+        presets[i].pid    = servers[i];
+        presets[i].coreId = info.coreId;
+        presets[i].tagId  = 0;
+        presets[i].range.size = CHANNEL_SHARE_SIZE;
+        presets[i].range.virt = 0;
+        presets[i].range.phys = 0;
+        presets[i].range.access = Memory::User | Memory::Readable | Memory::Writable;
+        batch->vmShare(pid, API::Connect, &presets[i]);
+    }
+}
+
+/** Maximum number of segments in the shared library. */
+#define LIBRARY_SEGMENTS 4
+
+/**
+ * Shared library of dynamically linked programs.
+ *
+ * The library is stored in the boot image and its read-only
+ * segments are mapped straight from there into every child.
+ */
+typedef struct SharedLibrary
+{
+    /** Entry point relative to the load bias. */
+    Address entry;
+
+    /** Number of segments. */
+    Size count;
+
+    /** Segments from the ELF program headers of the library. */
+    ExecutableFormat::Region regions[LIBRARY_SEGMENTS];
+
+    /** Physical address of each segment in the boot image. */
+    Address phys[LIBRARY_SEGMENTS];
+
+    /** Virtual address of each segment in our own address space. */
+    Address local[LIBRARY_SEGMENTS];
+}
+SharedLibrary;
+
+/**
+ * Find the shared library in the boot image.
+ *
+ * The library segments are mapped into our own address space
+ * once, which is needed to copy the writable segments to children.
+ *
+ * @return Pointer to the SharedLibrary or ZERO if not found.
+ */
+static const SharedLibrary * findLibrary()
+{
+    static SharedLibrary library;
+    static bool found = false;
+    SystemInformation info;
+    ExecutableFormat *fmt;
+    Memory::Range header, range;
+    BootImage *image;
+    BootSymbol *symbols;
+    BootSegment *segments;
+    Size tables;
+
+    if (found)
+        return &library;
+
+    // Map the boot image header and tables
+    header.phys   = info.bootImageAddress;
+    header.virt   = ZERO;
+    header.size   = PAGESIZE;
+    header.access = Memory::User | Memory::Readable;
+    if (VMCtl(SELF, Map, &header) != API::Success)
+        return ZERO;
+
+    image  = (BootImage *) header.virt;
+    tables = image->segmentsTableOffset + (image->segmentsTableCount * sizeof(BootSegment));
+    if (tables > header.size)
+    {
+        VMCtl(SELF, UnMap, &header);
+        header.virt = ZERO;
+        header.size = tables;
+        if (VMCtl(SELF, Map, &header) != API::Success)
+            return ZERO;
+        image = (BootImage *) header.virt;
+    }
+    symbols  = (BootSymbol *)  (header.virt + image->symbolTableOffset);
+    segments = (BootSegment *) (header.virt + image->segmentsTableOffset);
+
+    for (Size i = 0; i < image->symbolTableCount && !found; i++)
+    {
+        if (symbols[i].type != BootLibrary || symbols[i].segmentsCount > LIBRARY_SEGMENTS)
+            continue;
+
+        // Map the library segments read-only
+        for (Size j = 0; j < symbols[i].segmentsCount; j++)
+        {
+            range.phys   = info.bootImageAddress + segments[symbols[i].segmentsOffset + j].offset;
+            range.virt   = ZERO;
+            range.size   = segments[symbols[i].segmentsOffset + j].size;
+            range.access = Memory::User | Memory::Readable;
+            VMCtl(SELF, Map, &range);
+
+            library.phys[j]  = range.phys;
+            library.local[j] = range.virt;
+        }
+
+        // The first segment starts with the ELF headers
+        library.count = LIBRARY_SEGMENTS;
+        if (ExecutableFormat::find((u8 *) library.local[0], segments[symbols[i].segmentsOffset].size,
+                                   &fmt) == ExecutableFormat::Success)
+        {
+            found = fmt->layout(library.regions, &library.count) == ExecutableFormat::Success &&
+                    library.count == symbols[i].segmentsCount;
+            delete fmt;
+        }
+        library.entry = symbols[i].entry;
+    }
+    VMCtl(SELF, UnMap, &header);
+    return found ? &library : ZERO;
+}
+
+/**
+ * Map the shared library into a child.
+ *
+ * Read-only segments are shared with the boot image. Writable
+ * segments are private to the child and copied from the boot image.
+ *
+ * @param batch SystemCallBatch to add the system calls to.
+ * @param pid ProcessID of the child.
+ * @param library SharedLibrary to map.
+ * @param base Load bias of the library in the child.
+ * @param ranges Memory ranges for each library segment.
+ */
+static void mapLibrary(SystemCallBatch *batch, ProcessID pid,
+                       const SharedLibrary *library, Address base,
+                       Memory::Range *ranges)
+{
+    for (Size i = 0; i < library->count; i++)
+    {
+        const ExecutableFormat::Region *region = &library->regions[i];
+
+        if (!(region->access & Memory::Writable) && !(region->virt & ~PAGEMASK))
+        {
+            ranges[i].virt   = base + region->virt;
+            ranges[i].phys   = library->phys[i];
+            ranges[i].size   = region->size;
+            ranges[i].access = Memory::User | Memory::Readable |
+                               Memory::Executable | Memory::CopyOnWrite;
+            batch->vmCtl(pid, Map, &ranges[i], true);
+        }
+        else
+        {
+            ranges[i].virt   = base + (region->virt & PAGEMASK);
+            ranges[i].phys   = ZERO;
+            ranges[i].size   = region->size + (region->virt & ~PAGEMASK);
+            ranges[i].access = Memory::User | Memory::Readable | Memory::Writable;
+            batch->vmCtl(pid, MapZero, &ranges[i], true);
+            batch->vmCopy(pid, API::Write, library->local[i], base + region->virt,
+                          region->dataSize, true);
+        }
+    }
+}
+
+/**
+ * Let the filesystem load a program region into the child.
+ *
+ * @param fd File descriptor of the program file.
+ * @param pid ProcessID of the child.
+ * @param region Region to load, which must already be mapped in the child.
+ *
+ * @return True on success and false otherwise.
+ */
+static bool loadRegion(int fd, ProcessID pid, const ExecutableFormat::Region *region)
+{
+    FileSystemMessage msg;
+    FileDescriptor *files = getFiles();
+
+    msg.type   = ChannelMessage::Request;
+    msg.action = LoadFile;
+    msg.path   = files[fd].path;
+    msg.buffer = (char *) region->virt;
+    msg.size   = region->dataSize;
+    msg.offset = region->dataOffset;
+    msg.target = pid;
+    msg.from   = SELF;
+    msg.deviceID.minor = files[fd].identifier;
+    ChannelClient::instance->syncSendReceive(&msg, files[fd].mount);
+
+    return msg.result == (Error) region->dataSize;
+}
+
+/**
+ * Create a new process and execute program.
+ *
+ * @param path File to execute.
+ * @param argv Argument list pointer.
+ * @param system True to make the new process a system process.
+ *
+ * @return New process ID on success and -1 on failure.
+ */
+static int execute(const char *path, const char *argv[], bool system)
 {
     ExecutableFormat *fmt;
     ExecutableFormat::Region regions[16];
-    Memory::Range range;
+    Memory::Range range, ranges[16], libraryRanges[LIBRARY_SEGMENTS];
+    const SharedLibrary *library = ZERO;
     Arch::MemoryMap map;
     uint count = 0;
     pid_t pid = 0;
     Size numRegions = 16;
     int fd;
-    struct stat st;
-    u8 *image;
-    Address entry;
-
-    // Find program image
-    if (stat(path, &st) != 0)
-        return -1;
+    ssize_t headerSize;
+    u8 *header;
+    Address entry, dynamic = 0;
 
     // Open program image
     if ((fd = open(path, O_RDONLY)) < 0)
         return -1;
 
-    // Read the program image
-    image = new u8[st.st_size];
-    if (read(fd, image, st.st_size) != st.st_size)
+    // Read the program headers. The filesystem loads the contents later.
+    header = new u8[PAGESIZE];
+    if ((headerSize = read(fd, header, PAGESIZE)) <= 0)
     {
-        delete image;
+        delete[] header;
         close(fd);
         return -1;
     }
-    close(fd);
 
     // Attempt to read executable format
-    if (ExecutableFormat::find(image, st.st_size, &fmt) != ExecutableFormat::Success)
+    if (ExecutableFormat::find(header, headerSize, &fmt) != ExecutableFormat::Success)
     {
-        delete image;
+        delete[] header;
+        close(fd);
         errno = ENOEXEC;
         return -1;
     }
 
-    // Retrieve entry point
-    if (fmt->entry(&entry) != ExecutableFormat::Success)
+    // Retrieve entry point and memory regions
+    if (fmt->entry(&entry) != ExecutableFormat::Success ||
+        fmt->layout(regions, &numRegions) != ExecutableFormat::Success)
     {
         delete fmt;
-        delete image;
+        delete[] header;
+        close(fd);
         errno = ENOEXEC;
         return -1;
     }
 
+    // Dynamically linked programs start in the shared library
+    if (fmt->dynamic(&dynamic) == ExecutableFormat::Success)
+    {
+        if (!(library = findLibrary()))
+        {
+            delete fmt;
+            delete[] header;
+            close(fd);
+            errno = ENOEXEC;
+            return -1;
+        }
+        entry = map.range(MemoryMap::UserLibrary).virt + library->entry;
+    }
+
+    // Not needed anymore
+    delete fmt;
+    delete[] header;
+
     // Create new process
     pid = ProcessCtl(ANY, Spawn, entry);
     if (pid == (pid_t) -1)
     {
-        delete fmt;
-        delete image;
+        close(fd);
         errno = EIO;
         return -1;
     }
 
-    // Retrieve memory regions
-    if (fmt->regions(regions, &numRegions) != ExecutableFormat::Success)
-    {
-        delete fmt;
-        delete image;
-        errno = ENOEXEC;
-        return -1;
-    }
+    // Allocate arguments, current working directory and channels table
+    char *arguments = new char[PAGESIZE*2];
+    memset(arguments, 0, PAGESIZE*2);
 
-    // Not needed anymore
-    delete fmt;
-    delete image;
+    // Collect all system calls to setup the new process in one batch.
+    // The channels are optional and come first, after that each call
+    // is linked to the next, such that a failure cancels the rest.
+    SystemCallBatch *batch = new SystemCallBatch;
+    presetChannels(batch, pid, (ProcessShares::MemoryShare *) (arguments + CHANNEL_PRESETS_OFFSET));
 
-    // Map program regions into virtual memory of the new process
+    // Map zeroed memory for the program regions in the new process
     for (Size i = 0; i < numRegions; i++)
     {
-        // Copy executable memory from this region
-        range.virt   = regions[i].virt;
-        range.phys   = ZERO;
-        range.size   = regions[i].size;
-        range.access = Memory::User |
-                       Memory::Readable |
-                       Memory::Writable |
-                       Memory::Executable;
-
-        // Create mapping first
-        if (VMCtl(pid, Map, &range) != 0)
-        {
-            errno = EFAULT;
-            return -1;
-        }
-        // Copy bytes
-        VMCopy(pid, API::Write, (Address) regions[i].data,
-               regions[i].virt, regions[i].size);
+        ranges[i].virt   = regions[i].virt;
+        ranges[i].phys   = ZERO;
+        ranges[i].size   = regions[i].size;
+        ranges[i].access = Memory::User |
+                           Memory::Readable |
+                           Memory::Writable |
+                           Memory::Executable;
+        batch->vmCtl(pid, MapZero, &ranges[i], true);
+    }
 
-        // Release buffer
-        delete regions[i].data;
+    // Map the shared library
+    if (library)
+    {
+        DynamicInfo *info = (DynamicInfo *) (arguments + DYNAMIC_INFO_OFFSET);
+        info->program = dynamic;
+        info->library = map.range(MemoryMap::UserLibrary).virt;
+        mapLibrary(batch, pid, library, info->library, libraryRanges);
     }
 
     // Create mapping for command-line arguments
     range = map.range(MemoryMap::UserArgs);
     range.phys = ZERO;
     range.access = Memory::User | Memory::Readable | Memory::Writable;
-    VMCtl(pid, Map, &range);
-
-    // Allocate arguments and current working directory
-    char *arguments = new char[PAGESIZE*2];
-    memset(arguments, 0, PAGESIZE);
+    batch->vmCtl(pid, Map, &range, true);
 
     // Fill in arguments
     while (argv[count] && count < PAGESIZE / ARGV_SIZE)
@@ -144,28 +390,51 @@ int forkexec(const char *path, const char *argv[])
     strlcpy(arguments + PAGESIZE, **(getCurrentDirectory()), PATH_MAX);
 
     // Copy argc/argv into the new process
-    if ((VMCopy(pid, API::Write, (Address) arguments, range.virt, PAGESIZE * 2)) < 0)
+    batch->vmCopy(pid, API::Write, (Address) arguments, range.virt, PAGESIZE * 2, true);
+
+    // Setup the new process with a single kernel entry
+    bool success = batch->execute() == SystemCallBatch::Success &&
+                   batch->getResult(batch->count() - 1) == API::Success;
+
+    // Let the filesystem copy the segments straight into the new process
+    for (Size i = 0; success && i < numRegions; i++)
+        if (regions[i].dataSize && !loadRegion(fd, pid, &regions[i]))
+            success = false;
+
+    // The program file is not inherited
+    close(fd);
+
+    // Copy fds into the new process and let it begin execution
+    if (success)
     {
-        delete[] arguments;
-        errno = EFAULT;
-        ProcessCtl(pid, KillPID);
-        return -1;
+        batch->clear();
+        batch->vmCopy(pid, API::Write, (Address) getFiles(),
+                      range.virt + (PAGESIZE * 2), range.size - (PAGESIZE * 2), true);
+        if (system)
+            batch->processCtl(pid, GrantSystem, 0, 0, true);
+        batch->processCtl(pid, Resume);
+        success = batch->execute() == SystemCallBatch::Success && batch->succeeded();
     }
 
-    // Copy fds into the new process.
-    if ((VMCopy(pid, API::Write, (Address) getFiles(),
-                range.virt + (PAGESIZE * 2), range.size - (PAGESIZE * 2))) < 0)
+    // Cleanup
+    delete[] arguments;
+    delete batch;
+
+    if (!success)
     {
-        delete[] arguments;
         errno = EFAULT;
         ProcessCtl(pid, KillPID);
         return -1;
     }
+    return pid;
+}
 
-    // Let the Child begin execution
-    ProcessCtl(pid, Resume);
+int forkexec(const char *path, const char *argv[])
+{
+    return execute(path, argv, false);
+}
 
-    // Done. Cleanup.
-    delete[] arguments;
-    return pid;
+int forkexec_system(const char *path, const char *argv[])
+{
+    return execute(path, argv, true);
 }
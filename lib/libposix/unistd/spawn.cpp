@@ -17,6 +17,7 @@
 
 #include <FreeNOS/System.h>
 #include <ExecutableFormat.h>
+#include <SystemCallBatch.h>
 #include <Types.h>
 #include <Runtime.h>
 #include <string.h>
@@ -28,7 +29,7 @@ int spawn(Address program, Size programSize, const char *command)
     ExecutableFormat *fmt;
     ExecutableFormat::Region regions[16];
     Arch::MemoryMap map;
-    Memory::Range range;
+    Memory::Range range, ranges[16];
     uint count = 0;
     pid_t pid = 0;
     Size numRegions = 16;
@@ -68,38 +69,33 @@ int spawn(Address program, Size programSize, const char *command)
     // Release buffers
     delete fmt;
 
+    // Collect all system calls to setup the new process in one batch.
+    // Each call is linked to the next, such that a failure cancels the rest.
+    SystemCallBatch *batch = new SystemCallBatch;
+
     // Map program regions into virtual memory of the new process
     for (Size i = 0; i < numRegions; i++)
     {
         // Copy executable memory from this region
-        range.virt   = regions[i].virt;
-        range.phys   = ZERO;
-        range.size   = regions[i].size;
-        range.access = Memory::User |
-                       Memory::Readable |
-                       Memory::Writable |
-                       Memory::Executable;
-
-        // Create mapping first
-        if (VMCtl(pid, Map, &range) != 0)
-        {
-            errno = EFAULT;
-            return -1;
-        }
-
-        // Copy bytes
-        VMCopy(pid, API::Write, (Address) regions[i].data,
-               regions[i].virt, regions[i].size);
-
-        // Release data buffer
-        delete regions[i].data;
+        ranges[i].virt   = regions[i].virt;
+        ranges[i].phys   = ZERO;
+        ranges[i].size   = regions[i].size;
+        ranges[i].access = Memory::User |
+                           Memory::Readable |
+                           Memory::Writable |
+                           Memory::Executable;
+
+        // Create mapping first, then copy bytes
+        batch->vmCtl(pid, Map, &ranges[i], true);
+        batch->vmCopy(pid, API::Write, (Address) regions[i].data,
+                      regions[i].virt, regions[i].size, true);
     }
 
     // Create mapping for command-line arguments
     range = map.range(MemoryMap::UserArgs);
     range.phys = ZERO;
     range.access = Memory::User | Memory::Readable | Memory::Writable;
-    VMCtl(pid, Map, &range);
+    batch->vmCtl(pid, Map, &range, true);
 
     // Allocate arguments
     char *arguments = new char[PAGESIZE * 2];
@@ -122,18 +118,25 @@ int spawn(Address program, Size programSize, const char *command)
     strlcpy(arguments + (ARGV_SIZE * count), arg, command-arg+1);
 
     // Copy argc/argv into the new process
-    if ((VMCopy(pid, API::Write, (Address) arguments, range.virt, PAGESIZE * 2)) < 0)
+    batch->vmCopy(pid, API::Write, (Address) arguments, range.virt, PAGESIZE * 2, true);
+
+    // Let the Child begin execution
+    batch->processCtl(pid, Resume);
+
+    // Setup and start the new process with a single kernel entry
+    bool success = batch->execute() == SystemCallBatch::Success && batch->succeeded();
+
+    // Cleanup
+    for (Size i = 0; i < numRegions; i++)
+        delete regions[i].data;
+    delete[] arguments;
+    delete batch;
+
+    if (!success)
     {
-        delete[] arguments;
         errno = EFAULT;
         ProcessCtl(pid, KillPID);
         return -1;
     }
-
-    // Let the Child begin execution
-    ProcessCtl(pid, Resume);
-
-    // Done. Cleanup.
-    delete[] arguments;
     return pid;
 }
@@ -36,7 +36,7 @@
  *
  * This class contains some extra functionality, somewhat like the Arrays class in Java.
  */
-template <class T, Size N> class Array : public Sequence<T>
+template <class T, Size N> class Array final : public Sequence<T>
 {
   public:
 
@@ -150,6 +150,100 @@ template <class T, Size N> class Array : public Sequence<T>
         return N;
     }
 
+    /**
+     * Returns the item at the given position in the Array.
+     *
+     * Unlike at() this does not go through the virtual function table,
+     * so loops over the Array can be inlined by the compiler.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    const T & operator [] (int i) const
+    {
+        return m_array[i];
+    }
+
+    /**
+     * Returns the item at the given position in the Array.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    const T & operator [] (Size i) const
+    {
+        return m_array[i];
+    }
+
+    /**
+     * Returns the item at the given position in the Array.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    T & operator [] (int i)
+    {
+        return m_array[i];
+    }
+
+    /**
+     * Returns the item at the given position in the Array.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    T & operator [] (Size i)
+    {
+        return m_array[i];
+    }
+
+    /**
+     * Get a pointer to the first item.
+     *
+     * Together with end() allows iterating over the items with a
+     * plain pointer instead of virtual get() or at() calls.
+     *
+     * @return Pointer to the first item.
+     */
+    const T * begin() const
+    {
+        return m_array;
+    }
+
+    /**
+     * Get a pointer past the last item.
+     *
+     * @return Pointer past the last item.
+     */
+    const T * end() const
+    {
+        return m_array + N;
+    }
+
+    /**
+     * Get a pointer to the first item.
+     *
+     * @return Pointer to the first item.
+     */
+    T * begin()
+    {
+        return m_array;
+    }
+
+    /**
+     * Get a pointer past the last item.
+     *
+     * @return Pointer past the last item.
+     */
+    T * end()
+    {
+        return m_array + N;
+    }
+
   private:
 
     /** The actual array where the data is stored. */
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBSTD_ATOMIC_H
+#define __LIBSTD_ATOMIC_H
+
+#include "Types.h"
+#include "Macros.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/**
+ * Variable which is accessed by multiple cores at the same time.
+ *
+ * Loads have acquire and stores have release semantics. The read-modify-write
+ * operations are full memory barriers.
+ *
+ * @note T must be an integer or pointer type of at most the native word size.
+ */
+template <class T> class Atomic
+{
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param value Initial value.
+     */
+    Atomic(T value = T())
+        : m_value(value)
+    {
+    }
+
+    /**
+     * Read the value.
+     *
+     * @return Current value.
+     */
+    T load() const
+    {
+        T value = m_value;
+        acquire();
+        return value;
+    }
+
+    /**
+     * Write the value.
+     *
+     * @param value New value.
+     */
+    void store(T value)
+    {
+        fence();
+        m_value = value;
+    }
+
+    /**
+     * Replace the value.
+     *
+     * @param value New value.
+     *
+     * @return Previous value.
+     */
+    T exchange(T value)
+    {
+        T previous;
+
+        fence();
+        previous = __sync_lock_test_and_set(&m_value, value);
+        fence();
+        return previous;
+    }
+
+    /**
+     * Replace the value, if it equals the expected value.
+     *
+     * @param expected Expected current value.
+     * @param value New value.
+     *
+     * @return True if replaced, false otherwise.
+     */
+    bool compareAndSwap(T expected, T value)
+    {
+        return __sync_bool_compare_and_swap(&m_value, expected, value);
+    }
+
+    /**
+     * Add to the value.
+     *
+     * @param amount Amount to add.
+     *
+     * @return New value.
+     */
+    T add(T amount)
+    {
+        return __sync_add_and_fetch(&m_value, amount);
+    }
+
+    /**
+     * Full memory barrier.
+     *
+     * No load or store is reordered across the barrier.
+     */
+    static void fence()
+    {
+        __sync_synchronize();
+    }
+
+    /**
+     * Acquire barrier.
+     *
+     * No load or store after the barrier is reordered before a preceding load.
+     */
+    static void acquire()
+    {
+#if defined(__i386__) || defined(__x86_64__)
+        asm volatile ("" ::: "memory");
+#else
+        __sync_synchronize();
+#endif
+    }
+
+    /**
+     * Release barrier.
+     *
+     * No load or store before the barrier is reordered after a following store.
+     */
+    static void release()
+    {
+#if defined(__i386__) || defined(__x86_64__)
+        asm volatile ("" ::: "memory");
+#else
+        __sync_synchronize();
+#endif
+    }
+
+  private:
+
+    /** Current value. */
+    volatile T m_value;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_ATOMIC_H */
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBSTD_CONCURRENTINDEX_H
+#define __LIBSTD_CONCURRENTINDEX_H
+
+#include "Types.h"
+#include "Macros.h"
+#include "Atomic.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/**
+ * Fixed size array of pointers to items with lock-free reads.
+ *
+ * Readers may call get() at any time without taking a lock. Writers must be
+ * serialized by the caller, and items removed with remove() may only be
+ * released after all readers are done with them.
+ *
+ * @see RCU
+ */
+template <class T, Size N> class ConcurrentIndex
+{
+  public:
+
+    /**
+     * Constructor.
+     */
+    ConcurrentIndex()
+    {
+        for (Size i = 0; i < N; i++)
+            m_array[i].store(ZERO);
+    }
+
+    /**
+     * Get the size of the ConcurrentIndex.
+     *
+     * @return Number of positions.
+     */
+    Size size() const
+    {
+        return N;
+    }
+
+    /**
+     * Get the item at the given position.
+     *
+     * @param position Position of the item.
+     *
+     * @return Pointer to the item or ZERO if none.
+     */
+    T * get(Size position) const
+    {
+        return position < N ? m_array[position].load() : ZERO;
+    }
+
+    /**
+     * Publish an item at the given position.
+     *
+     * All writes to the item before the call are visible to
+     * readers which see the item.
+     *
+     * @param position Position of the item.
+     * @param item Item to publish.
+     *
+     * @return True if inserted, false if the position is invalid or used.
+     */
+    bool insert(Size position, T *item)
+    {
+        return position < N && m_array[position].compareAndSwap(ZERO, item);
+    }
+
+    /**
+     * Unpublish the item at the given position.
+     *
+     * @param position Position of the item.
+     *
+     * @return Pointer to the removed item or ZERO if none.
+     */
+    T * remove(Size position)
+    {
+        return position < N ? m_array[position].exchange(ZERO) : ZERO;
+    }
+
+  private:
+
+    /** Item pointers. */
+    Atomic<T *> m_array[N];
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_CONCURRENTINDEX_H */
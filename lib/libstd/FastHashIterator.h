@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIBSTD_FASTHASHITERATOR_H
+#define __LIBSTD_FASTHASHITERATOR_H
+
+#include "Macros.h"
+#include "Types.h"
+#include "HashTable.h"
+#include "Assert.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/**
+ * Iterate through a HashTable without virtual calls.
+ *
+ * Walks the buckets and their List nodes directly. Unlike HashIterator
+ * it does not copy the keys into a List first and none of its functions
+ * are virtual, so it does not allocate and loops over it can be inlined.
+ *
+ * Items may be inserted while iterating, but the current item must
+ * not be removed from the HashTable. The HashTable is pinned while
+ * the iterator exists, so inserts do not resize it.
+ */
+template <class K, class V> class FastHashIterator
+{
+  private:
+
+    /** Bucket type of the HashTable. */
+    typedef typename HashTable<K, V>::Bucket Bucket;
+
+    /** List node which holds a Bucket. */
+    typedef typename List<Bucket>::Node Node;
+
+  public:
+
+    /**
+     * Class constructor.
+     *
+     * @param hash Reference to the HashTable to iterate.
+     */
+    FastHashIterator(HashTable<K, V> & hash)
+        : m_hash(hash)
+        , m_begin(hash.table().begin())
+        , m_end(hash.table().end())
+    {
+        assertRead(hash);
+        m_hash.pin();
+        reset();
+    }
+
+    /**
+     * Class destructor.
+     */
+    ~FastHashIterator()
+    {
+        m_hash.unpin();
+    }
+
+    /**
+     * Reset the iterator.
+     */
+    void reset()
+    {
+        m_bucket = m_begin;
+        m_node   = m_bucket->head();
+
+        if (!m_node)
+            skip();
+    }
+
+    /**
+     * Check if there is a current item.
+     *
+     * @return true if there is a current item, false otherwise.
+     */
+    bool hasCurrent() const
+    {
+        return m_node != ZERO;
+    }
+
+    /**
+     * Get current item.
+     *
+     * @return Reference to the current value.
+     */
+    V & current()
+    {
+        return m_node->data.value;
+    }
+
+    /**
+     * Get current item.
+     *
+     * @return Reference to the current value.
+     */
+    const V & current() const
+    {
+        return m_node->data.value;
+    }
+
+    /**
+     * Get current key.
+     *
+     * @return Reference to the current key.
+     */
+    const K & key() const
+    {
+        return m_node->data.key;
+    }
+
+    /**
+     * Increment operator.
+     *
+     * @param num Ignored.
+     */
+    void operator ++(int num)
+    {
+        if (!(m_node = m_node->next))
+            skip();
+    }
+
+  private:
+
+    /**
+     * Copying would unpin the HashTable twice.
+     */
+    FastHashIterator(const FastHashIterator<K, V> & i);
+
+    /**
+     * Copying would unpin the HashTable twice.
+     */
+    FastHashIterator<K, V> & operator = (const FastHashIterator<K, V> & i);
+
+    /**
+     * Move to the head of the next non-empty bucket.
+     */
+    void skip()
+    {
+        while (!m_node && ++m_bucket != m_end)
+            m_node = m_bucket->head();
+    }
+
+  private:
+
+    /** HashTable which is pinned while iterating. */
+    HashTable<K, V> & m_hash;
+
+    /** First bucket of the HashTable. */
+    List<Bucket> *m_begin;
+
+    /** Past the last bucket of the HashTable. */
+    List<Bucket> *m_end;
+
+    /** Current bucket. */
+    List<Bucket> *m_bucket;
+
+    /** Current node or ZERO if done. */
+    Node *m_node;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_FASTHASHITERATOR_H */
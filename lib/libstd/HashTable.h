@@ -26,10 +26,14 @@
 #include "HashFunction.h"
 #include "Associative.h"
 #include "Assert.h"
+#include "Move.h"
 
 /** Default size of the HashTable internal table. */
 #define HASHTABLE_DEFAULT_SIZE    64
 
+/** Average number of items per bucket above which the HashTable grows. */
+#define HASHTABLE_LOAD_FACTOR     4
+
 /**
  * @addtogroup lib
  * @{
@@ -66,7 +70,7 @@ template <class K, class V> class HashTable : public Associative<K,V>
          * @param v V of the bucket.
          */
         Bucket(K k, V v)
-            : key(k), value(v)
+            : key(move(k)), value(move(v))
         {
         }
 
@@ -78,6 +82,34 @@ template <class K, class V> class HashTable : public Associative<K,V>
         {
         }
 
+        /**
+         * Move constructor.
+         */
+        Bucket(Bucket && b)
+            : key(move(b.key)), value(move(b.value))
+        {
+        }
+
+        /**
+         * Copy assignment operator.
+         */
+        Bucket & operator = (const Bucket & b)
+        {
+            key   = b.key;
+            value = b.value;
+            return *this;
+        }
+
+        /**
+         * Move assignment operator.
+         */
+        Bucket & operator = (Bucket && b)
+        {
+            key   = move(b.key);
+            value = move(b.value);
+            return *this;
+        }
+
         /**
          * Comparision operator.
          *
@@ -114,12 +146,62 @@ template <class K, class V> class HashTable : public Associative<K,V>
         assert(size > 0);
 
         m_count = ZERO;
+        m_pins  = ZERO;
 
         // Fill the Vector with empty Bucket Lists.
         for (Size i = 0; i < m_table.size(); i++)
             m_table.insert(List<Bucket>());
     }
 
+    /**
+     * Copy constructor.
+     *
+     * @param h HashTable to copy. Its pins are not copied.
+     */
+    HashTable(const HashTable<K, V> & h)
+        : m_table(h.m_table), m_count(h.m_count), m_pins(ZERO)
+    {
+    }
+
+    /**
+     * Move constructor.
+     *
+     * @param h HashTable to move from. Its pins are not moved.
+     */
+    HashTable(HashTable<K, V> && h)
+        : m_table(move(h.m_table)), m_count(h.m_count), m_pins(ZERO)
+    {
+        h.m_count = ZERO;
+    }
+
+    /**
+     * Assignment operator.
+     *
+     * @param h HashTable to copy. Its pins are not copied.
+     */
+    HashTable<K, V> & operator = (const HashTable<K, V> & h)
+    {
+        m_table = h.m_table;
+        m_count = h.m_count;
+        return *this;
+    }
+
+    /**
+     * Move assignment operator.
+     *
+     * @param h HashTable to move from. Its pins are not moved.
+     */
+    HashTable<K, V> & operator = (HashTable<K, V> && h)
+    {
+        if (this != &h)
+        {
+            m_table   = move(h.m_table);
+            m_count   = h.m_count;
+            h.m_count = ZERO;
+        }
+        return *this;
+    }
+
     /**
      * Inserts the given item to the Assocation.
      *
@@ -135,22 +217,22 @@ template <class K, class V> class HashTable : public Associative<K,V>
         assertRead(key);
         assertRead(value);
 
-        Size idx = hash(key, m_table.size());
-
-        // See if the given key exists. Overwrite if so.
-        for (ListIterator<Bucket> i(m_table[idx]); i.hasCurrent(); i++)
-        {
-            if (i.current().key == key)
-            {
-                i.current().value = value;
-                return true;
-            }
-        }
+        return insertBucket(key, value);
+    }
 
-        // Key does not exist. Append it.
-        m_table[idx].append(Bucket(key, value));
-        m_count++;
-        return true;
+    /**
+     * Inserts the given item to the Assocation by moving the key and value.
+     *
+     * If an item exists for the given key, its value will be replaced.
+     *
+     * @param key Key of the item to move into the HashTable.
+     * @param value Value of the item to move into the HashTable.
+     *
+     * @return bool Whether inserting the item succeeded.
+     */
+    bool insert(K && key, V && value)
+    {
+        return insertBucket(move(key), move(value));
     }
 
     /**
@@ -169,6 +251,7 @@ template <class K, class V> class HashTable : public Associative<K,V>
         // Always append
         m_table[hash(key, m_table.size())].append(Bucket(key, value));
         m_count++;
+        grow();
         return true;
     }
 
@@ -290,13 +373,9 @@ template <class K, class V> class HashTable : public Associative<K,V>
      */
     virtual const V * get(const K & key) const
     {
-        const List<Bucket> & lst = m_table[hash(key, m_table.size())];
-
-        for (ListIterator<Bucket> i(lst); i.hasCurrent(); i++)
-            if (i.current().key == key)
-                return &i.current().value;
+        const Bucket *b = find(key);
 
-        return ZERO;
+        return b ? &b->value : ZERO;
     }
 
     /**
@@ -310,13 +389,9 @@ template <class K, class V> class HashTable : public Associative<K,V>
      */
     virtual const V & at(const K & key) const
     {
-        const List<Bucket> & lst = m_table[hash(key, m_table.size())];
-
-        for (ListIterator<Bucket> i(lst); i.hasCurrent(); i++)
-            if (i.current().key == key)
-                return i.current().value;
+        const Bucket *b = find(key);
 
-        return m_table[0].head()->data.value;
+        return b ? b->value : m_table[0].head()->data.value;
     }
 
     /**
@@ -328,13 +403,60 @@ template <class K, class V> class HashTable : public Associative<K,V>
      */
     virtual const V value(const K & key, const V defaultValue = V()) const
     {
-        const List<Bucket> & lst = m_table[hash(key, m_table.size())];
+        const Bucket *b = find(key);
 
-        for (ListIterator<Bucket> i(lst); i.hasCurrent(); i++)
-            if (i.current().key == key)
-                return i.current().value;
+        return b ? b->value : defaultValue;
+    }
+
+    /**
+     * Change the number of bucket Lists.
+     *
+     * All items are rehashed into the new bucket Lists. Iterators
+     * on the HashTable are invalid afterwards.
+     *
+     * @param size New number of bucket Lists.
+     *
+     * @return True if resized, false if the size is zero or the HashTable is pinned.
+     */
+    bool resize(Size size)
+    {
+        Vector<List<Bucket> > table(size);
+
+        if (!size || m_pins)
+            return false;
+
+        for (Size i = 0; i < size; i++)
+            table.insert(List<Bucket>());
+
+        // Move every Bucket to its List in the new table
+        for (Size i = 0; i < m_table.count(); i++)
+            for (typename List<Bucket>::Node *n = m_table[i].head(); n; n = n->next)
+                table[hash(n->data.key, size)].append(move(n->data));
+
+        m_table = move(table);
+        return true;
+    }
 
-        return defaultValue;
+    /**
+     * Keep the bucket Lists in place.
+     *
+     * While pinned, inserting items does not resize the HashTable,
+     * such that pointers into the bucket Lists stay valid.
+     * FastHashIterator pins the HashTable while it exists.
+     */
+    void pin()
+    {
+        m_pins++;
+    }
+
+    /**
+     * Allow resizing again after pin().
+     *
+     * The HashTable grows on the next insert if it became too full.
+     */
+    void unpin()
+    {
+        m_pins--;
     }
 
     /**
@@ -363,6 +485,67 @@ template <class K, class V> class HashTable : public Associative<K,V>
         return (const V &) at(key);
     }
 
+  private:
+
+    /**
+     * Insert or replace an item.
+     *
+     * @param key Key of the item, copied or moved depending on the caller.
+     * @param value Value of the item, copied or moved depending on the caller.
+     *
+     * @return Always true.
+     */
+    template <class KK, class VV> bool insertBucket(KK && key, VV && value)
+    {
+        List<Bucket> & lst = m_table[hash(key, m_table.size())];
+
+        // See if the given key exists. Overwrite if so.
+        for (typename List<Bucket>::Node *n = lst.head(); n; n = n->next)
+        {
+            if (n->data.key == key)
+            {
+                n->data.value = forward<VV>(value);
+                return true;
+            }
+        }
+
+        // Key does not exist. Append it.
+        lst.emplace(forward<KK>(key), forward<VV>(value));
+        m_count++;
+        grow();
+        return true;
+    }
+
+    /**
+     * Double the number of bucket Lists if the HashTable is too full.
+     */
+    void grow()
+    {
+        if (!m_pins && m_count > m_table.size() * HASHTABLE_LOAD_FACTOR)
+            resize(m_table.size() * 2);
+    }
+
+    /**
+     * Find the first Bucket for the given key.
+     *
+     * Walks the List nodes directly instead of using a ListIterator,
+     * which avoids a virtual call for every Bucket in the List.
+     *
+     * @param key Key to find.
+     *
+     * @return Pointer to the Bucket or ZERO if not found.
+     */
+    const Bucket * find(const K & key) const
+    {
+        const List<Bucket> & lst = m_table[hash(key, m_table.size())];
+
+        for (const typename List<Bucket>::Node *n = lst.head(); n; n = n->next)
+            if (n->data.key == key)
+                return &n->data;
+
+        return ZERO;
+    }
+
   private:
 
     /** Internal table. */
@@ -370,6 +553,9 @@ template <class K, class V> class HashTable : public Associative<K,V>
 
     /** Number of values in the buckets. */
     Size m_count;
+
+    /** Number of pin() calls without unpin(). */
+    Size m_pins;
 };
 
 /**
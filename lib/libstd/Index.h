@@ -37,7 +37,7 @@
 /**
  * Index is a resizable array of pointers to items.
  */
-template <class T> class Index : public Sequence<T>
+template <class T> class Index final : public Sequence<T>
 {
   using Sequence<T>::remove;
   using Sequence<T>::contains;
@@ -58,6 +58,41 @@ template <class T> class Index : public Sequence<T>
             m_array[i] = ZERO;
     }
 
+    /**
+     * Copy constructor.
+     *
+     * The items are not owned by the Index, so only the pointers are copied.
+     *
+     * @param idx Index to copy from.
+     */
+    Index(const Index<T> & idx)
+    {
+        m_size  = idx.m_size;
+        m_count = idx.m_count;
+        m_array = new T*[m_size];
+
+        for (Size i = 0; i < m_size; i++)
+            m_array[i] = idx.m_array[i];
+    }
+
+    /**
+     * Move constructor.
+     *
+     * Takes over the pointer array. The given Index is left without slots.
+     *
+     * @param idx Index to move from.
+     */
+    Index(Index<T> && idx)
+    {
+        m_size  = idx.m_size;
+        m_count = idx.m_count;
+        m_array = idx.m_array;
+
+        idx.m_size  = 0;
+        idx.m_count = 0;
+        idx.m_array = ZERO;
+    }
+
     /**
      * Destructor.
      */
@@ -66,6 +101,53 @@ template <class T> class Index : public Sequence<T>
         delete[] m_array;
     }
 
+    /**
+     * Copy assignment operator.
+     *
+     * @param idx Index to copy from.
+     *
+     * @return Reference to this Index.
+     */
+    Index<T> & operator = (const Index<T> & idx)
+    {
+        if (this != &idx)
+        {
+            T **array = new T*[idx.m_size];
+
+            for (Size i = 0; i < idx.m_size; i++)
+                array[i] = idx.m_array[i];
+
+            delete[] m_array;
+            m_array = array;
+            m_size  = idx.m_size;
+            m_count = idx.m_count;
+        }
+        return *this;
+    }
+
+    /**
+     * Move assignment operator.
+     *
+     * @param idx Index to move from.
+     *
+     * @return Reference to this Index.
+     */
+    Index<T> & operator = (Index<T> && idx)
+    {
+        if (this != &idx)
+        {
+            delete[] m_array;
+            m_array = idx.m_array;
+            m_size  = idx.m_size;
+            m_count = idx.m_count;
+
+            idx.m_array = ZERO;
+            idx.m_size  = 0;
+            idx.m_count = 0;
+        }
+        return *this;
+    }
+
     /**
      * Adds the given item to the Sequence, if possible.
      *
@@ -226,6 +308,81 @@ template <class T> class Index : public Sequence<T>
         return m_count;
     }
 
+    /**
+     * Returns the item at the given position in the Index.
+     *
+     * Unlike at() this does not go through the virtual function table,
+     * so loops over the Index can be inlined by the compiler.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    const T & operator [] (int i) const
+    {
+        return (*m_array[i]);
+    }
+
+    /**
+     * Returns the item at the given position in the Index.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    const T & operator [] (Size i) const
+    {
+        return (*m_array[i]);
+    }
+
+    /**
+     * Returns the item at the given position in the Index.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    T & operator [] (int i)
+    {
+        return (*m_array[i]);
+    }
+
+    /**
+     * Returns the item at the given position in the Index.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    T & operator [] (Size i)
+    {
+        return (*m_array[i]);
+    }
+
+    /**
+     * Get a pointer to the first slot.
+     *
+     * Together with end() allows iterating over the slots of the Index
+     * with a plain pointer instead of virtual get() calls. Empty slots
+     * contain ZERO.
+     *
+     * @return Pointer to the first slot.
+     */
+    T * const * begin() const
+    {
+        return m_array;
+    }
+
+    /**
+     * Get a pointer past the last slot.
+     *
+     * @return Pointer past the last slot.
+     */
+    T * const * end() const
+    {
+        return m_array + m_size;
+    }
+
   private:
 
     /** Array of pointers to items. */
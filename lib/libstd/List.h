@@ -21,6 +21,7 @@
 #include "Macros.h"
 #include "Assert.h"
 #include "Sequence.h"
+#include "Move.h"
 
 /**
  * @addtogroup lib
@@ -46,8 +47,11 @@ template <class T> class List : public Sequence<T>
 
         /**
          * Constructor.
+         *
+         * @param args Arguments for the constructor of the item.
          */
-        Node(T t) : data(t)
+        template <class... Args> Node(Args &&... args)
+            : data(forward<Args>(args)...)
         {
             prev = ZERO;
             next = ZERO;
@@ -88,6 +92,24 @@ template <class T> class List : public Sequence<T>
             append(node->data);
     }
 
+    /**
+     * Move constructor.
+     *
+     * Takes over the nodes of the given List, which is left empty.
+     *
+     * @param lst List instance to move from
+     */
+    List(List<T> && lst)
+    {
+        m_head  = lst.m_head;
+        m_tail  = lst.m_tail;
+        m_count = lst.m_count;
+
+        lst.m_head  = ZERO;
+        lst.m_tail  = ZERO;
+        lst.m_count = 0;
+    }
+
     /**
      * Class destructor.
      */
@@ -104,32 +126,67 @@ template <class T> class List : public Sequence<T>
     }
 
     /**
-     * Insert an item at the start of the list.
+     * Copy assignment operator.
      *
-     * @param t Data item to te inserted.
+     * @param lst List instance to copy from
+     *
+     * @return Reference to this List.
      */
-    void prepend(T t)
+    List<T> & operator = (const List<T> & lst)
     {
-        assertRead(t);
+        if (this != &lst)
+        {
+            clear();
 
-        // Create a new node with the item.
-        Node *node = new Node(t);
+            for (Node *node = lst.m_head; node; node = node->next)
+                append(node->data);
+        }
+        return *this;
+    }
 
-        // Connect the item to the list head, if set
-        if (m_head)
+    /**
+     * Move assignment operator.
+     *
+     * @param lst List instance to move from
+     *
+     * @return Reference to this List.
+     */
+    List<T> & operator = (List<T> && lst)
+    {
+        if (this != &lst)
         {
-            m_head->prev = node;
-            node->next = m_head;
+            clear();
+
+            m_head  = lst.m_head;
+            m_tail  = lst.m_tail;
+            m_count = lst.m_count;
+
+            lst.m_head  = ZERO;
+            lst.m_tail  = ZERO;
+            lst.m_count = 0;
         }
-        // Make the new node head of the list.
-        m_head = node;
+        return *this;
+    }
 
-        // Also make it the tail, if not yet set
-        if (!m_tail)
-            m_tail = node;
+    /**
+     * Insert an item at the start of the list.
+     *
+     * @param t Data item to te inserted.
+     */
+    void prepend(const T & t)
+    {
+        assertRead(t);
+        linkHead(new Node(t));
+    }
 
-        // Update node count
-        m_count++;
+    /**
+     * Insert an item at the start of the list by moving it.
+     *
+     * @param t Data item to te inserted.
+     */
+    void prepend(T && t)
+    {
+        linkHead(new Node(move(t)));
     }
 
     /**
@@ -137,26 +194,33 @@ template <class T> class List : public Sequence<T>
      *
      * @param t Item to insert.
      */
-    void append(T t)
+    void append(const T & t)
     {
         assertRead(t);
+        linkTail(new Node(t));
+    }
 
-        Node *node = new Node(t);
-        node->prev = m_tail;
-
-        // Connect the item with the tail, if any.
-        if (m_tail)
-            m_tail->next = node;
-
-        // Make the new Node the tail of the list.
-        m_tail = node;
-
-        // Also make the item the head, if none.
-        if (!m_head)
-            m_head = node;
+    /**
+     * Insert an item at the end of the list by moving it.
+     *
+     * @param t Item to insert.
+     */
+    void append(T && t)
+    {
+        linkTail(new Node(move(t)));
+    }
 
-        // Update node count.
-        m_count++;
+    /**
+     * Construct an item at the end of the list.
+     *
+     * The item is constructed inside the new node from the given arguments,
+     * without any temporary copy.
+     *
+     * @param args Arguments for the constructor of T.
+     */
+    template <class... Args> void emplace(Args &&... args)
+    {
+        linkTail(new Node(forward<Args>(args)...));
     }
 
     /**
@@ -416,7 +480,7 @@ template <class T> class List : public Sequence<T>
      */
     List & operator << (T t)
     {
-        append(t);
+        append(move(t));
         return (*this);
     }
 
@@ -450,6 +514,56 @@ template <class T> class List : public Sequence<T>
         return false;
     }
 
+  private:
+
+    /**
+     * Insert a node at the start of the list.
+     *
+     * @param node Node to insert.
+     */
+    void linkHead(Node *node)
+    {
+        // Connect the item to the list head, if set
+        if (m_head)
+        {
+            m_head->prev = node;
+            node->next = m_head;
+        }
+        // Make the new node head of the list.
+        m_head = node;
+
+        // Also make it the tail, if not yet set
+        if (!m_tail)
+            m_tail = node;
+
+        // Update node count
+        m_count++;
+    }
+
+    /**
+     * Insert a node at the end of the list.
+     *
+     * @param node Node to insert.
+     */
+    void linkTail(Node *node)
+    {
+        node->prev = m_tail;
+
+        // Connect the item with the tail, if any.
+        if (m_tail)
+            m_tail->next = node;
+
+        // Make the new Node the tail of the list.
+        m_tail = node;
+
+        // Also make the item the head, if none.
+        if (!m_head)
+            m_head = node;
+
+        // Update node count.
+        m_count++;
+    }
+
   private:
 
     /** Head of the List. */
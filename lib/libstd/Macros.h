@@ -140,6 +140,13 @@ inline bool doubleEquals(double a, double b, double epsilon)
 #define USED \
     __attribute__((__used__))
 
+/**
+ * Declares a symbol which may be left undefined
+ * and is only visible inside its own object.
+ */
+#define WEAK_HIDDEN \
+    __attribute__((__weak__, __visibility__("hidden")))
+
 /**
  * Ensures strict minimum memory requirements.
  *
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIBSTD_MOVE_H
+#define __LIBSTD_MOVE_H
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/**
+ * Strip the reference from a type.
+ */
+template <class T> struct RemoveReference
+{
+    /** Type without reference. */
+    typedef T Type;
+};
+
+/**
+ * Strip the reference from an lvalue reference type.
+ */
+template <class T> struct RemoveReference<T &>
+{
+    /** Type without reference. */
+    typedef T Type;
+};
+
+/**
+ * Strip the reference from an rvalue reference type.
+ */
+template <class T> struct RemoveReference<T &&>
+{
+    /** Type without reference. */
+    typedef T Type;
+};
+
+/**
+ * Allow the contents of an object to be moved instead of copied.
+ *
+ * @param t Object to move from. It must still be destroyed or assigned,
+ *          but its contents are unspecified afterwards.
+ *
+ * @return Rvalue reference to the object.
+ */
+template <class T> inline typename RemoveReference<T>::Type && move(T && t)
+{
+    return static_cast<typename RemoveReference<T>::Type &&>(t);
+}
+
+/**
+ * Pass on an argument with the same value category it was given with.
+ *
+ * @param t Lvalue argument.
+ *
+ * @return Reference of the original value category.
+ */
+template <class T> inline T && forward(typename RemoveReference<T>::Type & t)
+{
+    return static_cast<T &&>(t);
+}
+
+/**
+ * Pass on an argument with the same value category it was given with.
+ *
+ * @param t Rvalue argument.
+ *
+ * @return Rvalue reference.
+ */
+template <class T> inline T && forward(typename RemoveReference<T>::Type && t)
+{
+    return static_cast<T &&>(t);
+}
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_MOVE_H */
@@ -0,0 +1,367 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIBSTD_PRIORITYQUEUE_H
+#define __LIBSTD_PRIORITYQUEUE_H
+
+#include "Assert.h"
+#include "Types.h"
+#include "Macros.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/** Default initial capacity of a PriorityQueue. */
+#define PRIORITYQUEUE_DEFAULT_SIZE 64
+
+/**
+ * Queue which always returns its smallest item first.
+ *
+ * Implemented as a D-ary heap ordered by operator < of T. A larger D
+ * makes the heap less deep, which speeds up push() and decrease() at
+ * the cost of more comparisons per level in pop().
+ *
+ * Each item gets a handle on push(), which stays valid until the item
+ * is popped. decrease() uses the handle to lower the priority of an
+ * item in place.
+ */
+template <class T, Size D = 2> class PriorityQueue
+{
+  private:
+
+    /** Fails to compile if the heap has less than two children per node. */
+    typedef char Arity[D >= 2 ? 1 : -1];
+
+    /** Position of a handle which is not in use. */
+    static const Size Unused = ~((Size) 0);
+
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param size Initial capacity. Grows when full.
+     */
+    PriorityQueue(Size size = PRIORITYQUEUE_DEFAULT_SIZE)
+        : m_items(ZERO)
+        , m_heap(ZERO)
+        , m_position(ZERO)
+        , m_free(ZERO)
+        , m_size(0)
+        , m_count(0)
+        , m_freeCount(0)
+    {
+        assert(size > 0);
+        resize(size);
+    }
+
+    /**
+     * Destructor.
+     */
+    ~PriorityQueue()
+    {
+        delete[] m_items;
+        delete[] m_heap;
+        delete[] m_position;
+        delete[] m_free;
+    }
+
+    /**
+     * Add an item.
+     *
+     * @param item Item to add.
+     *
+     * @return Handle of the item or -1 on failure.
+     */
+    int push(const T & item)
+    {
+        Size handle;
+
+        if (!m_freeCount && !resize(m_size * 2))
+            return -1;
+
+        handle = m_free[--m_freeCount];
+        m_items[handle] = item;
+        m_heap[m_count] = handle;
+        m_position[handle] = m_count;
+        siftUp(m_count++);
+        return (int) handle;
+    }
+
+    /**
+     * Remove the smallest item.
+     *
+     * @param item Output for the removed item.
+     *
+     * @return True on success, false if empty.
+     */
+    bool pop(T *item)
+    {
+        Size handle;
+
+        if (!m_count)
+            return false;
+
+        handle = m_heap[0];
+        *item  = m_items[handle];
+        m_position[handle] = Unused;
+        m_free[m_freeCount++] = handle;
+
+        if (--m_count)
+        {
+            m_heap[0] = m_heap[m_count];
+            m_position[m_heap[0]] = 0;
+            siftDown(0);
+        }
+        return true;
+    }
+
+    /**
+     * Get the smallest item without removing it.
+     *
+     * @return Pointer to the item or ZERO if empty.
+     */
+    const T * top() const
+    {
+        return m_count ? &m_items[m_heap[0]] : ZERO;
+    }
+
+    /**
+     * Lower the priority value of an item.
+     *
+     * @param handle Handle of the item returned by push().
+     * @param item New value, which must not be larger than the current value.
+     *
+     * @return True on success, false if the handle is not in use
+     *         or the new value is larger.
+     */
+    bool decrease(Size handle, const T & item)
+    {
+        if (handle >= m_size || m_position[handle] == Unused)
+            return false;
+
+        if (m_items[handle] < item)
+            return false;
+
+        m_items[handle] = item;
+        siftUp(m_position[handle]);
+        return true;
+    }
+
+    /**
+     * Get an item by its handle.
+     *
+     * @param handle Handle of the item returned by push().
+     *
+     * @return Pointer to the item or ZERO if the handle is not in use.
+     */
+    const T * get(Size handle) const
+    {
+        if (handle >= m_size || m_position[handle] == Unused)
+            return ZERO;
+
+        return &m_items[handle];
+    }
+
+    /**
+     * Remove all items.
+     */
+    void clear()
+    {
+        for (Size i = 0; i < m_size; i++)
+        {
+            m_position[i] = Unused;
+            m_free[i] = m_size - i - 1;
+        }
+        m_count = 0;
+        m_freeCount = m_size;
+    }
+
+    /**
+     * Get the current capacity.
+     *
+     * @return Number of items which fit without growing.
+     */
+    Size size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Get the number of items.
+     *
+     * @return Number of items in the PriorityQueue.
+     */
+    Size count() const
+    {
+        return m_count;
+    }
+
+    /**
+     * Check if the PriorityQueue is empty.
+     *
+     * @return True if empty, false otherwise.
+     */
+    bool isEmpty() const
+    {
+        return m_count == 0;
+    }
+
+  private:
+
+    /**
+     * Move an item up until its parent is not larger.
+     *
+     * @param pos Heap position of the item.
+     */
+    void siftUp(Size pos)
+    {
+        const Size handle = m_heap[pos];
+
+        while (pos > 0)
+        {
+            const Size parent = (pos - 1) / D;
+
+            if (!(m_items[handle] < m_items[m_heap[parent]]))
+                break;
+
+            m_heap[pos] = m_heap[parent];
+            m_position[m_heap[pos]] = pos;
+            pos = parent;
+        }
+        m_heap[pos] = handle;
+        m_position[handle] = pos;
+    }
+
+    /**
+     * Move an item down until none of its children is smaller.
+     *
+     * @param pos Heap position of the item.
+     */
+    void siftDown(Size pos)
+    {
+        const Size handle = m_heap[pos];
+
+        while (true)
+        {
+            const Size first = (pos * D) + 1;
+            Size child = first;
+
+            if (first >= m_count)
+                break;
+
+            // Find the smallest child
+            for (Size i = first + 1; i < first + D && i < m_count; i++)
+                if (m_items[m_heap[i]] < m_items[m_heap[child]])
+                    child = i;
+
+            if (!(m_items[m_heap[child]] < m_items[handle]))
+                break;
+
+            m_heap[pos] = m_heap[child];
+            m_position[m_heap[pos]] = pos;
+            pos = child;
+        }
+        m_heap[pos] = handle;
+        m_position[handle] = pos;
+    }
+
+    /**
+     * Grow the capacity.
+     *
+     * @param size New capacity.
+     *
+     * @return True on success, false if out of memory.
+     */
+    bool resize(Size size)
+    {
+        T *items       = new T[size];
+        Size *heap     = new Size[size];
+        Size *position = new Size[size];
+        Size *free     = new Size[size];
+
+        if (!items || !heap || !position || !free)
+        {
+            delete[] items;
+            delete[] heap;
+            delete[] position;
+            delete[] free;
+            return false;
+        }
+
+        for (Size i = 0; i < m_size; i++)
+        {
+            items[i]    = m_items[i];
+            heap[i]     = m_heap[i];
+            position[i] = m_position[i];
+        }
+        for (Size i = 0; i < m_freeCount; i++)
+            free[i] = m_free[i];
+
+        // New handles are given out lowest first
+        for (Size i = size; i > m_size; i--)
+        {
+            position[i - 1] = Unused;
+            free[m_freeCount++] = i - 1;
+        }
+
+        delete[] m_items;
+        delete[] m_heap;
+        delete[] m_position;
+        delete[] m_free;
+        m_items    = items;
+        m_heap     = heap;
+        m_position = position;
+        m_free     = free;
+        m_size     = size;
+        return true;
+    }
+
+  private:
+
+    /** Items indexed by handle. */
+    T *m_items;
+
+    /** Handles in heap order. */
+    Size *m_heap;
+
+    /** Heap position indexed by handle. */
+    Size *m_position;
+
+    /** Stack of unused handles. */
+    Size *m_free;
+
+    /** Capacity of the arrays. */
+    Size m_size;
+
+    /** Number of items. */
+    Size m_count;
+
+    /** Number of unused handles. */
+    Size m_freeCount;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_PRIORITYQUEUE_H */
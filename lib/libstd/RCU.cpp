@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assert.h"
+#include "ListIterator.h"
+#include "RCU.h"
+
+RCU::RCU(Size readers)
+    : m_epoch(1), m_readers(readers)
+{
+    assert(readers > 0 && readers <= RCU_READERS_MAX);
+
+    for (Size i = 0; i < RCU_READERS_MAX; i++)
+        m_seen[i].store(0);
+}
+
+RCU::~RCU()
+{
+    for (Size i = 0; i < RCU_EPOCHS; i++)
+        release(&m_retired[i]);
+}
+
+u32 RCU::getEpoch() const
+{
+    return m_epoch.load();
+}
+
+void RCU::quiescent(Size reader)
+{
+    // Only write if changed, to avoid bouncing the cache line
+    u32 epoch = m_epoch.load();
+
+    if (m_seen[reader].load() != epoch)
+        m_seen[reader].store(epoch);
+}
+
+void RCU::setReaders(Size readers)
+{
+    assert(readers > 0 && readers <= RCU_READERS_MAX);
+
+    for (Size i = m_readers; i < readers; i++)
+        m_seen[i].store(m_epoch.load());
+
+    m_readers = readers;
+}
+
+void RCU::writeLock()
+{
+    m_lock.lock();
+}
+
+bool RCU::tryWriteLock()
+{
+    return m_lock.tryLock();
+}
+
+void RCU::writeUnlock()
+{
+    m_lock.unlock();
+}
+
+void RCU::retire(void *object, ReclaimFunction *func)
+{
+    Retired r;
+
+    r.object = object;
+    r.func   = func;
+    m_retired[m_epoch.load() % RCU_EPOCHS].append(r);
+}
+
+Size RCU::reclaim()
+{
+    u32 epoch = m_epoch.load();
+
+    // All readers must have passed a quiescent state in this epoch
+    for (Size i = 0; i < m_readers; i++)
+        if (m_seen[i].load() != epoch)
+            return 0;
+
+    // Objects retired two epochs ago can no longer be referenced
+    m_epoch.store(++epoch);
+    return release(&m_retired[(epoch + 1) % RCU_EPOCHS]);
+}
+
+Size RCU::release(List<Retired> *list)
+{
+    Size count = 0;
+
+    for (ListIterator<Retired> i(list); i.hasCurrent(); i++)
+    {
+        i.current().func(i.current().object);
+        count++;
+    }
+    list->clear();
+    return count;
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBSTD_RCU_H
+#define __LIBSTD_RCU_H
+
+#include "Types.h"
+#include "Macros.h"
+#include "Atomic.h"
+#include "SpinLock.h"
+#include "List.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/** Maximum number of readers (cores). */
+#define RCU_READERS_MAX 16
+
+/** Number of epochs with retired objects. */
+#define RCU_EPOCHS 3
+
+/**
+ * Read-Copy-Update with quiescent state based reclamation.
+ *
+ * Readers access shared objects without any locking or atomic operations.
+ * Each reader must regularly call quiescent() at a point where it holds no
+ * references to shared objects, such as on a context switch.
+ *
+ * Writers are serialized with writeLock(). After unpublishing a shared object,
+ * the writer hands it to retire(). The object is released by reclaim() once
+ * every reader passed a quiescent state, which takes two epochs.
+ */
+class RCU
+{
+  public:
+
+    /**
+     * Function which releases a retired object.
+     *
+     * @param object Object to release.
+     */
+    typedef void ReclaimFunction(void *object);
+
+    /**
+     * Constructor.
+     *
+     * @param readers Number of readers, at most RCU_READERS_MAX.
+     */
+    RCU(Size readers = 1);
+
+    /**
+     * Destructor.
+     *
+     * Releases all retired objects.
+     */
+    virtual ~RCU();
+
+    /**
+     * Get the current epoch.
+     *
+     * @return Epoch number.
+     */
+    u32 getEpoch() const;
+
+    /**
+     * Report a quiescent state.
+     *
+     * @param reader Reader number.
+     */
+    void quiescent(Size reader);
+
+    /**
+     * Change the number of readers.
+     *
+     * The caller must hold the writer lock. Added readers count
+     * as having passed a quiescent state in the current epoch.
+     *
+     * @param readers Number of readers.
+     */
+    void setReaders(Size readers);
+
+    /**
+     * Acquire the writer lock.
+     */
+    void writeLock();
+
+    /**
+     * Try to acquire the writer lock.
+     *
+     * @return True if acquired, false if another writer holds the lock.
+     */
+    bool tryWriteLock();
+
+    /**
+     * Release the writer lock.
+     */
+    void writeUnlock();
+
+    /**
+     * Retire an unpublished object.
+     *
+     * The caller must hold the writer lock.
+     *
+     * @param object Object to release later.
+     * @param func Function which releases the object.
+     */
+    void retire(void *object, ReclaimFunction *func);
+
+    /**
+     * Advance the epoch and release safe objects.
+     *
+     * The epoch only advances if all readers passed a quiescent
+     * state in the current epoch. The caller must hold the writer lock.
+     *
+     * @return Number of objects released.
+     */
+    Size reclaim();
+
+  private:
+
+    /**
+     * Retired object.
+     */
+    typedef struct Retired
+    {
+        /** Object to release. */
+        void *object;
+
+        /** Function which releases the object. */
+        ReclaimFunction *func;
+
+        bool operator == (const struct Retired & r) const
+        {
+            return object == r.object;
+        }
+        bool operator != (const struct Retired & r) const
+        {
+            return object != r.object;
+        }
+    }
+    Retired;
+
+    /**
+     * Release all objects in a list.
+     *
+     * @param list List of retired objects.
+     *
+     * @return Number of objects released.
+     */
+    Size release(List<Retired> *list);
+
+  private:
+
+    /** Current epoch. */
+    Atomic<u32> m_epoch;
+
+    /** Last epoch in which each reader passed a quiescent state. */
+    Atomic<u32> m_seen[RCU_READERS_MAX];
+
+    /** Number of readers. */
+    Size m_readers;
+
+    /** Writer lock. */
+    SpinLock m_lock;
+
+    /** Retired objects per epoch. */
+    List<Retired> m_retired[RCU_EPOCHS];
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_RCU_H */
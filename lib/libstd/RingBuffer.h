@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIBSTD_RINGBUFFER_H
+#define __LIBSTD_RINGBUFFER_H
+
+#include "Types.h"
+#include "Macros.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/**
+ * Fixed size first-in first-out queue.
+ *
+ * The head and tail counters run freely and are masked with N - 1 on
+ * each access, which is why N must be a power of two. This keeps
+ * push() and pop() at a few instructions without any modulo or
+ * wrap-around branches. No memory is allocated.
+ *
+ * @note Not safe for concurrent use. See SPSCRingBuffer.
+ */
+template <class T, Size N> class RingBuffer
+{
+  private:
+
+    /** Fails to compile if N is not a power of two. */
+    typedef char PowerOfTwo[(N && !(N & (N - 1))) ? 1 : -1];
+
+  public:
+
+    /**
+     * Constructor.
+     */
+    RingBuffer()
+        : m_head(0)
+        , m_tail(0)
+    {
+    }
+
+    /**
+     * Add an item at the tail.
+     *
+     * @param item Item to add.
+     *
+     * @return True on success, false if full.
+     */
+    bool push(const T & item)
+    {
+        if (m_tail - m_head == N)
+            return false;
+
+        m_array[m_tail & (N - 1)] = item;
+        m_tail++;
+        return true;
+    }
+
+    /**
+     * Remove the item at the head.
+     *
+     * @param item Output for the removed item.
+     *
+     * @return True on success, false if empty.
+     */
+    bool pop(T *item)
+    {
+        if (m_head == m_tail)
+            return false;
+
+        *item = m_array[m_head & (N - 1)];
+        m_head++;
+        return true;
+    }
+
+    /**
+     * Get the item at the head without removing it.
+     *
+     * @return Pointer to the item or ZERO if empty.
+     */
+    const T * peek() const
+    {
+        if (m_head == m_tail)
+            return ZERO;
+
+        return &m_array[m_head & (N - 1)];
+    }
+
+    /**
+     * Remove all items.
+     */
+    void clear()
+    {
+        m_head = m_tail;
+    }
+
+    /**
+     * Get the maximum number of items.
+     *
+     * @return Capacity of the RingBuffer.
+     */
+    Size size() const
+    {
+        return N;
+    }
+
+    /**
+     * Get the number of items.
+     *
+     * @return Number of items in the RingBuffer.
+     */
+    Size count() const
+    {
+        return m_tail - m_head;
+    }
+
+    /**
+     * Check if the RingBuffer is empty.
+     *
+     * @return True if empty, false otherwise.
+     */
+    bool isEmpty() const
+    {
+        return m_head == m_tail;
+    }
+
+    /**
+     * Check if the RingBuffer is full.
+     *
+     * @return True if full, false otherwise.
+     */
+    bool isFull() const
+    {
+        return m_tail - m_head == N;
+    }
+
+  private:
+
+    /** Storage for the items. */
+    T m_array[N];
+
+    /** Number of items removed. */
+    Size m_head;
+
+    /** Number of items added. */
+    Size m_tail;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_RINGBUFFER_H */
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIBSTD_SPSCRINGBUFFER_H
+#define __LIBSTD_SPSCRINGBUFFER_H
+
+#include "Types.h"
+#include "Macros.h"
+#include "Atomic.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/** Assumed size of a cache line, used to keep the head and tail apart. */
+#define SPSCRINGBUFFER_CACHELINE 64
+
+/**
+ * Lock-free first-in first-out queue for one producer and one consumer.
+ *
+ * Works like RingBuffer, but the producer only writes the tail and the
+ * consumer only writes the head. The item is stored before the tail is
+ * published and read before the head is published, so no lock or
+ * read-modify-write operation is needed. The counters are kept on
+ * separate cache lines, such that the producer and consumer do not
+ * invalidate each other on every operation.
+ *
+ * @note push() must only be called by one thread and pop() and peek()
+ *       only by one other thread at a time.
+ */
+template <class T, Size N> class SPSCRingBuffer
+{
+  private:
+
+    /** Fails to compile if N is not a power of two. */
+    typedef char PowerOfTwo[(N && !(N & (N - 1))) ? 1 : -1];
+
+  public:
+
+    /**
+     * Constructor.
+     */
+    SPSCRingBuffer()
+        : m_head(0)
+        , m_tail(0)
+    {
+    }
+
+    /**
+     * Add an item at the tail.
+     *
+     * Only called by the producer.
+     *
+     * @param item Item to add.
+     *
+     * @return True on success, false if full.
+     */
+    bool push(const T & item)
+    {
+        const Size tail = m_tail.load();
+
+        if (tail - m_head.load() == N)
+            return false;
+
+        m_array[tail & (N - 1)] = item;
+        m_tail.store(tail + 1);
+        return true;
+    }
+
+    /**
+     * Remove the item at the head.
+     *
+     * Only called by the consumer.
+     *
+     * @param item Output for the removed item.
+     *
+     * @return True on success, false if empty.
+     */
+    bool pop(T *item)
+    {
+        const Size head = m_head.load();
+
+        if (head == m_tail.load())
+            return false;
+
+        *item = m_array[head & (N - 1)];
+        m_head.store(head + 1);
+        return true;
+    }
+
+    /**
+     * Get the item at the head without removing it.
+     *
+     * Only called by the consumer.
+     *
+     * @return Pointer to the item or ZERO if empty.
+     */
+    const T * peek() const
+    {
+        const Size head = m_head.load();
+
+        if (head == m_tail.load())
+            return ZERO;
+
+        return &m_array[head & (N - 1)];
+    }
+
+    /**
+     * Get the maximum number of items.
+     *
+     * @return Capacity of the SPSCRingBuffer.
+     */
+    Size size() const
+    {
+        return N;
+    }
+
+    /**
+     * Get the number of items.
+     *
+     * @return Number of items, which may be outdated once returned.
+     */
+    Size count() const
+    {
+        const Size head = m_head.load();
+        return m_tail.load() - head;
+    }
+
+  private:
+
+    /** Storage for the items. */
+    T m_array[N];
+
+    /** Number of items removed, written by the consumer. */
+    Atomic<Size> m_head;
+
+    /** Keeps m_head and m_tail on separate cache lines. */
+    u8 m_pad[SPSCRINGBUFFER_CACHELINE];
+
+    /** Number of items added, written by the producer. */
+    Atomic<Size> m_tail;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_SPSCRINGBUFFER_H */
@@ -0,0 +1,349 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __LIBSTD_SORT_H
+#define __LIBSTD_SORT_H
+
+#include "Types.h"
+#include "Macros.h"
+#include "Array.h"
+#include "Vector.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/** Ranges up to this number of items are sorted by insertion sort. */
+#define SORT_INSERTION_MAX 16
+
+/**
+ * Sort a small range by insertion sort.
+ *
+ * @param begin First item.
+ * @param end Past the last item.
+ */
+template <class T> void insertionSort(T *begin, T *end)
+{
+    if (begin == end)
+        return;
+
+    for (T *i = begin + 1; i < end; i++)
+    {
+        T item = *i;
+        T *j = i;
+
+        for (; j > begin && item < *(j - 1); j--)
+            *j = *(j - 1);
+
+        *j = item;
+    }
+}
+
+/**
+ * Move an item down a max-heap.
+ *
+ * @param heap First item of the heap.
+ * @param pos Position of the item to move.
+ * @param count Number of items in the heap.
+ */
+template <class T> void heapSortDown(T *heap, Size pos, Size count)
+{
+    T item = heap[pos];
+
+    while ((pos * 2) + 1 < count)
+    {
+        Size child = (pos * 2) + 1;
+
+        if (child + 1 < count && heap[child] < heap[child + 1])
+            child++;
+
+        if (!(item < heap[child]))
+            break;
+
+        heap[pos] = heap[child];
+        pos = child;
+    }
+    heap[pos] = item;
+}
+
+/**
+ * Sort a range by heap sort.
+ *
+ * @param begin First item.
+ * @param end Past the last item.
+ */
+template <class T> void heapSort(T *begin, T *end)
+{
+    const Size count = end - begin;
+
+    for (Size i = count / 2; i > 0; i--)
+        heapSortDown(begin, i - 1, count);
+
+    for (Size i = count; i > 1; i--)
+    {
+        T tmp = begin[0];
+        begin[0] = begin[i - 1];
+        begin[i - 1] = tmp;
+        heapSortDown(begin, 0, i - 1);
+    }
+}
+
+/**
+ * Sort a range by introsort.
+ *
+ * Quicksort with a median-of-three pivot, which switches to heap sort
+ * when the recursion gets too deep and to insertion sort for small
+ * ranges. Runs in O(n log n) time in the worst case and sorts in place,
+ * but is not stable.
+ *
+ * @param begin First item.
+ * @param end Past the last item.
+ * @param depth Remaining quicksort depth. Use ZERO to compute it from the range.
+ */
+template <class T> void introSort(T *begin, T *end, Size depth = ZERO)
+{
+    if (!depth)
+    {
+        for (Size n = end - begin; n > 1; n >>= 1)
+            depth += 2;
+        depth++;
+    }
+
+    while (end - begin > SORT_INSERTION_MAX)
+    {
+        if (--depth == 0)
+        {
+            heapSort(begin, end);
+            return;
+        }
+        T *mid = begin + ((end - begin) / 2);
+        T *last = end - 1;
+        T tmp;
+
+        // Order the first, middle and last item and use the middle as pivot
+        if (*mid < *begin)  { tmp = *mid;  *mid  = *begin; *begin = tmp; }
+        if (*last < *mid)   { tmp = *last; *last = *mid;   *mid   = tmp; }
+        if (*mid < *begin)  { tmp = *mid;  *mid  = *begin; *begin = tmp; }
+
+        const T pivot = *mid;
+        T *i = begin, *j = last;
+
+        while (true)
+        {
+            while (*i < pivot)
+                i++;
+            while (pivot < *j)
+                j--;
+
+            if (i >= j)
+                break;
+
+            tmp = *i; *i = *j; *j = tmp;
+            i++;
+            j--;
+        }
+        // Recurse into the smaller half and loop on the larger one
+        if (j + 1 - begin < end - (j + 1))
+        {
+            introSort(begin, j + 1, depth);
+            begin = j + 1;
+        }
+        else
+        {
+            introSort(j + 1, end, depth);
+            end = j + 1;
+        }
+    }
+    insertionSort(begin, end);
+}
+
+/**
+ * Sort a range by merge sort.
+ *
+ * Bottom-up merge sort with insertion sorted runs. Runs in O(n log n)
+ * time and is stable: equal items keep their order.
+ *
+ * @param begin First item.
+ * @param end Past the last item.
+ * @param scratch Buffer for at least end - begin items.
+ */
+template <class T> void mergeSort(T *begin, T *end, T *scratch)
+{
+    const Size count = end - begin;
+    T *from = begin, *to = scratch;
+
+    for (Size i = 0; i < count; i += SORT_INSERTION_MAX)
+        insertionSort(begin + i, begin + (count - i < SORT_INSERTION_MAX ? count : i + SORT_INSERTION_MAX));
+
+    for (Size width = SORT_INSERTION_MAX; width < count; width *= 2)
+    {
+        for (Size lo = 0; lo < count; lo += width * 2)
+        {
+            const Size mid = count - lo < width ? count : lo + width;
+            const Size hi  = count - lo < width * 2 ? count : lo + (width * 2);
+            Size a = lo, b = mid, k = lo;
+
+            while (a < mid && b < hi)
+                to[k++] = (from[b] < from[a]) ? from[b++] : from[a++];
+            while (a < mid)
+                to[k++] = from[a++];
+            while (b < hi)
+                to[k++] = from[b++];
+        }
+        T *tmp = from;
+        from = to;
+        to = tmp;
+    }
+    // Result must end up in the input range
+    if (from != begin)
+        for (Size i = 0; i < count; i++)
+            begin[i] = from[i];
+}
+
+/**
+ * Sort a range by merge sort with a temporary buffer.
+ *
+ * @param begin First item.
+ * @param end Past the last item.
+ *
+ * @return True on success, false if out of memory.
+ */
+template <class T> bool mergeSort(T *begin, T *end)
+{
+    T *scratch;
+
+    if (end - begin <= SORT_INSERTION_MAX)
+    {
+        insertionSort(begin, end);
+        return true;
+    }
+    if (!(scratch = new T[end - begin]))
+        return false;
+
+    mergeSort(begin, end, scratch);
+    delete[] scratch;
+    return true;
+}
+
+/**
+ * Find an item in a sorted range by binary search.
+ *
+ * @param begin First item.
+ * @param end Past the last item.
+ * @param item Item to find.
+ *
+ * @return Position of the first item which equals the given item, or -1 if not found.
+ */
+template <class T> int binarySearch(const T *begin, const T *end, const T & item)
+{
+    const T *lo = begin, *hi = end;
+
+    // Find the first item which is not smaller
+    while (lo < hi)
+    {
+        const T *mid = lo + ((hi - lo) / 2);
+
+        if (*mid < item)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo != end && !(item < *lo))
+        return (int) (lo - begin);
+
+    return -1;
+}
+
+/**
+ * Sort a Vector by introsort.
+ *
+ * @param vec Vector to sort.
+ */
+template <class T> void introSort(Vector<T> & vec)
+{
+    introSort(vec.begin(), vec.end());
+}
+
+/**
+ * Sort an Array by introsort.
+ *
+ * @param array Array to sort.
+ */
+template <class T, Size N> void introSort(Array<T, N> & array)
+{
+    introSort(array.begin(), array.end());
+}
+
+/**
+ * Sort a Vector by merge sort.
+ *
+ * @param vec Vector to sort.
+ *
+ * @return True on success, false if out of memory.
+ */
+template <class T> bool mergeSort(Vector<T> & vec)
+{
+    return mergeSort(vec.begin(), vec.end());
+}
+
+/**
+ * Sort an Array by merge sort.
+ *
+ * @param array Array to sort.
+ *
+ * @return True on success, false if out of memory.
+ */
+template <class T, Size N> bool mergeSort(Array<T, N> & array)
+{
+    return mergeSort(array.begin(), array.end());
+}
+
+/**
+ * Find an item in a sorted Vector by binary search.
+ *
+ * @param vec Sorted Vector.
+ * @param item Item to find.
+ *
+ * @return Position of the item or -1 if not found.
+ */
+template <class T> int binarySearch(const Vector<T> & vec, const T & item)
+{
+    return binarySearch(vec.begin(), vec.end(), item);
+}
+
+/**
+ * Find an item in a sorted Array by binary search.
+ *
+ * @param array Sorted Array.
+ * @param item Item to find.
+ *
+ * @return Position of the item or -1 if not found.
+ */
+template <class T, Size N> int binarySearch(const Array<T, N> & array, const T & item)
+{
+    return binarySearch(array.begin(), array.end(), item);
+}
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_SORT_H */
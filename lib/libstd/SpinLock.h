@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBSTD_SPINLOCK_H
+#define __LIBSTD_SPINLOCK_H
+
+#include "Types.h"
+#include "Macros.h"
+#include "Atomic.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/**
+ * Mutual exclusion lock which busy-waits until the lock is free.
+ *
+ * While the lock is taken, waiters only read the lock word. This keeps the
+ * cache line shared between the waiting cores until the owner releases it.
+ * Use a TicketLock if waiters must acquire the lock in order of arrival.
+ */
+class SpinLock
+{
+  public:
+
+    /**
+     * Constructor.
+     */
+    SpinLock()
+        : m_locked(0)
+    {
+    }
+
+    /**
+     * Acquire the lock.
+     *
+     * Busy-waits until the lock is free.
+     */
+    void lock()
+    {
+        while (!m_locked.compareAndSwap(0, 1))
+        {
+            while (m_locked.load())
+                ;
+        }
+    }
+
+    /**
+     * Try to acquire the lock.
+     *
+     * @return True if acquired, false if the lock is taken.
+     */
+    bool tryLock()
+    {
+        return m_locked.compareAndSwap(0, 1);
+    }
+
+    /**
+     * Release the lock.
+     */
+    void unlock()
+    {
+        m_locked.store(0);
+    }
+
+    /**
+     * Check if the lock is taken.
+     *
+     * @return True if taken, false otherwise.
+     */
+    bool isLocked() const
+    {
+        return m_locked.load() != 0;
+    }
+
+  private:
+
+    /** One if taken, zero if free. */
+    Atomic<u32> m_locked;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_SPINLOCK_H */
@@ -39,6 +39,24 @@ String::String(const String & str)
     MemoryBlock::copy(m_string, str.m_string, m_count + 1);
 }
 
+String::String(String && str)
+{
+    m_size      = str.m_size;
+    m_count     = str.m_count;
+    m_base      = str.m_base;
+
+    // Borrowed buffers may not outlive the String, so copy those
+    if (str.m_allocated)
+        m_string = str.m_string;
+    else
+    {
+        m_string = new char[m_size];
+        MemoryBlock::copy(m_string, str.m_string, m_count + 1);
+    }
+    m_allocated = true;
+    str.release();
+}
+
 String::String(char *str, bool copy)
 {
     m_count     = length(str);
@@ -629,6 +647,34 @@ void String::operator = (const String & str)
     }
 }
 
+void String::operator = (String && str)
+{
+    if (this == &str)
+        return;
+
+    if (!str.m_allocated)
+    {
+        *this = (const String &) str;
+        return;
+    }
+    if (m_allocated)
+        delete[] m_string;
+
+    m_string    = str.m_string;
+    m_size      = str.m_size;
+    m_count     = str.m_count;
+    m_allocated = true;
+    str.release();
+}
+
+void String::release()
+{
+    m_string    = (char *) "";
+    m_size      = 1;
+    m_count     = 0;
+    m_allocated = false;
+}
+
 bool String::operator == (const String & str) const
 {
     return compareTo(str, true) == 0;
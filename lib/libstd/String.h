@@ -59,6 +59,16 @@ class String : public Sequence<char>
      */
     String(const String & str);
 
+    /**
+     * Move constructor.
+     *
+     * Takes over the buffer if the given String owns it, and copies
+     * it otherwise. The given String is left empty.
+     *
+     * @param s String reference.
+     */
+    String(String && str);
+
     /**
      * Constructor.
      *
@@ -382,6 +392,15 @@ class String : public Sequence<char>
      */
     void operator = (const String & str);
 
+    /**
+     * Move assignment operator.
+     *
+     * @param str Input string
+     *
+     * @see String(String &&)
+     */
+    void operator = (String && str);
+
     /**
      * Comparision operator.
      *
@@ -436,6 +455,15 @@ class String : public Sequence<char>
      */
     String & operator << (Number::Base format);
 
+  private:
+
+    /**
+     * Forget the buffer after it was moved to another String.
+     *
+     * Leaves an empty String which does not own a buffer.
+     */
+    void release();
+
   private:
 
     /** Current value of the String. */
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBSTD_TICKETLOCK_H
+#define __LIBSTD_TICKETLOCK_H
+
+#include "Types.h"
+#include "Macros.h"
+#include "Atomic.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libstd
+ * @{
+ */
+
+/**
+ * Fair mutual exclusion lock.
+ *
+ * Each caller of lock() draws a ticket and busy-waits until its ticket
+ * is served. Waiters acquire the lock in order of arrival, such that no
+ * core can starve while others repeatedly take the lock.
+ */
+class TicketLock
+{
+  public:
+
+    /**
+     * Constructor.
+     */
+    TicketLock()
+        : m_next(0), m_serving(0)
+    {
+    }
+
+    /**
+     * Acquire the lock.
+     *
+     * Busy-waits until all earlier tickets are served.
+     */
+    void lock()
+    {
+        u32 ticket = m_next.add(1) - 1;
+
+        while (m_serving.load() != ticket)
+            ;
+    }
+
+    /**
+     * Try to acquire the lock.
+     *
+     * @return True if acquired, false if the lock is taken or contended.
+     */
+    bool tryLock()
+    {
+        u32 ticket = m_serving.load();
+
+        return m_next.compareAndSwap(ticket, ticket + 1);
+    }
+
+    /**
+     * Release the lock.
+     *
+     * Serves the next ticket. Must only be called by the owner.
+     */
+    void unlock()
+    {
+        m_serving.store(m_serving.load() + 1);
+    }
+
+    /**
+     * Check if the lock is taken.
+     *
+     * @return True if taken, false otherwise.
+     */
+    bool isLocked() const
+    {
+        return m_next.load() != m_serving.load();
+    }
+
+  private:
+
+    /** Next ticket to hand out. */
+    Atomic<u32> m_next;
+
+    /** Ticket which currently owns the lock. */
+    Atomic<u32> m_serving;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBSTD_TICKETLOCK_H */
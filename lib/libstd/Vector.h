@@ -23,6 +23,7 @@
 #include "Types.h"
 #include "Macros.h"
 #include "MemoryBlock.h"
+#include "Move.h"
 
 /**
  * @addtogroup lib
@@ -37,8 +38,11 @@
 
 /**
  * Vectors are dynamically resizeable Arrays.
+ *
+ * The class is final, so the compiler can resolve virtual calls
+ * on a Vector object or reference at compile time.
  */
-template <class T> class Vector : public Sequence<T>
+template <class T> class Vector final : public Sequence<T>
 {
   public:
 
@@ -65,16 +69,33 @@ template <class T> class Vector : public Sequence<T>
      */
     Vector(const Vector<T> & a)
     {
-        assert(a.m_size > 0);
-
-        m_size  = a.m_size;
+        // A moved-from Vector has no storage
+        m_size  = a.m_size ? a.m_size : VECTOR_DEFAULT_SIZE;
         m_count = a.m_count;
         m_array = new T[m_size];
 
-        for (Size i = 0; i < m_size; i++)
+        for (Size i = 0; i < m_count; i++)
             m_array[i] = a.m_array[i];
     }
 
+    /**
+     * Move constructor.
+     *
+     * Takes over the items of the given Vector without copying them.
+     * The given Vector is left empty and grows again on the next insert.
+     *
+     * @param a Vector reference to move from.
+     */
+    Vector(Vector<T> && a)
+        : m_array(a.m_array)
+        , m_size(a.m_size)
+        , m_count(a.m_count)
+    {
+        a.m_array = ZERO;
+        a.m_size  = 0;
+        a.m_count = 0;
+    }
+
     /**
      * Destructor.
      */
@@ -83,6 +104,52 @@ template <class T> class Vector : public Sequence<T>
         delete[] m_array;
     }
 
+    /**
+     * Copy assignment operator.
+     *
+     * @param a Vector reference to copy from.
+     *
+     * @return Reference to this Vector.
+     */
+    Vector<T> & operator = (const Vector<T> & a)
+    {
+        if (this != &a)
+        {
+            T *arr = new T[a.m_size ? a.m_size : VECTOR_DEFAULT_SIZE];
+
+            for (Size i = 0; i < a.m_count; i++)
+                arr[i] = a.m_array[i];
+
+            delete[] m_array;
+            m_array = arr;
+            m_size  = a.m_size ? a.m_size : VECTOR_DEFAULT_SIZE;
+            m_count = a.m_count;
+        }
+        return *this;
+    }
+
+    /**
+     * Move assignment operator.
+     *
+     * @param a Vector reference to move from.
+     *
+     * @return Reference to this Vector.
+     */
+    Vector<T> & operator = (Vector<T> && a)
+    {
+        if (this != &a)
+        {
+            delete[] m_array;
+            m_array   = a.m_array;
+            m_size    = a.m_size;
+            m_count   = a.m_count;
+            a.m_array = ZERO;
+            a.m_size  = 0;
+            a.m_count = 0;
+        }
+        return *this;
+    }
+
     /**
      * Adds the given item to the Vector, if possible.
      *
@@ -93,13 +160,50 @@ template <class T> class Vector : public Sequence<T>
     virtual int insert(const T & item)
     {
         if (m_count == m_size)
-            if (!resize(m_size * 2))  // 扩展方案：加倍
+            if (!grow())  // 扩展方案：加倍
                 return -1;
 
         m_array[m_count++] = item;
         return m_count-1;
     }
 
+    /**
+     * Adds the given item to the Vector by moving it.
+     *
+     * @param item The item to move into the Vector.
+     *
+     * @return Position of the item in the Vector or -1 on failure.
+     */
+    int insert(T && item)
+    {
+        if (m_count == m_size)
+            if (!grow())
+                return -1;
+
+        m_array[m_count++] = move(item);
+        return m_count-1;
+    }
+
+    /**
+     * Construct an item from the given arguments at the end of the Vector.
+     *
+     * The storage of a Vector always holds constructed items, so the new
+     * item is moved into the free slot rather than built inside it.
+     *
+     * @param args Arguments for the constructor of T.
+     *
+     * @return Position of the item in the Vector or -1 on failure.
+     */
+    template <class... Args> int emplace(Args &&... args)
+    {
+        if (m_count == m_size)
+            if (!grow())
+                return -1;
+
+        m_array[m_count++] = T(forward<Args>(args)...);
+        return m_count-1;
+    }
+
     /**
      * Inserts the given item at the given position.
      *
@@ -216,6 +320,100 @@ template <class T> class Vector : public Sequence<T>
         return m_array;
     }
 
+    /**
+     * Returns the item at the given position in the Vector.
+     *
+     * Unlike at() this does not go through the virtual function table,
+     * so loops over a Vector can be inlined by the compiler.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    const T & operator [] (int i) const
+    {
+        return m_array[i];
+    }
+
+    /**
+     * Returns the item at the given position in the Vector.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    const T & operator [] (Size i) const
+    {
+        return m_array[i];
+    }
+
+    /**
+     * Returns the item at the given position in the Vector.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    T & operator [] (int i)
+    {
+        return m_array[i];
+    }
+
+    /**
+     * Returns the item at the given position in the Vector.
+     *
+     * @param i The index of the item to return.
+     *
+     * @return the Item at position i.
+     */
+    T & operator [] (Size i)
+    {
+        return m_array[i];
+    }
+
+    /**
+     * Get a pointer to the first item.
+     *
+     * Together with end() allows iterating over the items with a
+     * plain pointer instead of virtual get() or at() calls.
+     *
+     * @return Pointer to the first item.
+     */
+    T * begin()
+    {
+        return m_array;
+    }
+
+    /**
+     * Get a pointer past the last item.
+     *
+     * @return Pointer past the last item.
+     */
+    T * end()
+    {
+        return m_array + m_count;
+    }
+
+    /**
+     * Get a pointer to the first item.
+     *
+     * @return Pointer to the first item.
+     */
+    const T * begin() const
+    {
+        return m_array;
+    }
+
+    /**
+     * Get a pointer past the last item.
+     *
+     * @return Pointer past the last item.
+     */
+    const T * end() const
+    {
+        return m_array + m_count;
+    }
+
     /**
      * Resize the Vector.
      *
@@ -229,10 +427,13 @@ template <class T> class Vector : public Sequence<T>
         if (!arr)
             return false;
 
-        // Copy the old array in the new one
-        for (Size i = 0; i < m_size; i++)
+        // Move the items from the old array in the new one
+        if (m_count > size)
+            m_count = size;
+
+        for (Size i = 0; i < m_count; i++)
         {
-            arr[i] = m_array[i];
+            arr[i] = move(m_array[i]);
         }
         // Clean up the old array and set the new one
         delete[] m_array;
@@ -241,6 +442,18 @@ template <class T> class Vector : public Sequence<T>
         return true;
     }
 
+  private:
+
+    /**
+     * Double the size of the Vector.
+     *
+     * @return True on success, false if out of memory.
+     */
+    bool grow()
+    {
+        return resize(m_size ? m_size * 2 : VECTOR_DEFAULT_SIZE);
+    }
+
   private:
 
     /** The actual array where the data is stored. */
@@ -87,7 +87,7 @@ void CoreServer::createProcess(FileSystemMessage *msg)
 
     if (m_info.coreId == 0)
     {
-        MemoryChannel *ch = (MemoryChannel *) m_toSlave->get(msg->size);
+        MemoryChannel *ch = m_toSlave ? (MemoryChannel *) m_toSlave->get(msg->size) : ZERO;
 
         if (!ch)
         {
@@ -159,7 +159,7 @@ void CoreServer::getCoreCount(FileSystemMessage *msg)
         if (m_cores)
             msg->size = m_cores->getCores().count();
         else
-            msg->size = 1;
+            msg->size = m_info.coreCount;
 #else
         msg->size = 1;
 #endif
@@ -184,7 +184,7 @@ CoreServer::Result CoreServer::test()
     else
     {
         FileSystemMessage msg;
-        Size numCores = m_cores->getCores().count();
+        Size numCores = m_cores ? m_cores->getCores().count() : 1;
 
         for (Size i = 1; i < numCores; i++)
         {
@@ -209,21 +209,36 @@ CoreServer::Result CoreServer::test()
 CoreServer::Result CoreServer::initialize()
 {
     Result r;
+    Memory::Range range;
 
     // Only core0 needs to start other coreservers
     if (m_info.coreId != 0)
-        return setupChannels();
-
-    if ((r = loadKernel()) != Success)
-        return r;
+    {
+        if ((r = setupChannels()) != Success)
+            return r;
+    }
+    // The kernel itself already runs on all cores
+    else if (m_info.coreCount == 1)
+    {
+        if ((r = loadKernel()) != Success)
+            return r;
 
-    if ((r = discover()) != Success)
-        return r;
+        if ((r = discover()) != Success)
+            return r;
 
-    if ((r = setupChannels()) != Success)
-        return r;
+        if ((r = setupChannels()) != Success)
+            return r;
 
-    return bootAll();
+        if ((r = bootAll()) != Success)
+            return r;
+    }
+    // The boot image is no longer copied, release pages copied-on-write
+    if (VMCtl(SELF, ReclaimBootImage, &range) != API::Success)
+    {
+        ERROR("failed to reclaim boot image memory");
+        return IOError;
+    }
+    return Success;
 }
 
 CoreServer::Result CoreServer::loadKernel()
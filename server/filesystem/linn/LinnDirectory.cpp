@@ -28,7 +28,7 @@ LinnDirectory::LinnDirectory(LinnFileSystem *f,
     m_access = inode->mode;
 }
 
-Error LinnDirectory::read(IOBuffer & buffer, Size size, Size offset)
+Error LinnDirectory::readEntries(IOBuffer & buffer, Size size, Size *cookie)
 {
     LinnSuperBlock *sb = fs->getSuperBlock();
     LinnDirectoryEntry dent;
@@ -37,30 +37,29 @@ Error LinnDirectory::read(IOBuffer & buffer, Size size, Size offset)
     Error e;
     Dirent tmp;
 
-    // Read directory entries
-    for (u32 ent = 0; ent < inode->size / sizeof(LinnDirectoryEntry); ent++)
+    // Read directory entries, starting at the cookie
+    for (u32 ent = *cookie; ent < inode->size / sizeof(LinnDirectoryEntry); ent++)
     {
         // Point to correct (direct) block
-        if ((blk = (ent * sizeof(LinnDirectoryEntry)) / sb->blockSize)
-             >= LINN_INODE_DIR_BLOCKS)
+        if ((blk = ent / LINN_DIRENT_PER_BLOCK(sb)) >= LINN_INODE_DIR_BLOCKS)
         {
             break;
         }
         // Calculate offset to read.
         u64 off = (inode->block[blk] * sb->blockSize) +
-                      (ent * sizeof(LinnDirectoryEntry));
+                  ((ent % LINN_DIRENT_PER_BLOCK(sb)) * sizeof(LinnDirectoryEntry));
 
+        // Can we read another entry?
+        if (bytes + sizeof(Dirent) > size)
+        {
+            break;
+        }
         // Get the next entry.
         if (fs->getStorage()->read(off, &dent,
                                    sizeof(LinnDirectoryEntry)) < 0)
         {
             return EACCES;
         }
-        // Can we read another entry?
-        if (bytes + sizeof(Dirent) > size)
-        {
-            return EFAULT;
-        }
         // Fill in the Dirent.
         if (!(dInode = fs->getInode(dent.inode)))
         {
@@ -75,6 +74,7 @@ Error LinnDirectory::read(IOBuffer & buffer, Size size, Size offset)
             return e;
         }
         bytes += sizeof(Dirent);
+        (*cookie)++;
     }
     // All done.
     return bytes;
@@ -58,17 +58,20 @@ class LinnDirectory : public Directory
     LinnDirectory(LinnFileSystem *fs, LinnInode *inode);
 
     /**
-     * @brief Read directory entries.
+     * @brief Read a batch of directory entries.
+     *
+     * The cookie is the index of the next LinnDirectoryEntry,
+     * which allows to seek directly to its block on Storage.
      *
      * @param buffer Input/Output buffer to write bytes to.
      * @param size Number of bytes to copy at maximum.
-     * @param offset Offset in the file to start reading.
+     * @param cookie Resume position on input, next position on output.
      *
      * @return Number of bytes read on success, Error on failure.
      *
      * @see IOBuffer
      */
-    virtual Error read(IOBuffer & buffer, Size size, Size offset);
+    virtual Error readEntries(IOBuffer & buffer, Size size, Size *cookie);
 
     /**
      * @brief Retrieves a File pointer for the given entry name.
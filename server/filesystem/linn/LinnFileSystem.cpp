@@ -60,6 +60,11 @@ int main(int argc, char **argv)
     if (storage)
     {
         LinnFileSystem server(path, storage);
+
+        // Reads from the boot image need no IPC, so they can run on every core
+        if (argc <= 3 && info.coreCount > 1)
+            server.startWorkers(info.coreCount);
+
         server.mount();
         return server.run();
     }
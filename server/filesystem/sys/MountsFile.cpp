@@ -15,14 +15,21 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <FreeNOS/System.h>
 #include <FileSystemMount.h>
+#include <MemoryBlock.h>
+#include <Atomic.h>
 #include <Runtime.h>
 #include "MountsFile.h"
 
 MountsFile::MountsFile() : File(RegularFile)
 {
+    Arch::MemoryMap map;
+
     m_access = OwnerRW;
     m_size = sizeof(FileSystemMount) * FILESYSTEM_MAXMOUNTS;
+    m_table = (FileSystemMountTable *) map.range(MemoryMap::UserMounts).virt;
+    publish();
 }
 
 MountsFile::~MountsFile()
@@ -62,6 +69,7 @@ Error MountsFile::write(IOBuffer & buffer, Size size, Size offset)
         {
             memcpy((void *)&mounts[i], &fs, sizeof(fs));
             NOTICE("mounted " << mounts[i].path);
+            publish();
             return size;
         }
     }
@@ -69,3 +77,13 @@ Error MountsFile::write(IOBuffer & buffer, Size size, Size offset)
     // Mounts table is full
     return ENOBUFS;
 }
+
+void MountsFile::publish()
+{
+    // Readers retry while the generation is odd
+    m_table->generation++;
+    Atomic<u32>::fence();
+    MemoryBlock::copy((void *) m_table->mounts, getMounts(), sizeof(m_table->mounts));
+    Atomic<u32>::fence();
+    m_table->generation++;
+}
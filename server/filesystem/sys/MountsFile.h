@@ -19,6 +19,7 @@
 #define __LIB_LIBFS_MOUNTSFILE_H
 
 #include <File.h>
+#include <FileSystemMount.h>
 
 /**
  * @addtogroup server
@@ -33,6 +34,8 @@
  *
  * To retrieve the currently mounted filesystems, a process simply reads this entire file.
  * To mount a new file system, a process writes a new 'FileSystemMount' structure to this file.
+ * The table is also published in the MemoryMap::UserMounts page, which every process maps
+ * read-only. Processes only need to copy the table when its generation changed.
  *
  * @see FileSystem
  */
@@ -71,6 +74,16 @@ class MountsFile : public File
      * @return Number of bytes written on success, Error on failure.
      */
     virtual Error write(IOBuffer & buffer, Size size, Size offset);
+
+  private:
+
+    /**
+     * Publish the mounts table in the shared mounts page.
+     */
+    void publish();
+
+    /** Shared mounts page. */
+    FileSystemMountTable *m_table;
 };
 
 /**
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2019 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include "ProcessesFile.h"
+
+ProcessesFile::ProcessesFile() : File(RegularFile)
+{
+    m_access = OwnerR;
+    m_table  = new ProcessInfo[MAX_PROCS];
+}
+
+ProcessesFile::~ProcessesFile()
+{
+    delete[] m_table;
+}
+
+Error ProcessesFile::read(IOBuffer & buffer, Size size, Size offset)
+{
+    // Take a new snapshot when reading from the start
+    if (offset == 0)
+        m_size = ProcessCtl(SELF, InfoTable, (Address) m_table, MAX_PROCS) * sizeof(ProcessInfo);
+
+    if (offset >= m_size)
+        return 0;
+
+    if (size > m_size - offset)
+        size = m_size - offset;
+
+    return buffer.write(((u8 *) m_table) + offset, size);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2019 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FILESYSTEM_SYS_PROCESSESFILE_H
+#define __FILESYSTEM_SYS_PROCESSESFILE_H
+
+#include <FreeNOS/System.h>
+#include <File.h>
+
+/**
+ * @addtogroup server
+ * @{
+ *
+ * @addtogroup sysfs
+ * @{
+ */
+
+/**
+ * The processes file exports a snapshot of the kernel process table.
+ *
+ * The file contains one ProcessInfo structure for each existing process.
+ * A new snapshot is taken with a single ProcessCtl(InfoTable) call
+ * each time the file is read from the start. The structures are ordered
+ * by process table slot, which is not the order of the ProcessIDs once
+ * the ProcessIDs wrapped around.
+ */
+class ProcessesFile : public File
+{
+  public:
+
+    /**
+     * Constructor function.
+     */
+    ProcessesFile();
+
+    /**
+     * Destructor function.
+     */
+    virtual ~ProcessesFile();
+
+    /**
+     * @brief Read bytes from the file.
+     *
+     * @param buffer Input/Output buffer to output bytes to.
+     * @param size Number of bytes to read, at maximum.
+     * @param offset Offset inside the file to start reading.
+     *
+     * @return Number of bytes read on success, Error on failure.
+     */
+    virtual Error read(IOBuffer & buffer, Size size, Size offset);
+
+  private:
+
+    /** Last snapshot of the process table. */
+    ProcessInfo *m_table;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __FILESYSTEM_SYS_PROCESSESFILE_H */
@@ -37,6 +37,10 @@ int main(int argc, char **argv)
 
     TmpFileSystem server(path);
 
+    // Files are kept in memory, so reads can run on every core
+    if (info.coreCount > 1)
+        server.startWorkers(info.coreCount);
+
     // Mount, then start serving requests.
     server.mount();
     return server.run();
@@ -21,8 +21,10 @@ int main(int argc, char **argv)
 {
     PrivExec(Idle);
 
+    // Clear free pages for the zero pool until there are none left
     while (true)
     {
-        idle();
+        if (!PrivExec(ZeroPages))
+            idle();
     }
 }
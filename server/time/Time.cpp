@@ -32,12 +32,15 @@ Time::Time()
 
 Error Time::initialize()
 {
+    // Publish the current time in the kernel clock page
+    if (ProcessCtl(SELF, SetTime, readTime()) != API::Success)
+        return EIO;
+
     return ESUCCESS;
 }
 
 Error Time::read(IOBuffer & buffer, Size size, Size offset)
 {
-    unsigned int year, month, day, hour, min, sec = 0, time;
     char tmp[16];
     int n;
 
@@ -47,6 +50,18 @@ Error Time::read(IOBuffer & buffer, Size size, Size offset)
         return 0;
     }
 
+    // Format as an ASCII string
+    n = snprintf(tmp, size < sizeof(tmp) ? size : sizeof(tmp), "%u", readTime());
+    buffer.write(tmp, n);
+
+    // Done
+    return (Error) size;
+}
+
+unsigned long Time::readTime()
+{
+    unsigned int year, month, day, hour, min, sec = 0;
+
     // If UIP is clear, then we have >= 244 microseconds before
     // RTC registers will be updated.  Spec sheet says that this
     // is the reliable way to read RTC - registers. If UIP is set
@@ -79,13 +94,7 @@ Error Time::read(IOBuffer & buffer, Size size, Size offset)
         year += CMOS_YEARS_OFFS;
     }
 
-    // Format as an ASCII string
-    time = mktime(year, month, day, hour, min, sec);
-    n = snprintf(tmp, size < sizeof(tmp) ? size : sizeof(tmp), "%u", time);
-    buffer.write(tmp, n);
-
-    // Done
-    return (Error) size;
+    return mktime(year, month, day, hour, min, sec);
 }
 
 unsigned char Time::readCMOS(unsigned char addr)
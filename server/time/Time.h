@@ -119,6 +119,13 @@ class Time : public Device
 
   private:
 
+    /**
+     * @brief Read the current time from the CMOS.
+     *
+     * @return Seconds since the epoch.
+     */
+    unsigned long readTime();
+
     /**
      * @brief Returns the value stored at the given address
      *        from the CMOS.
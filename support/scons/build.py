@@ -24,6 +24,10 @@ from autoconf import *
 rootfs_files = []
 Export('rootfs_files')
 
+""" Libraries contained in the shared libfreenos """
+freenos_libs = [ 'liballoc', 'libstd', 'libarch', 'libipc', 'libfs', 'libexec', 'libposix' ]
+Export('freenos_libs')
+
 def UseLibraries(env, libs = [], arch = None):
     """
     Prepares a given environment, by adding library dependencies.
@@ -54,9 +58,42 @@ def HostProgram(env, target, source):
     if env['ARCH'] == 'host':
 	env.Program(target, source)
 
+def BootPrograms(env):
+    """
+    Retrieve the programs in the boot image. These are loaded by the kernel
+    and are always statically linked.
+    """
+    programs = []
+    imgdesc = open('config/' + env['ARCH'] + '/' + env['SYSTEM'] + '/boot.imgdesc')
+
+    for line in imgdesc.readlines():
+	line = line.strip()
+	if len(line) > 0 and line[0] not in '#{}' and line.find('=') == -1:
+	    programs.append(os.path.normpath(env.subst('${BUILDROOT}') + os.sep + line))
+
+    imgdesc.close()
+    return programs
+
+def DynamicProgram(env, target, source):
+    """
+    Link a position independent program against the shared libfreenos.
+    """
+    libs = [ lib for lib in env.get('LIBS', []) if lib not in freenos_libs ]
+    flags = [ f for f in env['LINKFLAGS'] if f != '-static' ]
+
+    env.Program(target, source,
+		CCFLAGS   = env['CCFLAGS'] + env.get('CCUSER', []) + [ '-fPIE' ],
+		LIBS      = libs + [ 'libfreenos' ],
+		LIBPATH   = env.get('LIBPATH', []) + [ '#' + env['BUILDROOT'] + '/lib/libfreenos' ],
+		LINKFLAGS = flags + [ '-pie', '-Wl,-E', '-Wl,--no-dynamic-linker',
+				      '-Wl,--hash-style=sysv' ])
+
 def TargetProgram(env, target, source, install_dir = None):
     if env['ARCH'] != 'host':
-	env.Program(target, source)
+	if env.get('SHARED') and os.path.normpath(env.File(target).path) not in BootPrograms(env):
+	    DynamicProgram(env, target, source)
+	else:
+	    env.Program(target, source, CCFLAGS = env['CCFLAGS'] + env.get('CCUSER', []))
         if install_dir is not False:
 	    env.TargetInstall(target, install_dir)
 
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <MemoryBlock.h>
+#include <HashFunction.h>
+#include <FileSystemPath.h>
+
+TestCase(FileSystemPathParse)
+{
+    const char *str = "//usr/local//bin/ls/";
+    FileSystemPath path(str);
+
+    // Separators are skipped and components point into the input
+    testAssert(path.count() == 4);
+    testAssert(path.full() == str + 2);
+    testAssert(path.length() == 17);
+    testAssert(path.component(0) == str + 2);
+    testAssert(path.componentLength(0) == 3);
+    testAssert(path.component(1) == str + 6);
+    testAssert(path.componentLength(1) == 5);
+    testAssert(path.component(2) == str + 13);
+    testAssert(path.componentLength(2) == 3);
+    testAssert(path.component(3) == str + 17);
+    testAssert(path.componentLength(3) == 2);
+    return OK;
+}
+
+TestCase(FileSystemPathEmpty)
+{
+    FileSystemPath empty;
+    FileSystemPath root("///");
+
+    testAssert(empty.count() == 0);
+    testAssert(empty.length() == 0);
+    testAssert(empty.base() == ZERO);
+    testAssert(root.count() == 0);
+    testAssert(root.length() == 0);
+    testAssert(root.parent().count() == 0);
+    return OK;
+}
+
+TestCase(FileSystemPathParentBase)
+{
+    FileSystemPath path("/etc/init/rc.local");
+    FileSystemPath parent = path.parent();
+    FileSystemPath top = parent.parent();
+    char buf[PATHLEN];
+
+    testString(path.base(), "rc.local");
+    testAssert(parent.count() == 2);
+    testAssert(parent.length() == 8);
+    testAssert(parent.full() == path.full());
+    testAssert(parent.copy(1, buf, sizeof(buf)) == 4);
+    testString(buf, "init");
+    testAssert(top.count() == 1);
+    testAssert(top.length() == 3);
+    testAssert(top.parent().count() == 0);
+    return OK;
+}
+
+TestCase(FileSystemPathCopy)
+{
+    FileSystemPath path("/dev/serial0");
+    char buf[4];
+
+    // Copies are truncated and always terminated
+    testAssert(path.copy(0, buf, sizeof(buf)) == 3);
+    testString(buf, "dev");
+    testAssert(path.copy(1, buf, sizeof(buf)) == 3);
+    testString(buf, "ser");
+    testAssert(path.copy(1, buf, 0) == 0);
+    return OK;
+}
+
+TestCase(FileSystemPathHash)
+{
+    FileSystemPath path("/usr/bin/ls");
+    String usr("usr"), bin("bin"), ls("ls"), lsa("lsa");
+
+    // Components hash and compare like a String with the same contents
+    for (Size mod = 1; mod < 64; mod++)
+    {
+        testAssert(path.hash(0, mod) == hash(usr, mod));
+        testAssert(path.hash(1, mod) == hash(bin, mod));
+        testAssert(path.hash(2, mod) == hash(ls, mod));
+    }
+    testAssert(path.equals(0, usr));
+    testAssert(path.equals(2, ls));
+    testAssert(!path.equals(2, lsa));
+    testAssert(!path.equals(1, usr));
+    return OK;
+}
+
+TestCase(FileSystemPathLimit)
+{
+    char buf[PATH_COMPONENTS_MAX * 2 + 3];
+    FileSystemPath path;
+
+    // One component more than fits
+    for (Size i = 0; i < PATH_COMPONENTS_MAX + 1; i++)
+    {
+        buf[i * 2]     = '/';
+        buf[i * 2 + 1] = 'a';
+    }
+    buf[(PATH_COMPONENTS_MAX + 1) * 2] = ZERO;
+
+    testAssert(!path.parse(buf));
+    testAssert(path.parse(buf + 2));
+    testAssert(path.count() == PATH_COMPONENTS_MAX);
+    return OK;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <List.h>
+#include <String.h>
+#include <FileSystemPath.h>
+
+/** Number of paths parsed by the throughput test */
+#define PARSE_ROUNDS 1000000
+
+TestCase(FileSystemPathThroughput)
+{
+    const char *str = "/usr/share/doc/freenos/README";
+    Size components = 0;
+    clock_t start, viewTime, splitTime;
+
+    // Parse into component views
+    start = clock();
+    for (Size i = 0; i < PARSE_ROUNDS; i++)
+    {
+        FileSystemPath path(str);
+        components += path.count();
+    }
+    viewTime = clock() - start;
+    testAssert(components == PARSE_ROUNDS * 5);
+
+    // Split into Strings on the heap, for comparison
+    components = 0;
+    start = clock();
+    for (Size i = 0; i < PARSE_ROUNDS; i++)
+    {
+        String s(str + 1);
+        List<String> parts = s.split('/');
+        components += parts.count();
+    }
+    splitTime = clock() - start;
+    testAssert(components == PARSE_ROUNDS * 5);
+
+    fprintf(stderr, "# FileSystemPath::parse %u paths in %lu ms, String::split %lu ms\n",
+            PARSE_ROUNDS, (unsigned long) viewTime * 1000 / CLOCKS_PER_SEC,
+            (unsigned long) splitTime * 1000 / CLOCKS_PER_SEC);
+    return OK;
+}
@@ -22,6 +22,7 @@
 #include <TestMain.h>
 #include <HashTable.h>
 #include <HashIterator.h>
+#include <FastHashIterator.h>
 #include <List.h>
 
 TestCase(HashIteratorConstruct)
@@ -365,3 +366,55 @@ TestCase(HashIteratorReset)
     }
     return OK;
 }
+
+TestCase(FastHashIteratorCurrent)
+{
+    HashTable<int, int> h(16);
+    Size sum = 0, count = 0;
+
+    // An empty HashTable has nothing to iterate
+    FastHashIterator<int, int> empty(h);
+    testAssert(!empty.hasCurrent());
+
+    // Insert more items than buckets
+    for (int i = 0; i < 100; i++)
+        testAssert(h.insert(i, i * 2));
+
+    // Each item must be visited once
+    for (FastHashIterator<int, int> i(h); i.hasCurrent(); i++, count++)
+    {
+        testAssert(i.current() == i.key() * 2);
+        sum += i.key();
+    }
+    testAssert(count == 100);
+    testAssert(sum == (99 * 100) / 2);
+    return OK;
+}
+
+TestCase(FastHashIteratorInsert)
+{
+    HashTable<int, int> h(4);
+    Size count = 0;
+
+    h.insert(0, 0);
+
+    // Inserts while iterating must not resize the HashTable
+    for (FastHashIterator<int, int> i(h); i.hasCurrent(); i++, count++)
+    {
+        if (i.key() == 0)
+            for (int j = 1; j < 100; j++)
+                testAssert(h.insert(j, j));
+    }
+    testAssert(h.size() == 4);
+    testAssert(h.count() == 100);
+    testAssert(count >= 1 && count <= 100);
+
+    // The next insert grows the HashTable
+    testAssert(h.insert(100, 100));
+    testAssert(h.size() > 4);
+    testAssert(h.count() == 101);
+
+    for (int j = 0; j <= 100; j++)
+        testAssert(h.get(j) && *h.get(j) == j);
+    return OK;
+}
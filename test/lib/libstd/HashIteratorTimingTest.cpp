@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <HashTable.h>
+#include <HashIterator.h>
+#include <FastHashIterator.h>
+
+/** Number of items in the throughput test */
+#define ITERATE_ITEMS 256
+
+/** Number of passes over the items in the throughput test */
+#define ITERATE_ROUNDS 2000
+
+TestCase(FastHashIteratorThroughput)
+{
+    HashTable<int, int> h;
+    Size sum = 0, expect = 0;
+    clock_t start, slowTime, fastTime;
+
+    for (int i = 0; i < ITERATE_ITEMS; i++)
+    {
+        h.insert(i, i);
+        expect += i;
+    }
+
+    // Iterate via HashIterator
+    start = clock();
+    for (Size r = 0; r < ITERATE_ROUNDS; r++)
+        for (HashIterator<int, int> i(h); i.hasCurrent(); i++)
+            sum += i.current();
+    slowTime = clock() - start;
+    testAssert(sum == expect * ITERATE_ROUNDS);
+
+    // Iterate via FastHashIterator
+    sum = 0;
+    start = clock();
+    for (Size r = 0; r < ITERATE_ROUNDS; r++)
+        for (FastHashIterator<int, int> i(h); i.hasCurrent(); i++)
+            sum += i.current();
+    fastTime = clock() - start;
+    testAssert(sum == expect * ITERATE_ROUNDS);
+
+    fprintf(stderr, "# HashTable %u items x %u: HashIterator %lu us, FastHashIterator %lu us\n",
+            ITERATE_ITEMS, ITERATE_ROUNDS,
+            (unsigned long) slowTime * 1000000 / CLOCKS_PER_SEC,
+            (unsigned long) fastTime * 1000000 / CLOCKS_PER_SEC);
+    return OK;
+}
@@ -293,3 +293,37 @@ TestCase(HashTableIterate)
     }
     return OK;
 }
+
+TestCase(HashTableGrow)
+{
+    HashTable<int, int> h(4);
+    Size size = 4 * HASHTABLE_LOAD_FACTOR;
+
+    // Fill up to the load factor, which keeps the size
+    for (Size i = 0; i < size; i++)
+        testAssert(h.insert(i, i * 2));
+
+    testAssert(h.size() == 4);
+
+    // Inserting one more item doubles the bucket Lists
+    testAssert(h.insert(size, size * 2));
+    testAssert(h.size() == 8);
+    testAssert(h.count() == size + 1);
+
+    // Keep growing with many items
+    for (Size i = size + 1; i < 1000; i++)
+        testAssert(h.append(i, i * 2));
+
+    testAssert(h.count() == 1000);
+    testAssert(h.size() >= 1000 / HASHTABLE_LOAD_FACTOR);
+
+    // All items are found after rehashing
+    for (Size i = 0; i < 1000; i++)
+        testAssert(h.value(i, -1) == (int) i * 2);
+
+    // Inserting an existing key does not add an item
+    testAssert(h.insert(10, 1));
+    testAssert(h.count() == 1000);
+    testAssert(h[10] == 1);
+    return OK;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <pthread.h>
+#include <unistd.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <SpinLock.h>
+#include <TicketLock.h>
+
+/** Maximum number of threads in the contention tests */
+#define CONTENTION_THREADS 4
+
+/** Number of increments per thread in the contention tests */
+#define CONTENTION_ROUNDS 100000
+
+/** Counter protected by the lock under test */
+static volatile Size counter;
+
+static SpinLock spinLock;
+static TicketLock ticketLock;
+
+static void * spinIncrement(void *arg)
+{
+    for (Size i = 0; i < CONTENTION_ROUNDS; i++)
+    {
+        spinLock.lock();
+        counter = counter + 1;
+        spinLock.unlock();
+    }
+    return ZERO;
+}
+
+static void * ticketIncrement(void *arg)
+{
+    for (Size i = 0; i < CONTENTION_ROUNDS; i++)
+    {
+        ticketLock.lock();
+        counter = counter + 1;
+        ticketLock.unlock();
+    }
+    return ZERO;
+}
+
+static bool contend(void * (*func)(void *))
+{
+    pthread_t threads[CONTENTION_THREADS];
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    Size count = CONTENTION_THREADS;
+
+    // Busy-waiting threads only make progress with a core each
+    if (cpus > 0 && (Size) cpus < count)
+        count = cpus;
+
+    counter = 0;
+
+    for (Size i = 0; i < count; i++)
+        if (pthread_create(&threads[i], ZERO, func, ZERO) != 0)
+            return false;
+
+    for (Size i = 0; i < count; i++)
+        pthread_join(threads[i], ZERO);
+
+    return counter == count * CONTENTION_ROUNDS;
+}
+
+TestCase(SpinLockTryLock)
+{
+    SpinLock lock;
+
+    testAssert(!lock.isLocked());
+    testAssert(lock.tryLock());
+    testAssert(lock.isLocked());
+    testAssert(!lock.tryLock());
+    lock.unlock();
+    testAssert(!lock.isLocked());
+    lock.lock();
+    testAssert(!lock.tryLock());
+    lock.unlock();
+    return OK;
+}
+
+TestCase(TicketLockTryLock)
+{
+    TicketLock lock;
+
+    testAssert(!lock.isLocked());
+    testAssert(lock.tryLock());
+    testAssert(lock.isLocked());
+    testAssert(!lock.tryLock());
+    lock.unlock();
+    testAssert(!lock.isLocked());
+    lock.lock();
+    testAssert(!lock.tryLock());
+    lock.unlock();
+    testAssert(lock.tryLock());
+    lock.unlock();
+    return OK;
+}
+
+TestCase(SpinLockContention)
+{
+    testAssert(contend(spinIncrement));
+    return OK;
+}
+
+TestCase(TicketLockContention)
+{
+    testAssert(contend(ticketIncrement));
+    return OK;
+}
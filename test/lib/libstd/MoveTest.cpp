@@ -0,0 +1,332 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <Move.h>
+#include <Vector.h>
+#include <List.h>
+#include <Index.h>
+#include <HashTable.h>
+#include <String.h>
+
+/** Number of heap allocations done with new */
+static Size allocations = 0;
+
+/** Number of Tracked copies */
+static Size copies = 0;
+
+void * operator new(__SIZE_TYPE__ size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+void * operator new[](__SIZE_TYPE__ size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+void operator delete(void *ptr) throw()
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr) throw()
+{
+    free(ptr);
+}
+
+/**
+ * Item which owns heap memory and counts its copies.
+ */
+class Tracked
+{
+  public:
+
+    Tracked() : m_value(ZERO)
+    {
+    }
+
+    Tracked(int value) : m_value(new int(value))
+    {
+    }
+
+    Tracked(const Tracked & t) : m_value(t.m_value ? new int(*t.m_value) : ZERO)
+    {
+        copies++;
+    }
+
+    Tracked(Tracked && t) : m_value(t.m_value)
+    {
+        t.m_value = ZERO;
+    }
+
+    ~Tracked()
+    {
+        delete m_value;
+    }
+
+    Tracked & operator = (const Tracked & t)
+    {
+        if (this != &t)
+        {
+            delete m_value;
+            m_value = t.m_value ? new int(*t.m_value) : ZERO;
+            copies++;
+        }
+        return *this;
+    }
+
+    Tracked & operator = (Tracked && t)
+    {
+        if (this != &t)
+        {
+            delete m_value;
+            m_value = t.m_value;
+            t.m_value = ZERO;
+        }
+        return *this;
+    }
+
+    bool operator == (const Tracked & t) const
+    {
+        return value() == t.value();
+    }
+
+    bool operator != (const Tracked & t) const
+    {
+        return value() != t.value();
+    }
+
+    int value() const
+    {
+        return m_value ? *m_value : -1;
+    }
+
+  private:
+
+    int *m_value;
+};
+
+/**
+ * Reset the allocation and copy counters.
+ */
+static void resetCounters()
+{
+    allocations = 0;
+    copies = 0;
+}
+
+TestCase(VectorMoveResize)
+{
+    Vector<Tracked> vec(4);
+
+    for (int i = 0; i < 4; i++)
+        testAssert(vec.emplace(i) == i);
+
+    // Growing allocates the new array and moves the items into it
+    resetCounters();
+    testAssert(vec.emplace(4) == 4);
+    testAssert(allocations == 2);
+    testAssert(copies == 0);
+    testAssert(vec.size() == 8);
+
+    for (int i = 0; i < 5; i++)
+        testAssert(vec[i].value() == i);
+
+    // Inserting an rvalue moves it
+    Tracked t(5);
+    resetCounters();
+    testAssert(vec.insert(move(t)) == 5);
+    testAssert(allocations == 0);
+    testAssert(copies == 0);
+    testAssert(t.value() == -1);
+    return OK;
+}
+
+TestCase(VectorMoveConstruct)
+{
+    Vector<Tracked> a(8);
+
+    for (int i = 0; i < 8; i++)
+        a.emplace(i);
+
+    resetCounters();
+    Vector<Tracked> b(move(a));
+    testAssert(allocations == 0);
+    testAssert(copies == 0);
+    testAssert(b.count() == 8);
+    testAssert(b[7].value() == 7);
+    testAssert(a.count() == 0);
+
+    // A moved-from Vector can be used again
+    testAssert(a.emplace(1) == 0);
+    testAssert(a[0].value() == 1);
+
+    // Copy and move assignment
+    a = b;
+    testAssert(a.count() == 8);
+    testAssert(copies == 8);
+    testAssert(a[3].value() == 3 && b[3].value() == 3);
+
+    resetCounters();
+    a = move(b);
+    testAssert(allocations == 0);
+    testAssert(a.count() == 8);
+    testAssert(b.count() == 0);
+    return OK;
+}
+
+TestCase(ListEmplace)
+{
+    List<Tracked> lst;
+    Tracked t(2);
+
+    // Only the node and the item's own memory are allocated
+    resetCounters();
+    lst.emplace(1);
+    testAssert(allocations == 2);
+    testAssert(copies == 0);
+
+    // Appending an rvalue moves it into the node
+    resetCounters();
+    lst.append(move(t));
+    testAssert(allocations == 1);
+    testAssert(copies == 0);
+
+    // Appending an lvalue copies it once
+    Tracked u(3);
+    resetCounters();
+    lst.append(u);
+    testAssert(copies == 1);
+    testAssert(lst.count() == 3);
+    testAssert(lst.first().value() == 1);
+    testAssert(lst.last().value() == 3);
+    return OK;
+}
+
+TestCase(ListMove)
+{
+    List<Tracked> a, c;
+
+    for (int i = 0; i < 10; i++)
+        a.emplace(i);
+
+    resetCounters();
+    List<Tracked> b(move(a));
+    testAssert(allocations == 0);
+    testAssert(b.count() == 10);
+    testAssert(a.count() == 0);
+    testAssert(a.head() == ZERO);
+
+    // Copy assignment makes a deep copy
+    c = b;
+    testAssert(c.count() == 10);
+    testAssert(copies == 10);
+    testAssert(c.head() != b.head());
+
+    resetCounters();
+    a = move(c);
+    testAssert(allocations == 0);
+    testAssert(a.count() == 10);
+    testAssert(c.count() == 0);
+    return OK;
+}
+
+TestCase(HashTableMoveInsert)
+{
+    HashTable<String, Tracked> h;
+    String key("key", true);
+    Tracked value(7);
+
+    // Only the List node is allocated
+    resetCounters();
+    testAssert(h.insert(move(key), move(value)));
+    testAssert(allocations == 1);
+    testAssert(copies == 0);
+    testAssert(h.count() == 1);
+    testAssert(h["key"].value() == 7);
+
+    // Replacing the value of an existing key moves it too
+    Tracked other(8);
+    resetCounters();
+    testAssert(h.insert(String("key"), move(other)));
+    testAssert(copies == 0);
+    testAssert(h.count() == 1);
+    testAssert(h["key"].value() == 8);
+    return OK;
+}
+
+TestCase(StringMove)
+{
+    char buf[] = "borrowed";
+    String owned("owned", true);
+    String borrowed((const char *) buf);
+
+    // An owned buffer is taken over
+    resetCounters();
+    String a(move(owned));
+    testAssert(allocations == 0);
+    testAssert(a.equals("owned"));
+    testAssert(owned.length() == 0);
+
+    // A borrowed buffer is copied, such that it may go out of scope
+    String b(move(borrowed));
+    testAssert(allocations == 1);
+    testAssert(b.equals("borrowed"));
+    buf[0] = 'X';
+    testAssert(b.equals("borrowed"));
+
+    // A moved-from String can be reused
+    owned = "again";
+    testAssert(owned.equals("again"));
+
+    resetCounters();
+    owned = move(a);
+    testAssert(allocations == 0);
+    testAssert(owned.equals("owned"));
+    return OK;
+}
+
+TestCase(IndexMove)
+{
+    Index<int> a(16);
+    int items[4] = { 1, 2, 3, 4 };
+
+    for (Size i = 0; i < 4; i++)
+        a.insert(items[i]);
+
+    resetCounters();
+    Index<int> b(move(a));
+    testAssert(allocations == 0);
+    testAssert(b.count() == 4);
+    testAssert(b[2] == 3);
+    testAssert(a.count() == 0);
+    testAssert(a.get(0) == ZERO);
+
+    // Copies share the items, but not the slots
+    Index<int> c(b);
+    testAssert(c.count() == 4);
+    testAssert(c.get(1) == b.get(1));
+    c.remove((Size) 1);
+    testAssert(b.get(1) != ZERO);
+    return OK;
+}
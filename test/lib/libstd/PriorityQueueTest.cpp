@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <Vector.h>
+#include <PriorityQueue.h>
+
+TestCase(PriorityQueueOrder)
+{
+    PriorityQueue<int> queue(4);
+    TestInt<int> ints(INT_MIN, INT_MAX);
+    int item, prev = INT_MIN;
+
+    testAssert(queue.isEmpty());
+    testAssert(queue.top() == ZERO);
+    testAssert(!queue.pop(&item));
+
+    // Grows beyond the initial size
+    for (Size i = 0; i < 1000; i++)
+        testAssert(queue.push(ints.random()) >= 0);
+
+    testAssert(queue.count() == 1000);
+    testAssert(queue.size() >= 1000);
+
+    // Items come out smallest first
+    for (Size i = 0; i < 1000; i++)
+    {
+        testAssert(queue.pop(&item));
+        testAssert(item >= prev);
+        prev = item;
+    }
+    testAssert(queue.isEmpty());
+    return OK;
+}
+
+TestCase(PriorityQueueDary)
+{
+    PriorityQueue<Size, 4> queue;
+    Size item;
+
+    for (Size i = 0; i < 500; i++)
+        queue.push((i * 7919) % 500);
+
+    for (Size i = 0; i < 500; i++)
+    {
+        testAssert(queue.pop(&item));
+        testAssert(item == i);
+    }
+    return OK;
+}
+
+TestCase(PriorityQueueDecrease)
+{
+    PriorityQueue<int> queue;
+    int handles[100];
+    int item;
+
+    for (int i = 0; i < 100; i++)
+        testAssert((handles[i] = queue.push(1000 + i)) >= 0);
+
+    // Move the last item to the front
+    testAssert(queue.decrease(handles[99], 5));
+    testAssert(*queue.top() == 5);
+    testAssert(*queue.get(handles[99]) == 5);
+
+    // Increasing is not allowed
+    testAssert(!queue.decrease(handles[10], 2000));
+    testAssert(*queue.get(handles[10]) == 1010);
+
+    testAssert(queue.pop(&item));
+    testAssert(item == 5);
+
+    // Popped handles are not in use anymore
+    testAssert(queue.get(handles[99]) == ZERO);
+    testAssert(!queue.decrease(handles[99], 1));
+
+    // Decrease a few items and check the order
+    testAssert(queue.decrease(handles[50], 10));
+    testAssert(queue.decrease(handles[20], 20));
+    testAssert(queue.pop(&item) && item == 10);
+    testAssert(queue.pop(&item) && item == 20);
+    testAssert(queue.pop(&item) && item == 1000);
+    testAssert(queue.count() == 96);
+
+    queue.clear();
+    testAssert(queue.isEmpty());
+    testAssert(queue.get(handles[0]) == ZERO);
+    return OK;
+}
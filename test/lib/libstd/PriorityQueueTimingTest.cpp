@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <Vector.h>
+#include <PriorityQueue.h>
+
+/** Number of items in the throughput test */
+#define QUEUE_ITEMS 4096
+
+TestCase(PriorityQueueThroughput)
+{
+    PriorityQueue<Size> queue(QUEUE_ITEMS);
+    Vector<Size> naive(QUEUE_ITEMS);
+    Size item, naiveSum = 0, heapSum = 0;
+    clock_t start, naiveTime, heapTime;
+
+    // Naive: unsorted Vector, scan for the smallest item on each removal
+    start = clock();
+    for (Size i = 0; i < QUEUE_ITEMS; i++)
+        naive.insert((i * 7919) % QUEUE_ITEMS);
+
+    while (naive.count())
+    {
+        Size min = 0;
+
+        for (Size i = 1; i < naive.count(); i++)
+            if (naive[i] < naive[min])
+                min = i;
+
+        naiveSum += naive[min] * naive.count();
+        naive[min] = naive[naive.count() - 1];
+        naive.removeAt(naive.count() - 1);
+    }
+    naiveTime = clock() - start;
+
+    // Binary heap
+    start = clock();
+    for (Size i = 0; i < QUEUE_ITEMS; i++)
+        queue.push((i * 7919) % QUEUE_ITEMS);
+
+    while (queue.count())
+    {
+        Size count = queue.count();
+        queue.pop(&item);
+        heapSum += item * count;
+    }
+    heapTime = clock() - start;
+
+    // Both returned the items in the same order
+    testAssert(naiveSum == heapSum);
+
+    fprintf(stderr, "# PriorityQueue %u items: linear scan %lu us, heap %lu us\n",
+            QUEUE_ITEMS,
+            (unsigned long) naiveTime * 1000000 / CLOCKS_PER_SEC,
+            (unsigned long) heapTime * 1000000 / CLOCKS_PER_SEC);
+    return OK;
+}
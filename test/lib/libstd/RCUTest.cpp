@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <pthread.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <Atomic.h>
+#include <ConcurrentIndex.h>
+#include <RCU.h>
+
+/** Number of reader threads in the stress test */
+#define STRESS_READERS 4
+
+/** Number of writer operations in the stress test */
+#define STRESS_WRITES 200000
+
+/** Number of positions in the stress test index */
+#define STRESS_SIZE 64
+
+/** Marks a live test object */
+#define LIVE_MAGIC 0x12345678
+
+/**
+ * Object shared between the threads.
+ */
+struct Item
+{
+    volatile u32 magic;
+    Size position;
+};
+
+static void releaseItem(void *object)
+{
+    Item *item = (Item *) object;
+
+    // Poison the object, such that readers detect a use-after-free
+    item->magic = 0;
+    delete item;
+}
+
+static ConcurrentIndex<Item, STRESS_SIZE> stressIndex;
+static RCU *stressRCU;
+static Atomic<u32> stressDone;
+static Atomic<u32> stressErrors;
+
+static void * stressReader(void *arg)
+{
+    Size reader = (Address) arg;
+    Size position = reader;
+
+    while (!stressDone.load())
+    {
+        for (Size i = 0; i < 64; i++)
+        {
+            Item *item = stressIndex.get(position);
+            position = (position + 7) % STRESS_SIZE;
+
+            if (item && (item->magic != LIVE_MAGIC || item->position >= STRESS_SIZE))
+                stressErrors.add(1);
+        }
+        // No references are held here
+        stressRCU->quiescent(reader);
+    }
+    return ZERO;
+}
+
+TestCase(ConcurrentIndexInsertRemove)
+{
+    ConcurrentIndex<Item, 4> index;
+    Item a, b;
+
+    testAssert(index.size() == 4);
+    testAssert(index.get(0) == ZERO);
+    testAssert(index.get(4) == ZERO);
+
+    // Positions can only be used once
+    testAssert(index.insert(0, &a));
+    testAssert(!index.insert(0, &b));
+    testAssert(!index.insert(4, &b));
+    testAssert(index.get(0) == &a);
+
+    // Remove returns the unpublished item
+    testAssert(index.remove(0) == &a);
+    testAssert(index.remove(0) == ZERO);
+    testAssert(index.insert(0, &b));
+    testAssert(index.get(0) == &b);
+    return OK;
+}
+
+TestCase(RCUReclaim)
+{
+    RCU rcu(2);
+    Item *item = new Item;
+
+    item->magic = LIVE_MAGIC;
+    rcu.writeLock();
+    rcu.retire(item, releaseItem);
+
+    // Epoch cannot advance before all readers passed a quiescent state
+    testAssert(rcu.reclaim() == 0);
+    testAssert(rcu.getEpoch() == 1);
+    rcu.quiescent(0);
+    testAssert(rcu.reclaim() == 0);
+    testAssert(rcu.getEpoch() == 1);
+
+    // The object survives the first epoch change
+    rcu.quiescent(1);
+    testAssert(rcu.reclaim() == 0);
+    testAssert(rcu.getEpoch() == 2);
+
+    // And is released after the second
+    rcu.quiescent(0);
+    rcu.quiescent(1);
+    testAssert(rcu.reclaim() == 1);
+    testAssert(rcu.getEpoch() == 3);
+    rcu.writeUnlock();
+    return OK;
+}
+
+TestCase(RCUSetReaders)
+{
+    RCU rcu(1);
+    Item *item = new Item;
+
+    item->magic = LIVE_MAGIC;
+    rcu.writeLock();
+    rcu.retire(item, releaseItem);
+
+    // An added reader does not hold back the current epoch
+    rcu.setReaders(2);
+    rcu.quiescent(0);
+    testAssert(rcu.reclaim() == 0);
+    testAssert(rcu.getEpoch() == 2);
+
+    // But it must pass a quiescent state in the next epoch
+    rcu.quiescent(0);
+    testAssert(rcu.reclaim() == 0);
+    testAssert(rcu.getEpoch() == 2);
+    rcu.quiescent(1);
+    testAssert(rcu.reclaim() == 1);
+    testAssert(rcu.getEpoch() == 3);
+    rcu.writeUnlock();
+    return OK;
+}
+
+TestCase(RCUWriteLock)
+{
+    RCU rcu;
+
+    testAssert(rcu.tryWriteLock());
+    testAssert(!rcu.tryWriteLock());
+    rcu.writeUnlock();
+    testAssert(rcu.tryWriteLock());
+    rcu.writeUnlock();
+    return OK;
+}
+
+TestCase(RCUConcurrentStress)
+{
+    pthread_t readers[STRESS_READERS];
+    Size released = 0, seed = 1;
+
+    stressRCU = new RCU(STRESS_READERS);
+    stressDone.store(0);
+    stressErrors.store(0);
+
+    for (Size i = 0; i < STRESS_READERS; i++)
+        testAssert(pthread_create(&readers[i], ZERO, stressReader, (void *) (Address) i) == 0);
+
+    // Publish and unpublish items while the readers are running
+    for (Size i = 0; i < STRESS_WRITES; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        Size position = (seed >> 16) % STRESS_SIZE;
+
+        stressRCU->writeLock();
+
+        Item *item = stressIndex.remove(position);
+        if (item)
+            stressRCU->retire(item, releaseItem);
+        else
+        {
+            item = new Item;
+            item->magic    = LIVE_MAGIC;
+            item->position = position;
+            testAssert(stressIndex.insert(position, item));
+        }
+        released += stressRCU->reclaim();
+        stressRCU->writeUnlock();
+    }
+    stressDone.store(1);
+
+    for (Size i = 0; i < STRESS_READERS; i++)
+        pthread_join(readers[i], ZERO);
+
+    // Release the remaining items
+    for (Size i = 0; i < STRESS_SIZE; i++)
+    {
+        Item *item = stressIndex.remove(i);
+        if (item)
+            releaseItem(item);
+    }
+    delete stressRCU;
+
+    testAssert(stressErrors.load() == 0);
+    testAssert(released > 0);
+    return OK;
+}
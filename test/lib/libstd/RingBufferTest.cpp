@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <Index.h>
+#include <RingBuffer.h>
+#include <SPSCRingBuffer.h>
+
+/** Capacity of the RingBuffers under test */
+#define RING_SIZE 64
+
+/** Number of items passed between the threads in the SPSC test */
+#define TRANSFER_COUNT 200000
+
+/** Number of items queued in the throughput test */
+#define QUEUE_ROUNDS 1000000
+
+/** Queue shared by the producer and consumer threads */
+static SPSCRingBuffer<Size, RING_SIZE> spsc;
+
+static void * produce(void *arg)
+{
+    for (Size i = 1; i <= TRANSFER_COUNT; i++)
+        while (!spsc.push(i))
+            sched_yield();
+
+    return ZERO;
+}
+
+TestCase(RingBufferPushPop)
+{
+    RingBuffer<int, RING_SIZE> ring;
+    TestInt<int> ints(INT_MIN, INT_MAX);
+    int item;
+
+    testAssert(ring.isEmpty());
+    testAssert(!ring.pop(&item));
+    testAssert(ring.peek() == ZERO);
+
+    // Fill completely
+    for (Size i = 0; i < RING_SIZE; i++)
+        testAssert(ring.push(ints.random()));
+
+    testAssert(ring.isFull());
+    testAssert(ring.count() == RING_SIZE);
+    testAssert(!ring.push(0));
+    testAssert(*ring.peek() == ints[0]);
+
+    // Items come out in order
+    for (Size i = 0; i < RING_SIZE; i++)
+    {
+        testAssert(ring.pop(&item));
+        testAssert(item == ints[i]);
+    }
+    testAssert(ring.isEmpty());
+    return OK;
+}
+
+TestCase(RingBufferWrap)
+{
+    RingBuffer<Size, 8> ring;
+    Size next = 0, expect = 0, item;
+
+    // Keep the buffer partially filled while the indices wrap many times
+    for (Size round = 0; round < 1000; round++)
+    {
+        for (Size i = 0; i < (round % 8) + 1 && !ring.isFull(); i++)
+            testAssert(ring.push(next++));
+
+        for (Size i = 0; i < (round % 5) + 1 && ring.pop(&item); i++)
+            testAssert(item == expect++);
+    }
+    while (ring.pop(&item))
+        testAssert(item == expect++);
+
+    testAssert(expect == next);
+    ring.push(1);
+    ring.clear();
+    testAssert(ring.isEmpty());
+    return OK;
+}
+
+TestCase(SPSCRingBufferTransfer)
+{
+    pthread_t producer;
+    Size expect = 1, item;
+
+    testAssert(pthread_create(&producer, ZERO, produce, ZERO) == 0);
+
+    // Every item arrives once and in order
+    while (expect <= TRANSFER_COUNT)
+    {
+        if (spsc.pop(&item))
+        {
+            testAssert(item == expect);
+            expect++;
+        }
+        else
+            sched_yield();
+    }
+    pthread_join(producer, ZERO);
+    testAssert(spsc.count() == 0);
+    testAssert(spsc.peek() == ZERO);
+    return OK;
+}
+
+TestCase(RingBufferThroughput)
+{
+    RingBuffer<int *, RING_SIZE> ring;
+    Index<int> index(RING_SIZE);
+    int items[RING_SIZE / 2];
+    int *item;
+    Size indexSum = 0, ringSum = 0;
+    clock_t start, indexTime, ringTime;
+
+    for (Size i = 0; i < RING_SIZE / 2; i++)
+        items[i] = i;
+
+    // Keep half of the items queued while adding and removing one per round
+    for (Size i = 0; i < (RING_SIZE / 2) - 1; i++)
+    {
+        index.insert(items[i]);
+        ring.push(&items[i]);
+    }
+
+    // Queue via an Index, scanning for a used slot like NetworkQueue did
+    start = clock();
+    for (Size i = 0; i < QUEUE_ROUNDS; i++)
+    {
+        index.insert(items[(i + (RING_SIZE / 2) - 1) % (RING_SIZE / 2)]);
+
+        for (Size j = 0; j < index.size(); j++)
+        {
+            if ((item = (int *) index.get(j)) != ZERO)
+            {
+                indexSum += *item;
+                index.remove(j);
+                break;
+            }
+        }
+    }
+    indexTime = clock() - start;
+
+    // Queue via a RingBuffer
+    start = clock();
+    for (Size i = 0; i < QUEUE_ROUNDS; i++)
+    {
+        ring.push(&items[(i + (RING_SIZE / 2) - 1) % (RING_SIZE / 2)]);
+
+        if (ring.pop(&item))
+            ringSum += *item;
+    }
+    ringTime = clock() - start;
+
+    // Both queues removed one item per round
+    testAssert(index.count() == (RING_SIZE / 2) - 1);
+    testAssert(ring.count() == (RING_SIZE / 2) - 1);
+    testAssert(indexSum > 0 && ringSum > 0);
+
+    fprintf(stderr, "# Queue %u items: Index %lu us, RingBuffer %lu us\n",
+            QUEUE_ROUNDS,
+            (unsigned long) indexTime * 1000000 / CLOCKS_PER_SEC,
+            (unsigned long) ringTime * 1000000 / CLOCKS_PER_SEC);
+    return OK;
+}
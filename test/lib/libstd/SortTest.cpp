@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <Array.h>
+#include <Vector.h>
+#include <Sort.h>
+
+/**
+ * Item with a key to sort on and the original position.
+ */
+struct Pair
+{
+    int key;
+    Size position;
+
+    bool operator < (const Pair & p) const
+    {
+        return key < p.key;
+    }
+
+    bool operator == (const Pair & p) const
+    {
+        return key == p.key && position == p.position;
+    }
+
+    bool operator != (const Pair & p) const
+    {
+        return !(*this == p);
+    }
+};
+
+/**
+ * Check if a range is sorted.
+ */
+template <class T> static bool isSorted(const T *begin, const T *end)
+{
+    for (const T *i = begin; i + 1 < end; i++)
+        if (*(i + 1) < *i)
+            return false;
+
+    return true;
+}
+
+TestCase(IntroSortRandom)
+{
+    TestInt<int> ints(INT_MIN, INT_MAX);
+    Vector<int> vec;
+
+    for (Size i = 0; i < 5000; i++)
+        vec.insert(ints.random());
+
+    introSort(vec);
+    testAssert(vec.count() == 5000);
+    testAssert(isSorted(vec.begin(), vec.end()));
+    return OK;
+}
+
+TestCase(IntroSortPatterns)
+{
+    Vector<int> vec;
+
+    // Sorted, reversed, equal and sawtooth input
+    for (Size pattern = 0; pattern < 4; pattern++)
+    {
+        vec.clear();
+
+        for (int i = 0; i < 3000; i++)
+        {
+            switch (pattern)
+            {
+                case 0: vec.insert(i); break;
+                case 1: vec.insert(3000 - i); break;
+                case 2: vec.insert(7); break;
+                case 3: vec.insert(i % 17); break;
+            }
+        }
+        introSort(vec);
+        testAssert(isSorted(vec.begin(), vec.end()));
+    }
+
+    // Empty and tiny ranges
+    introSort(vec.begin(), vec.begin());
+    introSort(vec.begin(), vec.begin() + 1);
+    return OK;
+}
+
+TestCase(HeapSortRandom)
+{
+    TestInt<int> ints(INT_MIN, INT_MAX);
+    Array<int, 1000> array;
+
+    for (Size i = 0; i < 1000; i++)
+        array[i] = ints.random();
+
+    heapSort(array.begin(), array.end());
+    testAssert(isSorted(array.begin(), array.end()));
+    return OK;
+}
+
+TestCase(MergeSortStable)
+{
+    TestInt<int> ints(0, 50);
+    Array<Pair, 2000> array;
+
+    for (Size i = 0; i < 2000; i++)
+    {
+        array[i].key = ints.random();
+        array[i].position = i;
+    }
+    testAssert(mergeSort(array));
+    testAssert(isSorted(array.begin(), array.end()));
+
+    // Equal keys keep their order
+    for (Size i = 0; i + 1 < 2000; i++)
+        if (array[i].key == array[i + 1].key)
+            testAssert(array[i].position < array[i + 1].position);
+
+    return OK;
+}
+
+TestCase(BinarySearch)
+{
+    Vector<int> vec;
+
+    testAssert(binarySearch(vec, 1) == -1);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        vec.insert(i * 2);
+        vec.insert(i * 2);
+    }
+
+    // Finds the first of equal items
+    for (int i = 0; i < 1000; i++)
+    {
+        testAssert(binarySearch(vec, i * 2) == i * 2);
+        testAssert(binarySearch(vec, (i * 2) + 1) == -1);
+    }
+    testAssert(binarySearch(vec, -1) == -1);
+    testAssert(binarySearch(vec, 5000) == -1);
+    return OK;
+}
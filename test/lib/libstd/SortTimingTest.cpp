@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <Vector.h>
+#include <Sort.h>
+
+/** Number of items in the throughput test */
+#define SORT_ITEMS 8192
+
+/**
+ * Check if a range is sorted.
+ */
+template <class T> static bool isSorted(const T *begin, const T *end)
+{
+    for (const T *i = begin; i + 1 < end; i++)
+        if (*(i + 1) < *i)
+            return false;
+
+    return true;
+}
+
+TestCase(SortThroughput)
+{
+    TestInt<int> ints(INT_MIN, INT_MAX);
+    Vector<int> input(SORT_ITEMS);
+    clock_t start, insertionTime, introTime, mergeTime, linearTime, binaryTime;
+    Size found = 0;
+
+    for (Size i = 0; i < SORT_ITEMS; i++)
+        input.insert(ints.random());
+
+    Vector<int> a(input), b(input), c(input);
+
+    // Naive insertion sort
+    start = clock();
+    insertionSort(a.begin(), a.end());
+    insertionTime = clock() - start;
+
+    start = clock();
+    introSort(b);
+    introTime = clock() - start;
+
+    start = clock();
+    mergeSort(c);
+    mergeTime = clock() - start;
+
+    testAssert(isSorted(a.begin(), a.end()));
+    testAssert(isSorted(b.begin(), b.end()));
+    testAssert(isSorted(c.begin(), c.end()));
+
+    // Find each item by linear scan and by binary search
+    start = clock();
+    for (Size i = 0; i < SORT_ITEMS; i++)
+        for (const int *j = b.begin(); j != b.end(); j++)
+            if (*j == input[i])
+            {
+                found++;
+                break;
+            }
+    linearTime = clock() - start;
+
+    start = clock();
+    for (Size i = 0; i < SORT_ITEMS; i++)
+        if (binarySearch(b, input[i]) >= 0)
+            found++;
+    binaryTime = clock() - start;
+    testAssert(found == SORT_ITEMS * 2);
+
+    fprintf(stderr, "# Sort %u items: insertion %lu us, introsort %lu us, merge %lu us\n",
+            SORT_ITEMS,
+            (unsigned long) insertionTime * 1000000 / CLOCKS_PER_SEC,
+            (unsigned long) introTime * 1000000 / CLOCKS_PER_SEC,
+            (unsigned long) mergeTime * 1000000 / CLOCKS_PER_SEC);
+    fprintf(stderr, "# Search %u items: linear %lu us, binary %lu us\n",
+            SORT_ITEMS,
+            (unsigned long) linearTime * 1000000 / CLOCKS_PER_SEC,
+            (unsigned long) binaryTime * 1000000 / CLOCKS_PER_SEC);
+    return OK;
+}
@@ -280,3 +280,27 @@ TestCase(VectorCompare)
     testAssert(a1.count() != a2.count());
     return OK;
 }
+
+TestCase(VectorRange)
+{
+    TestInt<int> ints(INT_MIN, INT_MAX);
+    Vector<int> a(16);
+    Size n = 0;
+
+    // An empty Vector has an empty range
+    testAssert(a.begin() == a.end());
+
+    for (Size i = 0; i < 100; i++)
+        a.insert(ints.random());
+
+    // The range covers all items in order
+    testAssert(a.end() - a.begin() == 100);
+
+    for (int *i = a.begin(); i != a.end(); i++, n++)
+    {
+        testAssert(*i == ints[n]);
+        testAssert(&a[n] == i);
+    }
+    testAssert(n == a.count());
+    return OK;
+}
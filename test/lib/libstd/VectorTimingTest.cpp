@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2015 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <Vector.h>
+
+/** Number of items in the throughput test */
+#define RANGE_ITEMS 4096
+
+/** Number of passes over the items in the throughput test */
+#define RANGE_ROUNDS 4096
+
+/**
+ * Sum the items through the polymorphic Sequence interface.
+ */
+static __attribute__((noinline)) Size sumSequence(const Sequence<Size> & seq)
+{
+    Size sum = 0;
+
+    for (Size i = 0; i < seq.count(); i++)
+        sum += seq.at(i);
+
+    return sum;
+}
+
+/**
+ * Sum the items through the inline Vector range.
+ */
+static __attribute__((noinline)) Size sumRange(const Vector<Size> & vec)
+{
+    Size sum = 0;
+
+    for (const Size *i = vec.begin(); i != vec.end(); i++)
+        sum += *i;
+
+    return sum;
+}
+
+TestCase(VectorRangeThroughput)
+{
+    Vector<Size> a(RANGE_ITEMS);
+    Size expect = 0, sum = 0;
+    clock_t start, virtualTime, rangeTime;
+
+    for (Size i = 0; i < RANGE_ITEMS; i++)
+    {
+        a.insert(i);
+        expect += i;
+    }
+
+    // Change the first item each round, such that no call can be skipped
+    expect = (expect * RANGE_ROUNDS) + ((RANGE_ROUNDS * (RANGE_ROUNDS - 1)) / 2);
+
+    // Sum via virtual at() calls
+    start = clock();
+    for (Size i = 0; i < RANGE_ROUNDS; i++)
+    {
+        a[0] = i;
+        sum += sumSequence(a);
+    }
+    virtualTime = clock() - start;
+    testAssert(sum == expect);
+
+    // Sum via the inline range
+    sum = 0;
+    start = clock();
+    for (Size i = 0; i < RANGE_ROUNDS; i++)
+    {
+        a[0] = i;
+        sum += sumRange(a);
+    }
+    rangeTime = clock() - start;
+    testAssert(sum == expect);
+
+    fprintf(stderr, "# Vector %u items x %u: Sequence::at %lu us, begin/end %lu us\n",
+            RANGE_ITEMS, RANGE_ROUNDS,
+            (unsigned long) virtualTime * 1000000 / CLOCKS_PER_SEC,
+            (unsigned long) rangeTime * 1000000 / CLOCKS_PER_SEC);
+    return OK;
+}